@@ -6,7 +6,10 @@
 #include "group.hpp"
 #include "precompute_buffers.hpp"
 
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace electionguard
 {
@@ -145,6 +148,26 @@ namespace electionguard
         /// </Summary>
         bool isValid(const ElGamalCiphertext &message, const ElementModP &k, const ElementModQ &q);
 
+        /// <Summary>
+        /// Validates a collection of "disjunctive" Chaum-Pedersen (zero or one) proofs
+        /// that were generated under the same public key.
+        ///
+        /// The verification equations of every proof are combined using small random
+        /// weights so the whole batch is checked with a pair of multi-exponentiations
+        /// instead of four equations per proof. When the combined check fails, the batch
+        /// is bisected to isolate the invalid proofs.
+        ///
+        /// <param name="items"> The ciphertext message and proof pairs</param>
+        /// <param name="k"> The public key of the election</param>
+        /// <param name="q"> The extended base hash of the election</param>
+        /// <returns> The indices of the invalid items, empty if every proof is valid. </returns>
+        /// </Summary>
+        static std::vector<size_t>
+        verifyBatch(const std::vector<std::pair<std::reference_wrapper<const ElGamalCiphertext>,
+                                                std::reference_wrapper<const DisjunctiveChaumPedersenProof>>>
+                      &items,
+                    const ElementModP &k, const ElementModQ &q);
+
         std::unique_ptr<DisjunctiveChaumPedersenProof> clone() const;
 
       protected:
@@ -11,11 +11,27 @@ enum MAX_IDENIFIER_LENGTH { MAX_IDENIFIER_LENGTH = 256 };
 enum MAX_P_LEN { MAX_P_LEN = 64 };
 enum MAX_Q_LEN { MAX_Q_LEN = 4 };
 
-// values used for fixed-base exponentiation tables
+// default geometry of fixed-base exponentiation tables,
+// window sizes of 4, 6, 10 and 12 bits can be selected per base at runtime
 static const uint64_t LUT_WINDOW_SIZE = 8;
 static const uint64_t LUT_ORDER_BITS = 256;
 static const uint64_t LUT_TABLE_LENGTH = 32;
 
+// values used to manage the cache of fixed-base exponentiation tables
+// number of exponentiations of a base before a table is generated for it,
+// 0 disables promotion so that only bases flagged as fixed bases get a table
+static const uint64_t LUT_PROMOTION_THRESHOLD = 0;
+// number of bytes the cached tables may occupy, about 64 tables
+static const uint64_t LUT_CACHE_BYTE_BUDGET = 268435456;
+// number of slots counting the exponentiations of bases towards promotion
+static const uint64_t LUT_PROMOTION_CANDIDATES = 256;
+
+// values used to bound the discrete log search of decryption
+// largest plaintext found when decrypting, larger plaintexts are not found
+static const uint64_t DLOG_MAX_EXPONENT = 16777216;
+// number of bytes the table of small powers of g may occupy
+static const uint64_t DLOG_TABLE_BYTE_BUDGET = 16777216;
+
 static const uint8_t MAX_P_LEN_DOUBLE = 128;
 static const uint8_t MAX_Q_LEN_DOUBLE = 8;
 
@@ -141,6 +141,9 @@ namespace electionguard
 
         /// <summary>
         ///  Makes a CiphertextElectionContext object.
+        ///  The public key is flagged as a fixed base, its lookup table is generated
+        ///  by the first EncryptionMediator so that encryptions exponentiate the key
+        ///  as fast as they exponentiate G.
         ///
         /// <param name="number_of_guardians"> The number of guardians necessary to generate the public key </param>
         /// <param name="quorum"> The quorum of guardians necessary to decrypt an election.  Must be less than `number_of_guardians` </param>
@@ -271,6 +274,26 @@ namespace electionguard
         static std::unique_ptr<CiphertextElectionContext> fromJson(std::string data);
         static std::unique_ptr<CiphertextElectionContext> fromBson(std::vector<uint8_t> data);
 
+        /// <summary>
+        /// Deserialize the context and attach the lookup table of its public key
+        /// from a file written by `saveLookupTable`, so the table is not generated again.
+        /// Throws runtime_error when the file does not hold the table of the public key.
+        /// </summary>
+        static std::unique_ptr<CiphertextElectionContext>
+        fromJson(std::string data, const std::string &lookupTablePath);
+        static std::unique_ptr<CiphertextElectionContext>
+        fromBson(std::vector<uint8_t> data, const std::string &lookupTablePath);
+
+        /// <summary>
+        /// Write the lookup table of the public key to a file, generating it if needed
+        /// </summary>
+        void saveLookupTable(const std::string &path) const;
+
+        /// <summary>
+        /// Memory map the lookup table of the public key from a file written by `saveLookupTable`
+        /// </summary>
+        void loadLookupTable(const std::string &path) const;
+
       private:
         class Impl;
 #pragma warning(suppress : 4251)
@@ -97,10 +97,24 @@ namespace electionguard
         /// Decrypt the ciphertext directly using the provided secret key.
         ///
         /// This is a convenience accessor useful for some use cases.
+        /// The plaintext is found with `discrete_log`, MAX_UINT64 is returned when it is not found.
         /// This method should not be used by consumers operating in live secret ballot elections.
         /// </Summary>
         uint64_t decrypt(const ElementModQ &secretKey);
 
+        /// <Summary>
+        /// Decrypt each ciphertext directly using the same secret key.
+        ///
+        /// The pad exponentiations run in parallel on the Scheduler and the inversions
+        /// of the decryption factors are combined into a single modular inversion.
+        /// The results are the same as calling decrypt on every ciphertext.
+        /// Throws invalid_argument if a pad is zero mod p.
+        /// This method should not be used by consumers operating in live secret ballot elections.
+        /// </Summary>
+        static std::vector<uint64_t> decryptBatch(
+          const std::vector<std::reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+          const ElementModQ &secretKey);
+
         /// <Summary>
         /// Clone the value by making a deep copy.
         /// </Summary>
@@ -123,6 +137,23 @@ namespace electionguard
     EG_API std::unique_ptr<ElGamalCiphertext>
     elgamalEncrypt(const uint64_t m, const ElementModQ &nonce, const ElementModP &publicKey);
 
+    /// <summary>
+    /// Encrypts each message with its own random nonce and the same ElGamal public key.
+    ///
+    /// The public key exponentiations are independent of each other, so they are
+    /// evaluated together with pow_mod_p_batch. The result is the same as calling
+    /// elgamalEncrypt for every message.
+    ///
+    /// <param name="messages"> Messages to elgamal_encrypt; each must be in [0,Q). </param>
+    /// <param name="nonces"> Randomly chosen nonces in [1,Q), one for each message. </param>
+    /// <param name="publicKey"> ElGamal public key. </param>
+    /// <returns>A ciphertext tuple for each message, in order.</returns>
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<ElGamalCiphertext>>
+    elgamalEncryptBatch(const std::vector<uint64_t> &messages,
+                        const std::vector<std::reference_wrapper<const ElementModQ>> &nonces,
+                        const ElementModP &publicKey);
+
     /// <summary>
     /// Encrypts a message with given precomputed values (two triples and a quadruple).
     /// However, only the first triple is used in this function.
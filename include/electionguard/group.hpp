@@ -4,7 +4,10 @@
 #include "constants.h"
 #include "export.h"
 
+#include <atomic>
 #include <cstdint>
+#include <functional>
+#include <future>
 #include <memory>
 #include <string>
 #include <variant>
@@ -13,12 +16,67 @@
 namespace electionguard
 {
     typedef uint64_t array4096[MAX_P_LEN];
+
+    /// <summary>
+    /// The limbs of a group element stored inline in HACL format.
+    ///
+    /// The limbs are aligned to a cache line and overwritten with zeros when the value
+    /// is destroyed. The layout is only the limb array, so it does not change between
+    /// builds and values can be placed on the stack or in arrays without any allocation.
+    /// </summary>
+    template <uint64_t LimbCount> struct alignas(64) ElementValue {
+        uint64_t data[LimbCount] = {};
+
+        ElementValue() = default;
+        explicit ElementValue(const uint64_t (&limbs)[LimbCount])
+        {
+            for (uint64_t i = 0; i < LimbCount; i++) {
+                data[i] = limbs[i];
+            }
+        }
+        ElementValue(const ElementValue &other) = default;
+        ElementValue &operator=(const ElementValue &other) = default;
+        ~ElementValue() { zeroize(); }
+
+        /// <Summary>
+        /// overwrite the limbs with zeros, the writes are volatile
+        /// so the compiler cannot drop them from a value that is going away
+        /// </Summary>
+        void zeroize()
+        {
+            volatile uint64_t *limbs = data;
+            for (uint64_t i = 0; i < LimbCount; i++) {
+                limbs[i] = 0;
+            }
+        }
+
+        bool operator==(const ElementValue &other) const
+        {
+            for (uint64_t i = 0; i < LimbCount; i++) {
+                if (data[i] != other.data[i]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    typedef ElementValue<MAX_P_LEN> ElementModPValue;
+    typedef ElementValue<MAX_Q_LEN> ElementModQValue;
+
     /// <summary>
     /// An element of the larger `mod p` space, i.e., in [0, P), where P is a 4096-bit prime.
+    ///
+    /// The limbs are held inline in an ElementModPValue, so an element is never more
+    /// than one allocation and none at all when it is placed on the stack.
     /// </summary>
     class EG_API ElementModP
     {
       public:
+        /// <Summary>
+        /// create an element with the value zero
+        /// </Summary>
+        ElementModP();
         ElementModP(const ElementModP &other);
         ElementModP(ElementModP &&other);
         ElementModP(const std::vector<uint64_t> &elem, bool unchecked = false,
@@ -45,6 +103,15 @@ namespace electionguard
 
         uint64_t (&ref() const)[MAX_P_LEN];
 
+        /// <Summary>
+        /// Get the limbs of the element for reading.
+        /// Unlike get() and ref(), the limbs cannot be written through the result,
+        /// so a proof that the element is a valid residue is kept.
+        /// </Summary>
+        const uint64_t *data() const;
+
+        const uint64_t (&cref() const)[MAX_P_LEN];
+
         uint64_t length() const;
 
         bool isFixedBase() const;
@@ -92,17 +159,26 @@ namespace electionguard
                                                        bool unchecked = false);
 
       private:
-        class Impl;
+        ElementModPValue value;
+        mutable bool fixedBase = false;
+        // set once the limbs are proven to be a valid residue. the limbs are writable
+        // through get() and ref(), so those clear it, while data() and cref() keep it
 #pragma warning(suppress : 4251)
-        std::unique_ptr<Impl> pimpl;
+        mutable std::atomic<bool> validatedResidue{false};
     };
 
     /// <summary>
     /// An element of the smaller `mod q` space, i.e., in [0, Q), where Q is a 256-bit prime.
+    ///
+    /// The limbs are held inline in an ElementModQValue.
     /// </summary>
     class EG_API ElementModQ
     {
       public:
+        /// <Summary>
+        /// create an element with the value zero
+        /// </Summary>
+        ElementModQ();
         ElementModQ(const ElementModQ &other);
         ElementModQ(ElementModQ &&other);
         ElementModQ(const std::vector<uint64_t> &elem, bool unchecked = false);
@@ -170,9 +246,7 @@ namespace electionguard
         std::unique_ptr<ElementModP> toElementModP() const;
 
       private:
-        class Impl;
-#pragma warning(suppress : 4251)
-        std::unique_ptr<Impl> pimpl;
+        ElementModQValue value;
     };
 
     // Common constants
@@ -207,11 +281,23 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModP> add_mod_p(const ElementModP &lhs, const ElementModP &rhs);
 
+    /// <summary>
+    /// Adds together the left hand side and right hand side and writes the sum mod P to result,
+    /// which may be one of the inputs
+    /// </summary>
+    EG_API void add_mod_p(const ElementModP &lhs, const ElementModP &rhs, ElementModP &result);
+
     /// <summary>
     /// Multplies together the left hand side and right hand side and returns the product mod P
     /// </summary>
     EG_API std::unique_ptr<ElementModP> mul_mod_p(const ElementModP &lhs, const ElementModP &rhs);
 
+    /// <summary>
+    /// Multplies together the left hand side and right hand side and writes the product mod P
+    /// to result, which may be one of the inputs
+    /// </summary>
+    EG_API void mul_mod_p(const ElementModP &lhs, const ElementModP &rhs, ElementModP &result);
+
     using ElementModPOrQ = std::variant<ElementModP *, ElementModQ *>;
 
     /// <summary>
@@ -224,17 +310,112 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModP> mod_p(const ElementModP &element);
 
+    /// <summary>
+    /// How an exponentiation is evaluated.
+    ///
+    /// Exponentiations are constant time unless the caller opts out, which is only
+    /// safe when the exponent is public, such as when verifying ciphertexts and proofs.
+    /// A lookup table serving a constant time exponentiation is read under masks,
+    /// every entry of every row is read whatever the exponent.
+    /// </summary>
+    enum class ExponentiationPolicy {
+        /// <Summary>
+        /// Without data dependent branches or memory accesses, for secret exponents such
+        /// as nonces and keys. Runs the verified ladder of HACL* unless another
+        /// implementation is chosen with `set_constant_time_implementation`
+        /// </Summary>
+        constantTime = 0,
+        /// <Summary>
+        /// A sliding window over the exponent bits, faster but leaking the exponent
+        /// through its timing, for public exponents only
+        /// </Summary>
+        variableTime = 1
+    };
+
+    /// <summary>
+    /// The implementation behind constant time exponentiations
+    /// </summary>
+    enum class ConstantTimeImplementation {
+        /// <Summary>
+        /// The formally verified constant time exponentiation of HACL*, the default
+        /// </Summary>
+        verified = 0,
+        /// <Summary>
+        /// A fixed window, lookup tables and vector lanes whose entries are selected under
+        /// masks, built on the montgomery kernels of this library. Several times faster,
+        /// but with reduced assurance: it is not verified, only checked for timing leaks
+        /// by a statistical test.
+        /// </Summary>
+        maskedWindow = 1
+    };
+
+    /// <summary>
+    /// The number of exponentiations requested with each policy
+    /// </summary>
+    struct ExponentiationStatistics {
+        /// <summary>
+        /// exponentiations requested as constant time
+        /// </summary>
+        uint64_t constantTime = 0;
+        /// <summary>
+        /// exponentiations requested as variable time
+        /// </summary>
+        uint64_t variableTime = 0;
+        /// <summary>
+        /// exponentiations served by a lookup table read at offsets selected by the exponent,
+        /// only variable time exponentiations are served this way
+        /// </summary>
+        uint64_t lookupTable = 0;
+        /// <summary>
+        /// exponentiations served by a lookup table read under masks, only constant time
+        /// exponentiations with the masked window implementation are served this way
+        /// </summary>
+        uint64_t maskedLookupTable = 0;
+    };
+
+    /// <summary>
+    /// Gets the number of exponentiations requested with each policy since the process started
+    /// </summary>
+    EG_API ExponentiationStatistics get_exponentiation_statistics();
+
+    /// <summary>
+    /// Configures how many distinct elements proven by `isValidResidue` are remembered
+    /// across instances, so that checking another copy of the same value skips the
+    /// exponentiation. The cache is disabled by a capacity of zero, which is the default,
+    /// as it only pays off when the same values are checked repeatedly.
+    /// </summary>
+    EG_API void set_residue_cache_capacity(uint64_t capacity);
+
+    /// <summary>
+    /// Chooses the implementation of constant time exponentiations for the process.
+    /// The verified implementation is the default, the masked window must be opted into.
+    /// </summary>
+    EG_API void set_constant_time_implementation(ConstantTimeImplementation implementation);
+
+    /// <summary>
+    /// Gets the implementation of constant time exponentiations
+    /// </summary>
+    EG_API ConstantTimeImplementation get_constant_time_implementation();
+
     /// <summary>
     /// Computes b^e mod p.
     /// </summary>
-    EG_API std::unique_ptr<ElementModP> pow_mod_p(const ElementModP &base,
-                                                  const ElementModP &exponent);
+    EG_API std::unique_ptr<ElementModP>
+    pow_mod_p(const ElementModP &base, const ElementModP &exponent,
+              ExponentiationPolicy policy = ExponentiationPolicy::constantTime);
 
     /// <summary>
     /// Computes b^e mod p.
     /// </summary>
-    EG_API std::unique_ptr<ElementModP> pow_mod_p(const ElementModP &base,
-                                                  const ElementModQ &exponent);
+    EG_API std::unique_ptr<ElementModP>
+    pow_mod_p(const ElementModP &base, const ElementModQ &exponent,
+              ExponentiationPolicy policy = ExponentiationPolicy::constantTime);
+
+    /// <summary>
+    /// Computes b^e mod p and writes it to result, which may be the base
+    /// </summary>
+    EG_API void pow_mod_p(const ElementModP &base, const ElementModQ &exponent, ElementModP &result,
+                          ExponentiationPolicy policy = ExponentiationPolicy::constantTime);
 
     /// <summary>
     /// Computes g^e mod p.
@@ -246,11 +427,245 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModP> g_pow_p(const ElementModQ &exponent);
 
+    /// <summary>
+    /// Computes g^e mod p and writes it to result.
+    /// </summary>
+    EG_API void g_pow_p(const ElementModQ &exponent, ElementModP &result);
+
+    /// <summary>
+    /// How the memory of fixed base lookup tables is backed by huge pages.
+    ///
+    /// A lookup table spans megabytes that are read at data dependent offsets,
+    /// huge pages let a few TLB entries cover the whole table.
+    /// </summary>
+    enum class LookupTableHugePages {
+        /// <Summary>
+        /// Regular pages
+        /// </Summary>
+        none = 0,
+        /// <Summary>
+        /// Memory aligned to the huge page size and advised for transparent huge pages
+        /// </Summary>
+        transparent = 1,
+        /// <Summary>
+        /// Huge pages reserved by the system (hugetlbfs on linux, large pages on windows),
+        /// falling back to transparent huge pages when none are available
+        /// </Summary>
+        reserved = 2
+    };
+
+    /// <summary>
+    /// Usage statistics of the cache of fixed base lookup tables
+    /// </summary>
+    struct LookupTableCacheStatistics {
+        /// <summary>
+        /// exponentiations served by an existing table
+        /// </summary>
+        uint64_t hits = 0;
+        /// <summary>
+        /// exponentiations of a base that had no table
+        /// </summary>
+        uint64_t misses = 0;
+        /// <summary>
+        /// tables generated for bases that crossed the promotion threshold
+        /// </summary>
+        uint64_t promotions = 0;
+        /// <summary>
+        /// tables evicted to stay within the byte budget
+        /// </summary>
+        uint64_t evictions = 0;
+        /// <summary>
+        /// tables currently held
+        /// </summary>
+        uint64_t tables = 0;
+        /// <summary>
+        /// bytes currently occupied by the tables
+        /// </summary>
+        uint64_t bytes = 0;
+        /// <summary>
+        /// bytes occupied by the tables and by the evicted tables that a thread
+        /// which used them has not released yet
+        /// </summary>
+        uint64_t residentBytes = 0;
+    };
+
+    /// <summary>
+    /// Configures the cache of fixed base lookup tables.
+    ///
+    /// A base that is not flagged as a fixed base gets a lookup table once it has been
+    /// exponentiated about `promotionThreshold` times, a threshold of zero disables promotion
+    /// and is the default. The table of a promoted base is generated on the Scheduler,
+    /// the exponentiations of the base do not use it until it is ready.
+    /// The least recently used tables are evicted while the tables occupy more than
+    /// `byteBudget` bytes, bases flagged as fixed bases rebuild their table when used again.
+    /// </summary>
+    EG_API void set_lookup_table_cache_policy(uint64_t promotionThreshold, uint64_t byteBudget);
+
+    /// <summary>
+    /// Gets the usage statistics of the cache of fixed base lookup tables
+    /// </summary>
+    EG_API LookupTableCacheStatistics get_lookup_table_cache_statistics();
+
+    /// <summary>
+    /// Writes the fixed base lookup table of the base to a file, generating it if needed.
+    ///
+    /// The file can be loaded with `load_lookup_table` by other processes
+    /// so they can skip regenerating the table.
+    /// </summary>
+    EG_API void save_lookup_table(const ElementModP &base, const std::string &path);
+
+    /// <summary>
+    /// Memory maps a lookup table file written by `save_lookup_table`
+    /// and marks the base as a fixed base so that exponentiations use the table.
+    ///
+    /// The pages are mapped read-only and shared, so processes on the same host
+    /// loading the same file share its memory. Throws runtime_error when the file
+    /// was written for a different base or group, or cannot be read.
+    /// </summary>
+    EG_API void load_lookup_table(const ElementModP &base, const std::string &path);
+
+    /// <summary>
+    /// Generates the lookup table of the base in the background
+    /// and marks the base as a fixed base.
+    ///
+    /// The rows of the table are filled in parallel on the thread pool. The returned future
+    /// is ready once the table is available, exponentiations of the base that start earlier
+    /// wait for the same table instead of generating another one.
+    /// </summary>
+    EG_API std::future<void> prepare_lookup_table(const ElementModP &base);
+
+    /// <summary>
+    /// Selects the window size of the lookup table generated for the base.
+    ///
+    /// Each row of the table consumes that many bits of the exponent, so larger windows
+    /// need fewer multiplications per exponentiation at the cost of memory:
+    /// 4 bits use 512 KB, 6 bits 1.3 MB, 8 bits (the default) 4 MB, 10 bits 13 MB
+    /// and 12 bits 44 MB. A table of the base with another window size is discarded.
+    /// Throws invalid_argument for any other window size.
+    /// </summary>
+    EG_API void set_lookup_table_window_size(const ElementModP &base, uint64_t windowSize);
+
+    /// <summary>
+    /// Selects how the memory of lookup tables generated from now on
+    /// is backed by huge pages, transparent huge pages by default.
+    /// </summary>
+    EG_API void set_lookup_table_huge_pages(LookupTableHugePages hugePages);
+
+    /// <summary>
+    /// Finds the discrete log of the element to the base g,
+    /// i.e. the x such that g^x == element mod p.
+    ///
+    /// Exponents below the bound of the table of small powers of g are found directly,
+    /// larger exponents by baby-step giant-step up to the largest exponent of the
+    /// discrete log policy. Returns MAX_UINT64 when no such x is found.
+    /// Searches can run concurrently.
+    /// </summary>
+    EG_API uint64_t discrete_log(const ElementModP &element);
+
+    /// <summary>
+    /// Configures the discrete log search.
+    ///
+    /// Exponents up to `maxExponent` are found. The table of small powers of g holds
+    /// about the square root of `maxExponent` powers, capped to the largest table that fits
+    /// in `byteBudget` bytes, so a smaller budget trades memory for more giant steps.
+    /// The existing table is discarded. Throws invalid_argument when the budget
+    /// cannot hold a table.
+    /// </summary>
+    EG_API void set_discrete_log_policy(uint64_t maxExponent, uint64_t byteBudget);
+
+    /// <summary>
+    /// Writes the table of small powers of g used by `discrete_log` to a file,
+    /// generating it if needed.
+    /// </summary>
+    EG_API void save_discrete_log_table(const std::string &path);
+
+    /// <summary>
+    /// Memory maps a table written by `save_discrete_log_table` so that subsequent
+    /// searches use it instead of generating a table. Throws runtime_error when the file
+    /// was written for a different group, or cannot be read.
+    /// </summary>
+    EG_API void load_discrete_log_table(const std::string &path);
+
+    /// <summary>
+    /// Generates the lookup tables of the bases in one interleaved block of memory
+    /// and marks the bases as fixed bases.
+    ///
+    /// The entries of every base for the same row and exponent slice are adjacent, so
+    /// `pow_mod_p_shared_exponent` reads them from the same pages. The bases must use the
+    /// same window size, an existing table of any of the bases is replaced.
+    /// </summary>
+    EG_API void
+    interleave_lookup_tables(const std::vector<std::reference_wrapper<const ElementModP>> &bases);
+
+    /// <summary>
+    /// Computes b^e mod p for every base b with the same exponent e.
+    ///
+    /// When every base has a lookup table of the same window size, each exponent slice
+    /// is looked up once for all the bases, otherwise each base is exponentiated separately.
+    /// </summary>
+    EG_API std::vector<std::unique_ptr<ElementModP>>
+    pow_mod_p_shared_exponent(const std::vector<std::reference_wrapper<const ElementModP>> &bases,
+                              const ElementModQ &exponent,
+                              ExponentiationPolicy policy = ExponentiationPolicy::constantTime);
+
+    /// <summary>
+    /// Computes b^e mod p for every base b and its own exponent e.
+    ///
+    /// Bases that have a lookup table are evaluated against their table. The others
+    /// are independent exponentiations, which run several at a time across the lanes
+    /// of the vector units where the processor supports it and the masked window
+    /// implementation is chosen, and one at a time otherwise.
+    /// Throws invalid_argument if the collections differ in size.
+    /// </summary>
+    /// <param name="bases">the bases</param>
+    /// <param name="exponents">the exponents, one for each base</param>
+    EG_API std::vector<std::unique_ptr<ElementModP>>
+    pow_mod_p_batch(const std::vector<std::reference_wrapper<const ElementModP>> &bases,
+                    const std::vector<std::reference_wrapper<const ElementModQ>> &exponents);
+
+    /// <summary>
+    /// Computes a^-1 mod p for every element a.
+    ///
+    /// Uses Montgomery's batch inversion trick, so the whole collection costs a single
+    /// modular inversion and 3(N-1) multiplications instead of N inversions,
+    /// besides converting each element to montgomery form.
+    /// Throws invalid_argument if any element is zero mod p.
+    /// </summary>
+    /// <param name="elements">the elements to invert</param>
+    EG_API std::vector<std::unique_ptr<ElementModP>>
+    inv_mod_p_batch(const std::vector<std::reference_wrapper<const ElementModP>> &elements);
+
+    /// <summary>
+    /// Computes the product of each base raised to its exponent, i.e. b0^e0 * b1^e1 * ... mod p.
+    ///
+    /// All of the bases share a single chain of squarings in montgomery form, so evaluating
+    /// an expression such as g^a * K^b costs little more than a single exponentiation.
+    /// A few bases are interleaved using per-base window tables, while larger collections
+    /// accumulate into shared buckets. Bases that have a lookup table are evaluated against
+    /// their table and folded into the product.
+    ///
+    /// The shared chain skips zero windows and so runs in variable time. Unless the
+    /// exponents are public, each base is exponentiated in constant time instead.
+    /// </summary>
+    /// <param name="bases">the bases</param>
+    /// <param name="exponents">the exponents, one for each base</param>
+    /// <param name="policy">variableTime when all of the exponents are public</param>
+    EG_API std::unique_ptr<ElementModP>
+    multi_pow_mod_p(const std::vector<std::reference_wrapper<const ElementModP>> &bases,
+                    const std::vector<std::reference_wrapper<const ElementModQ>> &exponents,
+                    ExponentiationPolicy policy = ExponentiationPolicy::constantTime);
+
     /// <summary>
     /// Adds together the left hand side and right hand side and returns the sum mod Q
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs);
 
+    /// <summary>
+    /// Adds together the left hand side and right hand side and writes the sum mod Q to result,
+    /// which may be one of the inputs
+    /// </summary>
+    EG_API void add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs, ElementModQ &result);
+
     /// <summary>
     /// Adds together the collection and returns the sum mod Q
     /// </summary>
@@ -262,17 +677,45 @@ namespace electionguard
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b);
 
+    /// <summary>
+    /// Computes (a-b) mod q and writes it to result, which may be one of the inputs
+    /// </summary>
+    EG_API void sub_mod_q(const ElementModQ &a, const ElementModQ &b, ElementModQ &result);
+
     /// <summary>
     /// Computes (a + b * c) mod q.
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
                                                         const ElementModQ &c);
 
+    /// <summary>
+    /// Computes (a + b * c) mod q and writes it to result, which may be one of the inputs
+    /// </summary>
+    EG_API void a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b, const ElementModQ &c,
+                                ElementModQ &result);
+
+    /// <summary>
+    /// Computes (a - b * c) mod q.
+    /// </summary>
+    EG_API std::unique_ptr<ElementModQ> a_minus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
+                                                         const ElementModQ &c);
+
+    /// <summary>
+    /// Computes (a - b * c) mod q and writes it to result, which may be one of the inputs
+    /// </summary>
+    EG_API void a_minus_bc_mod_q(const ElementModQ &a, const ElementModQ &b, const ElementModQ &c,
+                                 ElementModQ &result);
+
     /// <summary>
     /// Computes (Q - a) mod q.
     /// </summary>
     EG_API std::unique_ptr<ElementModQ> sub_from_q(const ElementModQ &a);
 
+    /// <summary>
+    /// Computes (Q - a) mod q and writes it to result, which may be the input
+    /// </summary>
+    EG_API void sub_from_q(const ElementModQ &a, ElementModQ &result);
+
     /// <summary>
     /// Generate random number between 0 and P
     /// </summary>
@@ -1,5 +1,8 @@
 #ifndef __ELECTIONGUARD_CPP_HASH_HPP_INCLUDED__
 #define __ELECTIONGUARD_CPP_HASH_HPP_INCLUDED__
+#include <cstddef>
+#include <cstdint>
+#include <electionguard/constants.h>
 #include <electionguard/crypto_hashable.hpp>
 #include <electionguard/export.h>
 #include <electionguard/group.hpp>
@@ -46,6 +49,54 @@ namespace electionguard
     /// <returns>A cryptographic hash of these elements, concatenated.</returns>
     /// </Summary>
     EG_API std::unique_ptr<ElementModQ> hash_elems(CryptoHashableType a);
+
+    /// <Summary>
+    /// Calculate the cryptographic hash of every list of elements,
+    /// each exactly like `hash_elems`, compressing the final blocks of
+    /// the independent hashes together across SIMD lanes.
+    ///
+    /// <param name="inputs"> The lists of elements, one per hash.</param>
+    /// <returns>The hash of every list, in the order of the inputs.</returns>
+    /// </Summary>
+    EG_API std::vector<std::unique_ptr<ElementModQ>>
+    hash_elems_batch(const std::vector<std::vector<CryptoHashableType>> &inputs);
+
+    class HashStream;
+
+    /// <Summary>
+    /// Leading elements shared by many hashes, absorbed into SHA-256 once.
+    ///
+    /// Every hash continues from a copy of the midstate after the prefix, so
+    /// `HashPrefix({a, b}).hash({c})` equals `hash_elems({a, b, c})` but only compresses
+    /// the blocks that follow the prefix. A prefix is immutable and can be shared by threads.
+    /// The SHA-256 state is kept behind the pointer to its implementation.
+    /// </Summary>
+    class EG_API HashPrefix
+    {
+      public:
+        HashPrefix();
+        explicit HashPrefix(const std::vector<CryptoHashableType> &prefix);
+        HashPrefix(const HashPrefix &other);
+        HashPrefix(HashPrefix &&other) noexcept;
+        ~HashPrefix();
+
+        HashPrefix &operator=(HashPrefix rhs);
+
+        /// <Summary>
+        /// the hash of the prefix followed by the suffix
+        /// </Summary>
+        std::unique_ptr<ElementModQ> hash(const std::vector<CryptoHashableType> &suffix) const;
+
+        /// <Summary>
+        /// a stream continuing after the prefix, for suffixes that vary in length.
+        /// the stream is internal to the library and declared in hash_stream.hpp
+        /// </Summary>
+        HashStream begin() const;
+
+      private:
+        class Impl;
+        std::unique_ptr<Impl> pimpl;
+    };
 } // namespace electionguard
 
 #endif /* __ELECTIONGUARD_CPP_HASH_HPP_INCLUDED__ */
@@ -4,14 +4,17 @@
 #include "electionguard/export.h"
 #include "log.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <exception>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <thread>
 
 using std::atomic;
 using std::condition_variable;
@@ -278,11 +281,23 @@ namespace electionguard
             return result;
         }
 
+        /// <summary>
+        /// register a function that each worker calls when it runs out of tasks,
+        /// so that what the thread holds on to between tasks is released while it is idle
+        /// </summary>
+        void onIdle(void (*handler)())
+        {
+            std::lock_guard<std::mutex> lock(_idle_mutex);
+            _idle_handlers.push_back(handler);
+        }
+
       private:
         std::uint_fast32_t _thread_count;
         std::atomic<bool> _running = true;
         AsyncQueue<CallableWrapper> _taskQueue;
         std::mutex queue_mutex = {};
+        std::mutex _idle_mutex;
+        std::vector<void (*)()> _idle_handlers;
         std::vector<std::thread> _threads;
 
         void wait()
@@ -297,11 +312,20 @@ namespace electionguard
 
         void worker()
         {
+            bool idle = true;
             while (_running) {
                 CallableWrapper task;
                 if (_taskQueue.pop(task)) {
                     task();
+                    idle = false;
                 } else {
+                    if (!idle) {
+                        idle = true;
+                        std::lock_guard<std::mutex> lock(_idle_mutex);
+                        for (auto *handler : _idle_handlers) {
+                            handler();
+                        }
+                    }
                     std::this_thread::yield();
                 }
             }
@@ -328,11 +352,72 @@ namespace electionguard
             return getInstance()._pool.submit(task);
         }
 
+        /// <summary>
+        /// register a function that each worker calls when it runs out of tasks
+        /// </summary>
+        static void onIdle(void (*handler)()) { getInstance()._pool.onIdle(handler); }
+
       private:
         Scheduler() {}
         ThreadPool _pool;
     };
 
+    /// <summary>
+    /// Call `body(i)` for every i in [0, count) using the Scheduler and the calling thread.
+    ///
+    /// Indices are claimed one at a time by whichever thread is free, and the calling
+    /// thread keeps claiming them too, so this also completes when it is called from a task
+    /// that is already running on the Scheduler. The first exception thrown by `body`
+    /// is rethrown once every claimed index has finished.
+    /// </summary>
+    template <typename F> EG_INTERNAL_API void parallel_for(uint64_t count, F body)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        struct State {
+            std::atomic<uint64_t> next{0};
+            std::atomic<uint64_t> done{0};
+            std::mutex mutex;
+            condition_variable finished;
+            std::exception_ptr error;
+        };
+
+        // helpers that start late only see that nothing is left to claim,
+        // so they must not reference anything owned by this frame
+        auto state = std::make_shared<State>();
+        auto callable = std::make_shared<F>(std::move(body));
+        auto work = [state, callable, count]() {
+            for (auto i = state->next++; i < count; i = state->next++) {
+                try {
+                    (*callable)(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (!state->error) {
+                        state->error = std::current_exception();
+                    }
+                }
+                if (++state->done == count) {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        uint64_t helpers = std::min<uint64_t>(count, std::thread::hardware_concurrency());
+        for (uint64_t i = 1; i < helpers; i++) {
+            Scheduler::submit(work);
+        }
+        work();
+
+        unique_lock<mutex> lock(state->mutex);
+        state->finished.wait(lock, [&state, count] { return state->done.load() == count; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
 } // namespace electionguard
 
 #endif // __ELECTIONGUARD_CPP_ASYNC_HPP_INCLUDED__
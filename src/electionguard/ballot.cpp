@@ -4,6 +4,7 @@
 #include "electionguard/election_object_base.hpp"
 #include "electionguard/hash.hpp"
 #include "electionguard/precompute_buffers.hpp"
+#include "hash_stream.hpp"
 #include "log.hpp"
 #include "serialize.hpp"
 #include "utils.hpp"
@@ -384,8 +385,7 @@ namespace electionguard
                                               const ElementModQ &encryptionSeed,
                                               const ElGamalCiphertext &ciphertext)
     {
-        return hash_elems(
-          {objectId, &const_cast<ElementModQ &>(encryptionSeed), ciphertext.crypto_hash().get()});
+        return hash_elems(objectId, encryptionSeed, *ciphertext.crypto_hash());
     }
 
 #pragma endregion
@@ -789,11 +789,13 @@ namespace electionguard
             throw invalid_argument("mismatching selection state for " + objectId +
                                    "expected(some) actual(none)");
         }
-        vector<CryptoHashableType> elems = {objectId, &const_cast<ElementModQ &>(encryptionSeed)};
+        HashStream stream;
+        stream.append(objectId);
+        stream.append(encryptionSeed);
         for (const auto &selection : selections) {
-            elems.emplace_back(ref(*selection.get().getCryptoHash()));
+            stream.append(*selection.get().getCryptoHash());
         }
-        return hash_elems(elems);
+        return stream.finish();
     }
 
 #pragma endregion
@@ -1047,7 +1049,7 @@ namespace electionguard
                                                         const string &objectId,
                                                         const ElementModQ &nonce)
     {
-        return hash_elems({ref(manifestHash), objectId, ref(nonce)});
+        return hash_elems(manifestHash, objectId, nonce);
     }
 
     // Public Methods
@@ -1141,11 +1143,13 @@ namespace electionguard
                                    "expected(some) actual(none)");
         }
 
-        vector<CryptoHashableType> elems = {objectId, &const_cast<ElementModQ &>(manifestHash)};
+        HashStream stream;
+        stream.append(objectId);
+        stream.append(manifestHash);
         for (const auto &contest : contests) {
-            elems.emplace_back(ref(*contest.get().getCryptoHash()));
+            stream.append(*contest.get().getCryptoHash());
         }
-        return hash_elems(elems);
+        return stream.finish();
     }
 
 #pragma endregion
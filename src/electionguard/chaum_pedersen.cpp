@@ -1,9 +1,12 @@
 #include "electionguard/chaum_pedersen.hpp"
 
+#include "hash_stream.hpp"
 #include "log.hpp"
 #include "nonces.hpp"
+#include "random.hpp"
 #include "electionguard/precompute_buffers.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <electionguard/hash.hpp>
@@ -13,8 +16,12 @@
 using std::invalid_argument;
 using std::make_unique;
 using std::map;
+using std::pair;
+using std::sort;
+using std::reference_wrapper;
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
@@ -229,20 +236,28 @@ namespace electionguard
 
         auto consistent_c =
           (*add_mod_q(c0, c1) == c) &&
-          (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta, a0p, b0p, a1p, b1p}));
+          (c == *hash_elems(q, *alpha, *beta, *a0p, *b0p, *a1p, *b1p));
 
-        // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝
-        auto consistent_gv0 = (*g_pow_p(v0) == *mul_mod_p(a0, *pow_mod_p(*alpha, c0)));
+        // each equation is rearranged into a single multi-exponentiation
+        // using 𝛼^(𝑞-𝑐) = 𝛼^-𝑐, which holds since 𝛼 and 𝛽 are valid residues
+        auto neg_c0 = sub_from_q(c0);
+        auto neg_c1 = sub_from_q(c1);
 
-        // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝
-        auto consistent_gv1 = (*g_pow_p(v1) == *mul_mod_p(a1, *pow_mod_p(*alpha, c1)));
+        // the proof and the ciphertext are public, so the checks need not be constant time
+        const auto policy = ExponentiationPolicy::variableTime;
 
-        // 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝
-        auto consistent_kv0 = (*pow_mod_p(k, v0) == *mul_mod_p(b0, *pow_mod_p(*beta, c0)));
+        // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝  <=>  𝑔^𝑣 ⋅ 𝛼^(𝑞-𝑐) mod 𝑝 = 𝑎
+        auto consistent_gv0 = (*multi_pow_mod_p({G(), *alpha}, {v0, *neg_c0}, policy) == a0);
 
-        // 𝑔^𝑐 ⋅ 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝
+        // 𝑔^𝑣 mod 𝑝 = 𝑎 ⋅ 𝛼^𝑐 mod 𝑝  <=>  𝑔^𝑣 ⋅ 𝛼^(𝑞-𝑐) mod 𝑝 = 𝑎
+        auto consistent_gv1 = (*multi_pow_mod_p({G(), *alpha}, {v1, *neg_c1}, policy) == a1);
+
+        // 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝  <=>  𝐾^𝑣 ⋅ 𝛽^(𝑞-𝑐) mod 𝑝 = 𝑏
+        auto consistent_kv0 = (*multi_pow_mod_p({k, *beta}, {v0, *neg_c0}, policy) == b0);
+
+        // 𝑔^𝑐 ⋅ 𝐾^𝑣 mod 𝑝 = 𝑏 ⋅ 𝛽^𝑐 mod 𝑝  <=>  𝑔^𝑐 ⋅ 𝐾^𝑣 ⋅ 𝛽^(𝑞-𝑐) mod 𝑝 = 𝑏
         auto consistent_gc1kv1 =
-          (*mul_mod_p(*g_pow_p(c1), *pow_mod_p(k, v1)) == *mul_mod_p(b1, *pow_mod_p(*beta, c1)));
+          (*multi_pow_mod_p({G(), k, *beta}, {c1, v1, *neg_c1}, policy) == b1);
 
         auto success = inBounds_alpha && inBounds_beta && inBounds_a0 && inBounds_b0 &&
                        inBounds_a1 && inBounds_b1 && inBounds_c0 && inBounds_c1 && inBounds_v0 &&
@@ -291,6 +306,169 @@ namespace electionguard
         return success;
     }
 
+    /// <summary>
+    /// Draw nonzero 64-bit weights for the small-exponent batch test
+    /// </summary>
+    static vector<unique_ptr<ElementModQ>> make_batch_weights(size_t count)
+    {
+        vector<unique_ptr<ElementModQ>> weights;
+        weights.reserve(count);
+        while (weights.size() < count) {
+            auto bytes = Random::getBytes(ByteSize::SHA512);
+            for (size_t offset = 0; offset + sizeof(uint64_t) <= bytes.size() &&
+                                    weights.size() < count;
+                 offset += sizeof(uint64_t)) {
+                uint64_t weight = 0;
+                memcpy(&weight, &bytes[offset], sizeof(uint64_t));
+                weights.push_back(ElementModQ::fromUint64(weight == 0 ? 1UL : weight));
+            }
+        }
+        return weights;
+    }
+
+    /// <summary>
+    /// Check the verification equations of the selected items at once.
+    ///
+    /// Each of the four equations of item i is raised to its own random weight r_ij
+    /// and the results are multiplied together, giving
+    /// 𝑔^Σ(r1⋅𝑣0 + r2⋅𝑣1 + r4⋅𝑐1) ⋅ 𝐾^Σ(r3⋅𝑣0 + r4⋅𝑣1)
+    ///   = ∏ 𝑎0^r1 ⋅ 𝑎1^r2 ⋅ 𝑏0^r3 ⋅ 𝑏1^r4 ⋅ 𝛼^(r1⋅𝑐0 + r2⋅𝑐1) ⋅ 𝛽^(r3⋅𝑐0 + r4⋅𝑐1) mod 𝑝
+    /// which holds for valid proofs and fails with overwhelming probability otherwise.
+    /// </summary>
+    static bool verify_batch_equations(
+      const vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                        reference_wrapper<const DisjunctiveChaumPedersenProof>>> &items,
+      const vector<size_t> &indices, const ElementModP &k)
+    {
+        const size_t equationsPerProof = 4;
+        auto weights = make_batch_weights(indices.size() * equationsPerProof);
+
+        ElementModQ gExponent;
+        ElementModQ kExponent;
+        ElementModQ term;
+
+        vector<unique_ptr<ElementModQ>> exponents;
+        vector<reference_wrapper<const ElementModP>> bases;
+        vector<reference_wrapper<const ElementModQ>> exponentRefs;
+        exponents.reserve(indices.size() * 2);
+        bases.reserve(indices.size() * 6);
+        exponentRefs.reserve(indices.size() * 6);
+
+        for (size_t i = 0; i < indices.size(); i++) {
+            const auto &message = items[indices[i]].first.get();
+            const auto &proof = items[indices[i]].second.get();
+            const auto &r1 = *weights[i * equationsPerProof];
+            const auto &r2 = *weights[i * equationsPerProof + 1];
+            const auto &r3 = *weights[i * equationsPerProof + 2];
+            const auto &r4 = *weights[i * equationsPerProof + 3];
+
+            const auto &c0 = *proof.getProofZeroChallenge();
+            const auto &c1 = *proof.getProofOneChallenge();
+            const auto &v0 = *proof.getProofZeroResponse();
+            const auto &v1 = *proof.getProofOneResponse();
+
+            a_plus_bc_mod_q(gExponent, r1, v0, gExponent);
+            a_plus_bc_mod_q(gExponent, r2, v1, gExponent);
+            a_plus_bc_mod_q(gExponent, r4, c1, gExponent);
+            a_plus_bc_mod_q(kExponent, r3, v0, kExponent);
+            a_plus_bc_mod_q(kExponent, r4, v1, kExponent);
+
+            a_plus_bc_mod_q(ZERO_MOD_Q(), r1, c0, term);
+            exponents.push_back(a_plus_bc_mod_q(term, r2, c1));
+            a_plus_bc_mod_q(ZERO_MOD_Q(), r3, c0, term);
+            exponents.push_back(a_plus_bc_mod_q(term, r4, c1));
+
+            bases.insert(bases.end(), {*proof.getProofZeroPad(), *proof.getProofOnePad(),
+                                       *proof.getProofZeroData(), *proof.getProofOneData(),
+                                       *message.getPad(), *message.getData()});
+            exponentRefs.insert(exponentRefs.end(), {r1, r2, r3, r4, *exponents[i * 2],
+                                                     *exponents[i * 2 + 1]});
+        }
+
+        // the proofs and the ciphertexts are public, and the weights are drawn
+        // after them, so the checks need not be constant time
+        const auto policy = ExponentiationPolicy::variableTime;
+        auto lhs = multi_pow_mod_p({G(), k}, {gExponent, kExponent}, policy);
+        auto rhs = multi_pow_mod_p(bases, exponentRefs, policy);
+        return *lhs == *rhs;
+    }
+
+    /// <summary>
+    /// Check the selected items as one batch, bisecting into halves
+    /// until every invalid item is isolated
+    /// </summary>
+    static void verify_batch_bisect(
+      const vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                        reference_wrapper<const DisjunctiveChaumPedersenProof>>> &items,
+      const vector<size_t> &indices, const ElementModP &k, vector<size_t> &failed)
+    {
+        if (indices.empty() || verify_batch_equations(items, indices, k)) {
+            return;
+        }
+        if (indices.size() == 1) {
+            failed.push_back(indices.front());
+            return;
+        }
+
+        auto middle = indices.begin() + static_cast<std::ptrdiff_t>(indices.size() / 2);
+        verify_batch_bisect(items, vector<size_t>(indices.begin(), middle), k, failed);
+        verify_batch_bisect(items, vector<size_t>(middle, indices.end()), k, failed);
+    }
+
+    vector<size_t> DisjunctiveChaumPedersenProof::verifyBatch(
+      const vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                        reference_wrapper<const DisjunctiveChaumPedersenProof>>> &items,
+      const ElementModP &k, const ElementModQ &q)
+    {
+        Log::trace("DisjunctiveChaumPedersenProof::verifyBatch: ", static_cast<uint64_t>(items.size()));
+        vector<size_t> failed;
+        vector<size_t> candidates;
+        candidates.reserve(items.size());
+        // every challenge of the batch starts with the extended base hash
+        HashPrefix challenge({std::cref(q)});
+
+        // the batch equation only implies the individual equations when every
+        // element belongs to the group, so those checks are done for each item
+        for (size_t i = 0; i < items.size(); i++) {
+            const auto &message = items[i].first.get();
+            const auto &proof = items[i].second.get();
+            auto *alpha = message.getPad();
+            auto *beta = message.getData();
+            auto *a0 = proof.getProofZeroPad();
+            auto *b0 = proof.getProofZeroData();
+            auto *a1 = proof.getProofOnePad();
+            auto *b1 = proof.getProofOneData();
+            auto *c0 = proof.getProofZeroChallenge();
+            auto *c1 = proof.getProofOneChallenge();
+            auto *c = proof.getChallenge();
+
+            auto inBounds = alpha->isValidResidue() && beta->isValidResidue() &&
+                            a0->isValidResidue() && b0->isValidResidue() &&
+                            a1->isValidResidue() && b1->isValidResidue() && c0->isInBounds() &&
+                            c1->isInBounds() && proof.getProofZeroResponse()->isInBounds() &&
+                            proof.getProofOneResponse()->isInBounds();
+
+            auto consistent_c =
+              inBounds && (*add_mod_q(*c0, *c1) == *c) &&
+              (*c == *hash_elems(challenge, *alpha, *beta, *a0, *b0, *a1, *b1));
+
+            if (consistent_c) {
+                candidates.push_back(i);
+            } else {
+                failed.push_back(i);
+            }
+        }
+
+        verify_batch_bisect(items, candidates, k, failed);
+
+        sort(failed.begin(), failed.end());
+        if (!failed.empty()) {
+            Log::info("DisjunctiveChaumPedersenProof::verifyBatch: found invalid proofs: ",
+                      static_cast<uint64_t>(failed.size()));
+        }
+        return failed;
+    }
+
     std::unique_ptr<DisjunctiveChaumPedersenProof> DisjunctiveChaumPedersenProof::clone() const
     {
         return make_unique<DisjunctiveChaumPedersenProof>(
@@ -322,8 +500,7 @@ namespace electionguard
         auto b1 = mul_mod_p(*g_pow_p(*w), *pow_mod_p(k, *v)); // g^w⋅K^v mod p
 
         // Compute the challenge
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
 
         //c_1 = w so we dont assign a new var for it
         auto c0 = sub_mod_q(*c, *w);           // c_0=(c-w) mod q
@@ -359,8 +536,7 @@ namespace electionguard
                      pow_mod_p(*beta, *q_min_c1).get()}); // K^(v_1) g^(c_1) β^(q-c_1)  mod p
 
         // Compute the challenge
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
 
         auto c0 = sub_mod_q(*c, *c1);           // c_0=(c-c_1) mod q
         auto v0 = a_plus_bc_mod_q(*u0, *c0, r); // v_0=(u_0+c_0⋅R) mod q
@@ -395,8 +571,7 @@ namespace electionguard
         auto b1 = quad->get_g_to_exp2_mult_by_pubkey_to_exp1();  // g^w⋅K^v mod p
  
         // Compute the challenge
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
 
         //c_1 = w so we dont assign a new var for it
         auto c0 = sub_mod_q(*c, *w);            // c_0=(c-w) mod q
@@ -425,8 +600,7 @@ namespace electionguard
         auto b1 = pow_mod_p(k, *u);                           // K^u  mod p
 
         // Compute challenge
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
 
         auto c0 = sub_mod_q(Q(), *w);          // c_0=(q-w)  mod q
         auto c1 = add_mod_q(*c, *w);           // c_1=(c+w)  mod q
@@ -456,8 +630,7 @@ namespace electionguard
         auto b0 = mul_mod_p(*pow_mod_p(k, *v0), *pow_mod_p(*beta, *q_min_c0));
         auto a1 = g_pow_p(*u1);
         auto b1 = pow_mod_p(k, *u1);
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
         auto c1 = sub_mod_q(*c, *c0);
         auto v1 = a_plus_bc_mod_q(*u1, *c1, r);
 
@@ -493,8 +666,7 @@ namespace electionguard
         auto b1 = triple2->get_pubkey_to_exp();                 // 𝐾^𝑢 mod 𝑝
 
         // Compute challenge
-        auto c = hash_elems(
-          {&const_cast<ElementModQ &>(q), alpha, beta, a0.get(), b0.get(), a1.get(), b1.get()});
+        auto c = hash_elems(q, *alpha, *beta, *a0, *b0, *a1, *b1);
 
         auto c0 = sub_mod_q(Q(), *w);          // c_0=(q-w)  mod q
         auto c1 = add_mod_q(*c, *w);           // c_1=(c+w)  mod q
@@ -601,8 +773,7 @@ namespace electionguard
         }
 
         // sha256(𝑄', A, B, a, b)
-        auto c =
-          hash_elems({&const_cast<ElementModQ &>(hash_header), alpha, beta, a.get(), b.get()});
+        auto c = hash_elems(hash_header, *alpha, *beta, *a, *b);
         auto v = a_plus_bc_mod_q(*u, *c, r);
 
         return make_unique<ConstantChaumPedersenProof>(move(a), move(b), move(c), move(v),
@@ -620,7 +791,6 @@ namespace electionguard
 
         auto *a_ptr = pimpl->pad.get();
         auto *b_ptr = pimpl->data.get();
-        auto *c_ptr = pimpl->challenge.get();
 
         auto a = *pimpl->pad;
         auto b = *pimpl->data;
@@ -637,15 +807,21 @@ namespace electionguard
 
         auto constant_q = ElementModQ::fromUint64(constant);
 
-        auto consistent_c =
-          (c == *hash_elems({&const_cast<ElementModQ &>(q), alpha, beta, a_ptr, b_ptr}));
+        auto consistent_c = (c == *hash_elems(q, *alpha, *beta, *a_ptr, *b_ptr));
+
+        // each equation is rearranged into a single multi-exponentiation
+        // using 𝐴^(𝑞-𝐶) = 𝐴^-𝐶, which holds since 𝐴 and 𝐵 are valid residues
+        auto neg_c = sub_from_q(c);
+
+        // the proof and the ciphertext are public, so the checks need not be constant time
+        const auto policy = ExponentiationPolicy::variableTime;
 
-        // 𝑔^𝑉 = 𝑎 ⋅ 𝐴^𝐶 mod 𝑝
-        auto consistent_gv = (*g_pow_p(v) == *mul_mod_p(a, *pow_mod_p(*alpha, c)));
+        // 𝑔^𝑉 = 𝑎 ⋅ 𝐴^𝐶 mod 𝑝  <=>  𝑔^𝑉 ⋅ 𝐴^(𝑞-𝐶) mod 𝑝 = 𝑎
+        auto consistent_gv = (*multi_pow_mod_p({G(), *alpha}, {v, *neg_c}, policy) == a);
 
-        // 𝑔^𝐿 ⋅ 𝐾^𝑣 = 𝑏 ⋅ 𝐵^𝐶 mod 𝑝
-        auto consistent_kv = (*mul_mod_p(*g_pow_p(*mul_mod_p({c_ptr, constant_q.get()})),
-                                         *pow_mod_p(k, v)) == *mul_mod_p(b, *pow_mod_p(*beta, c)));
+        // 𝑔^𝐿 ⋅ 𝐾^𝑣 = 𝑏 ⋅ 𝐵^𝐶 mod 𝑝  <=>  𝑔^(𝐶𝐿 mod 𝑞) ⋅ 𝐾^𝑣 ⋅ 𝐵^(𝑞-𝐶) mod 𝑝 = 𝑏
+        auto cl = a_plus_bc_mod_q(ZERO_MOD_Q(), c, *constant_q);
+        auto consistent_kv = (*multi_pow_mod_p({G(), k, *beta}, {*cl, v, *neg_c}, policy) == b);
 
         auto success = inBounds_alpha && inBounds_beta && inBounds_a && inBounds_b && inBounds_c &&
                        inBounds_v && consistent_c && consistent_gv && consistent_kv;
@@ -0,0 +1,319 @@
+#include "discrete_log.hpp"
+
+#include "async.hpp"
+#include "facades/Hacl_Bignum4096.hpp"
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+using hacl::CONTEXT_P;
+using std::invalid_argument;
+using std::make_shared;
+using std::min;
+using std::runtime_error;
+using std::shared_ptr;
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+namespace electionguard
+{
+    /// <summary>
+    /// the number of consecutive powers computed by each task when generating a table
+    /// </summary>
+    const uint64_t DLOG_TABLE_CHUNK = 1024U;
+
+    /// <summary>
+    /// the largest bound of a table, the exponents are stored in 32 bits
+    /// </summary>
+    const uint64_t DLOG_MAX_BOUND = 0xfffffffeU;
+
+#pragma region DiscreteLogTable
+
+    DiscreteLogTable::DiscreteLogTable(uint64_t bound)
+        : _bound(bound), _slotCount(slotCount(bound)), _ownedKeys(_slotCount, 0),
+          _ownedExponents(_slotCount, 0)
+    {
+        uint64_t generatorM[MAX_P_LEN] = {};
+        CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(G().data()),
+                                       static_cast<uint64_t *>(generatorM));
+
+        // every chunk starts from its own power of g, so the chunks are independent
+        vector<uint64_t> powerKeys(bound);
+        auto chunks = (bound + DLOG_TABLE_CHUNK - 1) / DLOG_TABLE_CHUNK;
+        parallel_for(chunks, [&powerKeys, &generatorM, bound](uint64_t chunk) {
+            auto first = chunk * DLOG_TABLE_CHUNK;
+            auto last = min(first + DLOG_TABLE_CHUNK, bound);
+            uint64_t exponentLimbs[MAX_Q_LEN] = {first};
+            ElementModQ exponent(exponentLimbs, true);
+            auto start = g_pow_p(exponent);
+
+            uint64_t powerM[MAX_P_LEN] = {};
+            CONTEXT_P().to_montgomery_form(start->get(), static_cast<uint64_t *>(powerM));
+            for (auto i = first; i < last; i++) {
+                powerKeys[i] = powerM[0];
+                CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+                  static_cast<uint64_t *>(powerM), static_cast<uint64_t *>(generatorM),
+                  static_cast<uint64_t *>(powerM));
+            }
+        });
+
+        auto mask = _slotCount - 1;
+        for (uint64_t i = 0; i < bound; i++) {
+            auto slot = powerKeys[i] & mask;
+            while (_ownedExponents[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            _ownedKeys[slot] = powerKeys[i];
+            _ownedExponents[slot] = static_cast<uint32_t>(i + 1);
+        }
+
+        _keys = _ownedKeys.data();
+        _exponents = _ownedExponents.data();
+        computeGiantStep();
+    }
+
+    DiscreteLogTable::DiscreteLogTable(unique_ptr<MappedFile> mapping, uint64_t bound,
+                                       uint64_t slotCount)
+        : _bound(bound), _slotCount(slotCount), _mapping(std::move(mapping))
+    {
+        _keys = reinterpret_cast<const uint64_t *>(_mapping->data() + DLOG_FILE_HEADER_SIZE);
+        _exponents = reinterpret_cast<const uint32_t *>(_keys + _slotCount);
+        computeGiantStep();
+    }
+
+    unique_ptr<DiscreteLogTable> DiscreteLogTable::load(const string &path)
+    {
+        auto mapping = std::make_unique<MappedFile>(path);
+        DiscreteLogFileHeader header;
+        if (mapping->size() < DLOG_FILE_HEADER_SIZE) {
+            throw runtime_error("DiscreteLogTable:: unexpected file size for " + path);
+        }
+        memcpy(&header, mapping->data(), sizeof(header));
+
+        if (header.bound == 0 || header.bound > DLOG_MAX_BOUND ||
+            header.slotCount != slotCount(header.bound) ||
+            mapping->size() != DLOG_FILE_HEADER_SIZE + byteSize(header.slotCount)) {
+            throw runtime_error("DiscreteLogTable:: unexpected file size for " + path);
+        }
+
+        auto expected = makeHeader(header.bound, header.slotCount);
+        memcpy(expected.bodyDigest, header.bodyDigest, sizeof(expected.bodyDigest));
+        if (memcmp(&header, &expected, sizeof(header)) != 0) {
+            throw runtime_error("DiscreteLogTable:: " + path +
+                                " does not match the group parameters");
+        }
+
+        unique_ptr<DiscreteLogTable> table(
+          new DiscreteLogTable(std::move(mapping), header.bound, header.slotCount));
+
+        // the keys and exponents must be the ones saved, and g^0, the montgomery form of 1,
+        // must be in the table
+        uint8_t bodyDigest[32] = {};
+        table->digestBody(bodyDigest);
+        uint64_t oneM[MAX_P_LEN] = {};
+        CONTEXT_P().montgomery_one(static_cast<uint64_t *>(oneM));
+        if (memcmp(bodyDigest, header.bodyDigest, sizeof(bodyDigest)) != 0 ||
+            table->find(oneM[0]) != 0) {
+            throw runtime_error("DiscreteLogTable:: " + path + " contains unexpected values");
+        }
+        return table;
+    }
+
+    void DiscreteLogTable::save(const string &path) const
+    {
+        auto header = makeHeader(_bound, _slotCount);
+        digestBody(header.bodyDigest);
+        vector<char> padding(DLOG_FILE_HEADER_SIZE - sizeof(header), 0);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw runtime_error("DiscreteLogTable:: could not open " + path);
+        }
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+        file.write(reinterpret_cast<const char *>(_keys),
+                   static_cast<std::streamsize>(_slotCount * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char *>(_exponents),
+                   static_cast<std::streamsize>(_slotCount * sizeof(uint32_t)));
+        if (!file) {
+            throw runtime_error("DiscreteLogTable:: could not write " + path);
+        }
+    }
+
+    uint64_t DiscreteLogTable::find(uint64_t key, uint64_t &slot) const
+    {
+        // the table is at most half full, so the probing ends on an empty slot
+        auto mask = _slotCount - 1;
+        for (; _exponents[slot] != 0; slot = (slot + 1) & mask) {
+            if (_keys[slot] == key) {
+                auto exponent = _exponents[slot] - 1;
+                slot = (slot + 1) & mask;
+                return exponent;
+            }
+        }
+        return MAX_UINT64;
+    }
+
+    uint64_t DiscreteLogTable::slotCount(uint64_t bound)
+    {
+        if (bound == 0 || bound > DLOG_MAX_BOUND) {
+            throw invalid_argument("DiscreteLogTable:: unsupported bound " +
+                                   std::to_string(bound));
+        }
+
+        uint64_t slots = 2;
+        while (slots < bound * 2) {
+            slots <<= 1;
+        }
+        return slots;
+    }
+
+    DiscreteLogFileHeader DiscreteLogTable::makeHeader(uint64_t bound, uint64_t slotCount)
+    {
+        DiscreteLogFileHeader header = {};
+        memcpy(header.magic, DLOG_FILE_MAGIC, sizeof(header.magic));
+        header.version = DLOG_FILE_VERSION;
+        header.bound = bound;
+        header.slotCount = slotCount;
+
+        // digest the shape of the table and the group
+        Sha256 hash;
+        auto update = [&hash](const void *data, size_t size) {
+            hash.update(static_cast<const uint8_t *>(data), size);
+        };
+        update(&header, sizeof(header));
+        update(P_ARRAY_REVERSE, sizeof(P_ARRAY_REVERSE));
+        update(Q_ARRAY_REVERSE, sizeof(Q_ARRAY_REVERSE));
+        update(G_ARRAY_REVERSE, sizeof(G_ARRAY_REVERSE));
+        hash.finish(header.digest);
+        return header;
+    }
+
+    void DiscreteLogTable::digestBody(uint8_t (&digest)[32]) const
+    {
+        Sha256 hash;
+        hash.update(reinterpret_cast<const uint8_t *>(_keys), _slotCount * sizeof(uint64_t));
+        hash.update(reinterpret_cast<const uint8_t *>(_exponents), _slotCount * sizeof(uint32_t));
+        hash.finish(digest);
+    }
+
+    void DiscreteLogTable::computeGiantStep()
+    {
+        uint64_t exponentLimbs[MAX_Q_LEN] = {_bound};
+        ElementModQ exponent(exponentLimbs, true);
+        auto power = g_pow_p(exponent);
+
+        uint64_t inverse[MAX_P_LEN] = {};
+        CONTEXT_P().modInvPrime(power->get(), static_cast<uint64_t *>(inverse));
+        CONTEXT_P().to_montgomery_form(static_cast<uint64_t *>(inverse),
+                                       static_cast<uint64_t *>(_giantStep));
+    }
+
+#pragma endregion
+
+#pragma region DiscreteLogContext
+
+    uint64_t DiscreteLogContext::find(const ElementModP &element)
+    {
+        auto &instance = getInstance();
+        auto table = instance.getTable();
+        auto maxExponent = instance.max_exponent.load();
+        auto bound = table->bound();
+
+        uint64_t elementM[MAX_P_LEN] = {};
+        CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(element.data()),
+                                       static_cast<uint64_t *>(elementM));
+
+        // the element is g^(step * bound + i) for the i found in the table
+        // once it has been multiplied by g^-bound step times
+        auto steps = maxExponent / bound;
+        for (uint64_t step = 0; step <= steps; step++) {
+            // the table only holds the low limb of each power, so every power sharing it
+            // is a candidate until it is confirmed
+            auto slot = table->firstSlot(elementM[0]);
+            for (auto i = table->find(elementM[0], slot); i != MAX_UINT64;
+                 i = table->find(elementM[0], slot)) {
+                auto exponent = step * bound + i;
+                if (exponent > maxExponent) {
+                    continue;
+                }
+                uint64_t exponentLimbs[MAX_Q_LEN] = {exponent};
+                auto power = g_pow_p(ElementModQ(exponentLimbs, true));
+                if (std::equal(power->data(), power->data() + MAX_P_LEN, element.data())) {
+                    return exponent;
+                }
+            }
+            CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              static_cast<uint64_t *>(elementM), const_cast<uint64_t *>(table->giantStep()),
+              static_cast<uint64_t *>(elementM));
+        }
+        return MAX_UINT64;
+    }
+
+    void DiscreteLogContext::setPolicy(uint64_t maxExponent, uint64_t byteBudget)
+    {
+        if (byteBudget < DiscreteLogTable::byteSize(DiscreteLogTable::slotCount(1))) {
+            throw invalid_argument("setPolicy:: the byte budget cannot hold a discrete log table");
+        }
+
+        auto &instance = getInstance();
+        std::lock_guard<std::mutex> guard(instance.lock);
+        instance.max_exponent = maxExponent;
+        instance.byte_budget = byteBudget;
+        std::atomic_store(&instance.published, shared_ptr<const DiscreteLogTable>());
+    }
+
+    void DiscreteLogContext::save(const string &path) { getInstance().getTable()->save(path); }
+
+    void DiscreteLogContext::load(const string &path)
+    {
+        shared_ptr<const DiscreteLogTable> table = DiscreteLogTable::load(path);
+        auto &instance = getInstance();
+        std::lock_guard<std::mutex> guard(instance.lock);
+        std::atomic_store(&instance.published, table);
+    }
+
+    shared_ptr<const DiscreteLogTable> DiscreteLogContext::getTable()
+    {
+        auto table = std::atomic_load(&published);
+        if (table != nullptr) {
+            return table;
+        }
+
+        // callers that need the table while it is generated wait for the same table
+        std::lock_guard<std::mutex> guard(lock);
+        table = std::atomic_load(&published);
+        if (table == nullptr) {
+            table = make_shared<const DiscreteLogTable>(bound());
+            std::atomic_store(&published, table);
+        }
+        return table;
+    }
+
+    uint64_t DiscreteLogContext::bound() const
+    {
+        // the square root of the range balances the baby steps against the giant steps
+        auto maxExponent = max_exponent.load();
+        auto root = static_cast<uint64_t>(std::sqrt(static_cast<double>(maxExponent)));
+        while (root < DLOG_MAX_BOUND && root * root < maxExponent) {
+            root++;
+        }
+
+        // the largest table that fits in the budget
+        uint64_t capacity = 1;
+        while (DiscreteLogTable::byteSize(DiscreteLogTable::slotCount(capacity * 2)) <=
+                 byte_budget.load() &&
+               capacity * 2 <= DLOG_MAX_BOUND) {
+            capacity *= 2;
+        }
+        return std::max<uint64_t>(1, min(root + 1, capacity));
+    }
+
+#pragma endregion
+
+} // namespace electionguard
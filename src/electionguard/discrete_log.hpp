@@ -0,0 +1,205 @@
+#ifndef __ELECTIONGUARD_CPP_DISCRETE_LOG_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_DISCRETE_LOG_HPP_INCLUDED__
+
+#include "mapped_file.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+#include <electionguard/group.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The header of a serialized discrete log table file.
+    ///
+    /// The keys and the exponents follow the header starting at DLOG_FILE_HEADER_SIZE.
+    /// The digest binds the file to its shape and the group parameters,
+    /// a file built for anything else is rejected when it is loaded.
+    /// The body digest covers the keys and the exponents, so a corrupted file is rejected as well.
+    /// </summary>
+    struct DiscreteLogFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t bound;
+        uint64_t slotCount;
+        uint8_t digest[32];
+        uint8_t bodyDigest[32];
+    };
+
+    const char DLOG_FILE_MAGIC[8] = {'E', 'G', 'D', 'L', 'O', 'G', 'T', 'B'};
+    const uint32_t DLOG_FILE_VERSION = 2U;
+    const uint64_t DLOG_FILE_HEADER_SIZE = 4096U;
+
+    /// <summary>
+    /// An open addressing hash table of the powers g^i for i in [0, bound).
+    ///
+    /// Each power is keyed by the low limb of its montgomery form and only the key and
+    /// the exponent are kept, so a hit is a candidate that the caller confirms.
+    /// The table is immutable once it is built or loaded and can be read concurrently.
+    /// </summary>
+    class EG_INTERNAL_API DiscreteLogTable
+    {
+      public:
+        /// <summary>
+        /// Compute the powers of g below the bound in parallel on the Scheduler
+        /// </summary>
+        explicit DiscreteLogTable(uint64_t bound);
+
+        /// <summary>
+        /// Memory map a table written by `save`.
+        /// Throws runtime_error when the file was produced for a different group,
+        /// when it is truncated, or when its keys and exponents do not match the body digest.
+        /// </summary>
+        static std::unique_ptr<DiscreteLogTable> load(const std::string &path);
+
+        /// <summary>
+        /// Write the table to a file that can be memory mapped by `load`
+        /// </summary>
+        void save(const std::string &path) const;
+
+        /// <summary>
+        /// the exponent i of the first power g^i whose montgomery form has the low limb,
+        /// MAX_UINT64 when no power below the bound has it
+        /// </summary>
+        uint64_t find(uint64_t key) const
+        {
+            auto slot = firstSlot(key);
+            return find(key, slot);
+        }
+
+        /// <summary>
+        /// the exponent of the next power with the low limb, probing from `slot`,
+        /// MAX_UINT64 when there is none. `slot` is moved past the match, so calling again
+        /// yields the other powers sharing the low limb in turn.
+        /// </summary>
+        uint64_t find(uint64_t key, uint64_t &slot) const;
+
+        /// <summary>
+        /// the slot where the probing for the low limb starts
+        /// </summary>
+        uint64_t firstSlot(uint64_t key) const { return key & (_slotCount - 1); }
+
+        uint64_t bound() const { return _bound; }
+
+        /// <summary>
+        /// g^-bound in montgomery form, the factor of each giant step
+        /// </summary>
+        const uint64_t *giantStep() const { return _giantStep; }
+
+        /// <summary>
+        /// the number of bytes occupied by the keys and the exponents
+        /// </summary>
+        uint64_t byteSize() const { return byteSize(_slotCount); }
+
+        /// <summary>
+        /// the number of slots of the table holding `bound` powers, a power of two
+        /// that keeps the table at most half full.
+        /// Throws invalid_argument when the bound is zero or does not fit in 32 bits.
+        /// </summary>
+        static uint64_t slotCount(uint64_t bound);
+
+        static uint64_t byteSize(uint64_t slotCount)
+        {
+            return slotCount * (sizeof(uint64_t) + sizeof(uint32_t));
+        }
+
+      private:
+        DiscreteLogTable(std::unique_ptr<MappedFile> mapping, uint64_t bound, uint64_t slotCount);
+
+        static DiscreteLogFileHeader makeHeader(uint64_t bound, uint64_t slotCount);
+
+        /// <summary>
+        /// digest the keys and the exponents in the order they are saved
+        /// </summary>
+        void digestBody(uint8_t (&digest)[32]) const;
+
+        void computeGiantStep();
+
+        uint64_t _bound;
+        uint64_t _slotCount;
+        std::vector<uint64_t> _ownedKeys;
+        // exponent + 1 of the power in each slot, zero for an empty slot
+        std::vector<uint32_t> _ownedExponents;
+        std::unique_ptr<MappedFile> _mapping;
+        const uint64_t *_keys = nullptr;
+        const uint32_t *_exponents = nullptr;
+        uint64_t _giantStep[MAX_P_LEN] = {};
+    };
+
+    /// <summary>
+    /// A singleton context for finding the discrete log of elements to the base g.
+    ///
+    /// Small exponents are found directly in a table of the powers of g below a bound,
+    /// larger exponents by baby-step giant-step: the element is repeatedly multiplied by
+    /// g^-bound until it lands in the table. The bound is the square root of the largest
+    /// exponent searched, capped so that the table stays within the byte budget.
+    ///
+    /// The table is generated the first time it is needed and replaced as a whole when
+    /// the policy changes, so searches never take a lock.
+    /// </summary>
+    class EG_INTERNAL_API DiscreteLogContext
+    {
+      public:
+        DiscreteLogContext(const DiscreteLogContext &) = delete;
+        DiscreteLogContext(DiscreteLogContext &&) = delete;
+        DiscreteLogContext &operator=(const DiscreteLogContext &) = delete;
+        DiscreteLogContext &operator=(DiscreteLogContext &&) = delete;
+
+      private:
+        DiscreteLogContext() {}
+        ~DiscreteLogContext() {}
+
+      public:
+        static DiscreteLogContext &getInstance()
+        {
+            static DiscreteLogContext instance;
+            return instance;
+        }
+
+        /// <summary>
+        /// the exponent x in [0, maxExponent] such that g^x == element,
+        /// MAX_UINT64 when there is none
+        /// </summary>
+        static uint64_t find(const ElementModP &element);
+
+        /// <summary>
+        /// configure the largest exponent searched and the bytes the table may occupy.
+        /// the existing table is discarded and a new one is generated on the next search.
+        /// </summary>
+        static void setPolicy(uint64_t maxExponent, uint64_t byteBudget);
+
+        /// <summary>
+        /// write the table to a file, generating the table first if it does not exist yet
+        /// </summary>
+        static void save(const std::string &path);
+
+        /// <summary>
+        /// memory map a table file and use it for subsequent searches
+        /// </summary>
+        static void load(const std::string &path);
+
+      private:
+        std::shared_ptr<const DiscreteLogTable> getTable();
+
+        /// <summary>
+        /// the bound of a new table under the policy
+        /// </summary>
+        uint64_t bound() const;
+
+        // the current table, replaced as a whole while holding the lock
+        std::shared_ptr<const DiscreteLogTable> published;
+        std::mutex lock;
+        std::atomic<uint64_t> max_exponent{DLOG_MAX_EXPONENT};
+        std::atomic<uint64_t> byte_budget{DLOG_TABLE_BYTE_BUDGET};
+    };
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_DISCRETE_LOG_HPP_INCLUDED__ */
@@ -52,6 +52,7 @@ namespace electionguard
             this->quorum = quorum;
             this->extendedData = {};
             this->configuration = make_unique<ContextConfiguration>();
+            flagFixedBase();
         }
 
         Impl(uint64_t numberOfGuardians, uint64_t quorum, unique_ptr<ElementModP> elGamalPublicKey,
@@ -79,6 +80,7 @@ namespace electionguard
             this->numberOfGuardians = numberOfGuardians;
             this->quorum = quorum;
             this->configuration = make_unique<ContextConfiguration>();
+            flagFixedBase();
         }
 
         Impl(uint64_t numberOfGuardians, uint64_t quorum, unique_ptr<ElementModP> elGamalPublicKey,
@@ -93,6 +95,16 @@ namespace electionguard
             this->quorum = quorum;
             this->configuration = move(config);
         }
+
+        /// <summary>
+        /// every exponentiation of the joint public key uses its lookup table
+        /// </summary>
+        void flagFixedBase()
+        {
+            if (elGamalPublicKey != nullptr) {
+                elGamalPublicKey->setIsFixedBase(true);
+            }
+        }
     };
 
     // Lifecycle Methods
@@ -201,6 +213,32 @@ namespace electionguard
         return ContextSerializer::fromBson(move(data));
     }
 
+    unique_ptr<CiphertextElectionContext>
+    CiphertextElectionContext::fromJson(string data, const string &lookupTablePath)
+    {
+        auto context = fromJson(move(data));
+        context->loadLookupTable(lookupTablePath);
+        return context;
+    }
+
+    unique_ptr<CiphertextElectionContext>
+    CiphertextElectionContext::fromBson(vector<uint8_t> data, const string &lookupTablePath)
+    {
+        auto context = fromBson(move(data));
+        context->loadLookupTable(lookupTablePath);
+        return context;
+    }
+
+    void CiphertextElectionContext::saveLookupTable(const string &path) const
+    {
+        save_lookup_table(*pimpl->elGamalPublicKey, path);
+    }
+
+    void CiphertextElectionContext::loadLookupTable(const string &path) const
+    {
+        load_lookup_table(*pimpl->elGamalPublicKey, path);
+    }
+
     // Public Static Methods
 
     unique_ptr<CiphertextElectionContext> CiphertextElectionContext::make(
@@ -213,9 +251,6 @@ namespace electionguard
 
         auto cryptoExtendedBaseHash = hash_elems({cryptoBaseHash.get(), commitmentHash.get()});
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make_unique<CiphertextElectionContext>(
           numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
           move(manifestHash), move(cryptoBaseHash), move(cryptoExtendedBaseHash));
@@ -232,9 +267,6 @@ namespace electionguard
 
         auto cryptoExtendedBaseHash = hash_elems({cryptoBaseHash.get(), commitmentHash.get()});
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make_unique<CiphertextElectionContext>(
           numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
           move(manifestHash), move(cryptoBaseHash), move(cryptoExtendedBaseHash), move(config));
@@ -251,9 +283,6 @@ namespace electionguard
 
         auto cryptoExtendedBaseHash = hash_elems({cryptoBaseHash.get(), commitmentHash.get()});
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make_unique<CiphertextElectionContext>(
           numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
           move(manifestHash), move(cryptoBaseHash), move(cryptoExtendedBaseHash),
@@ -272,9 +301,6 @@ namespace electionguard
 
         auto cryptoExtendedBaseHash = hash_elems({cryptoBaseHash.get(), commitmentHash.get()});
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make_unique<CiphertextElectionContext>(
           numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
           move(manifestHash), move(cryptoBaseHash), move(cryptoExtendedBaseHash), move(config),
@@ -289,9 +315,6 @@ namespace electionguard
         auto commitmentHash = ElementModQ::fromHex(commitmentHashInHex);
         auto manifestHash = ElementModQ::fromHex(manifestHashInHex);
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make(numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
                     move(manifestHash));
     }
@@ -305,9 +328,6 @@ namespace electionguard
         auto commitmentHash = ElementModQ::fromHex(commitmentHashInHex);
         auto manifestHash = ElementModQ::fromHex(manifestHashInHex);
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make(numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
                     move(manifestHash), move(extendedData));
     }
@@ -321,9 +341,6 @@ namespace electionguard
         auto commitmentHash = ElementModQ::fromHex(commitmentHashInHex);
         auto manifestHash = ElementModQ::fromHex(manifestHashInHex);
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make(numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
                     move(manifestHash), move(config));
     }
@@ -338,9 +355,6 @@ namespace electionguard
         auto commitmentHash = ElementModQ::fromHex(commitmentHashInHex);
         auto manifestHash = ElementModQ::fromHex(manifestHashInHex);
 
-        // ensure the elgamal public key instance is set as a fixed base
-        elGamalPublicKey->setIsFixedBase(true);
-
         return make(numberOfGuardians, quorum, move(elGamalPublicKey), move(commitmentHash),
                     move(manifestHash), move(config), move(extendedData));
     }
@@ -8,7 +8,11 @@
 
 #include "electionguard/precompute_buffers.hpp"
 
+#include "async.hpp"
+#include "hash_stream.hpp"
 #include "log.hpp"
+#include "mont_element.hpp"
+#include "montgomery_kernels.hpp"
 
 #include <array>
 #include <electionguard/hash.hpp>
@@ -21,6 +25,7 @@ using std::move;
 using std::reference_wrapper;
 using std::runtime_error;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
@@ -81,6 +86,22 @@ namespace electionguard
 
 #pragma region ElGamalCiphertext
 
+    /// <summary>
+    /// Map the decrypted element g^m to the message m it encodes,
+    /// MAX_UINT64 when no message is found
+    /// </summary>
+    static uint64_t plaintextOf(const ElementModP &result)
+    {
+        // 0 and 1 are the plaintexts of most ciphertexts, so check them before searching
+        if (const_cast<ElementModP &>(result) == ONE_MOD_P()) {
+            return 0;
+        }
+        if (const_cast<ElementModP &>(result) == G()) {
+            return 1;
+        }
+        return discrete_log(result);
+    }
+
     struct ElGamalCiphertext::Impl {
         unique_ptr<ElementModP> pad;
         unique_ptr<ElementModP> data;
@@ -99,7 +120,7 @@ namespace electionguard
 
         [[nodiscard]] unique_ptr<ElementModQ> crypto_hash() const
         {
-            return hash_elems({pad.get(), data.get()});
+            return hash_elems(*pad, *data);
         }
 
         bool operator==(const Impl &other) { return *pad == *other.pad && *data == *other.data; }
@@ -157,10 +178,9 @@ namespace electionguard
 
     uint64_t ElGamalCiphertext::decrypt(const ElementModQ &secretKey)
     {
-        // Note this decryption method is primarily used for testing
-        // and is only capable of decrypting boolean results (0/1)
-        // it should be extended with a discrete_log search to decrypt
-        // values other than 0 or 1
+        // Note this decryption method is primarily used for testing.
+        // values other than 0 or 1 are found with a discrete_log search
+        // bounded by the discrete log policy
 
         const auto &p = P();
         auto secret = secretKey.toElementModP();
@@ -189,19 +209,49 @@ namespace electionguard
             return 0;
         }
 
-        // TODO: ISSUE #133: traverse a discrete_log lookup to find the result
         auto result_as_p = make_unique<ElementModP>(result);
-        uint64_t retval = MAX_UINT64;
-        if (*result_as_p == ONE_MOD_P()) {
-            // if it is 1 it is false
-            retval = 0;
-        } else if (*result_as_p == G()) {
-            // if it is g, it is true
-            retval = 1;
+        return plaintextOf(*result_as_p);
+    }
+
+    vector<uint64_t> ElGamalCiphertext::decryptBatch(
+      const vector<reference_wrapper<const ElGamalCiphertext>> &ciphertexts,
+      const ElementModQ &secretKey)
+    {
+        auto count = ciphertexts.size();
+        vector<unique_ptr<ElementModP>> divisors(count);
+
+        // the pads are independent exponentiations, so chunks of them run on the
+        // Scheduler and each chunk fills the lanes of pow_mod_p_batch
+        auto chunks = (count + MONTGOMERY_LANES - 1) / MONTGOMERY_LANES;
+        parallel_for(chunks, [&ciphertexts, &secretKey, &divisors, count](uint64_t chunk) {
+            auto first = chunk * MONTGOMERY_LANES;
+            auto last = std::min<uint64_t>(first + MONTGOMERY_LANES, count);
+            vector<reference_wrapper<const ElementModP>> pads;
+            vector<reference_wrapper<const ElementModQ>> exponents;
+            for (auto i = first; i < last; i++) {
+                pads.push_back(*ciphertexts[i].get().getPad());
+                exponents.push_back(secretKey);
+            }
+
+            auto powers = pow_mod_p_batch(pads, exponents);
+            for (auto i = first; i < last; i++) {
+                divisors[i] = move(powers[i - first]);
+            }
+        });
+
+        vector<reference_wrapper<const ElementModP>> divisorRefs;
+        for (const auto &divisor : divisors) {
+            divisorRefs.push_back(*divisor);
         }
+        auto inverses = inv_mod_p_batch(divisorRefs);
 
-        // if it is anything else no result found (decrypt failed)
-        return retval;
+        vector<uint64_t> plaintexts;
+        plaintexts.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            auto result = mul_mod_p(*ciphertexts[i].get().getData(), *inverses[i]);
+            plaintexts.push_back(plaintextOf(*result));
+        }
+        return plaintexts;
     }
 
     unique_ptr<ElGamalCiphertext> ElGamalCiphertext::clone() const
@@ -218,8 +268,9 @@ namespace electionguard
             throw invalid_argument("elgamalEncrypt encryption requires a non-zero nonce");
         }
 
-        auto pad = g_pow_p(nonce);
-        auto pubkey_pow_n = pow_mod_p(publicKey, nonce);
+        auto powers = pow_mod_p_shared_exponent({G(), publicKey}, nonce);
+        auto pad = move(powers[0]);
+        auto pubkey_pow_n = move(powers[1]);
         unique_ptr<ElementModP> data = nullptr;
         if (m == 1) {
             data = mul_mod_p(G(), *pubkey_pow_n);
@@ -235,6 +286,40 @@ namespace electionguard
         return make_unique<ElGamalCiphertext>(move(pad), move(data));
     }
 
+    vector<unique_ptr<ElGamalCiphertext>>
+    elgamalEncryptBatch(const vector<uint64_t> &messages,
+                        const vector<reference_wrapper<const ElementModQ>> &nonces,
+                        const ElementModP &publicKey)
+    {
+        if (messages.size() != nonces.size()) {
+            throw invalid_argument("elgamalEncryptBatch requires a nonce for each message");
+        }
+        for (const auto &nonce : nonces) {
+            if ((const_cast<ElementModQ &>(nonce.get()) == ZERO_MOD_Q())) {
+                throw invalid_argument("elgamalEncryptBatch encryption requires non-zero nonces");
+            }
+        }
+
+        vector<reference_wrapper<const ElementModP>> publicKeys(messages.size(), publicKey);
+        auto pubkeyPowers = pow_mod_p_batch(publicKeys, nonces);
+
+        vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+        ciphertexts.reserve(messages.size());
+        for (size_t i = 0; i < messages.size(); i++) {
+            auto pad = g_pow_p(nonces[i].get());
+            unique_ptr<ElementModP> data = nullptr;
+            if (messages[i] == 1) {
+                data = mul_mod_p(G(), *pubkeyPowers[i]);
+            } else {
+                data = move(pubkeyPowers[i]);
+            }
+            ciphertexts.push_back(make_unique<ElGamalCiphertext>(move(pad), move(data)));
+        }
+
+        Log::trace("Generated Batch Encryption");
+        return ciphertexts;
+    }
+
     unique_ptr<ElGamalCiphertext> elgamalEncrypt_with_precomputed(uint64_t m, ElementModP &g_to_rho,
                                                                   ElementModP &pubkey_to_rho)
     {
@@ -260,15 +345,15 @@ namespace electionguard
             throw invalid_argument("must have one or more ciphertexts");
         }
 
-        auto resultPad = ElementModP::fromUint64(1UL);
-        auto resultData = ElementModP::fromUint64(1UL);
+        // accumulate in montgomery form and only convert back once
+        MontElementModP resultPad;
+        MontElementModP resultData;
         for (auto ciphertext : ciphertexts) {
-            auto pad = mul_mod_p(*resultPad, *ciphertext.get().getPad());
-            resultPad.swap(pad);
-            auto data = mul_mod_p(*resultData, *ciphertext.get().getData());
-            resultData.swap(data);
+            resultPad.mul(*ciphertext.get().getPad());
+            resultData.mul(*ciphertext.get().getData());
         }
-        return make_unique<ElGamalCiphertext>(move(resultPad), move(resultData));
+        return make_unique<ElGamalCiphertext>(resultPad.toElementModP(),
+                                              resultData.toElementModP());
     }
 
 #pragma region HashedElGamalCiphertext
@@ -291,7 +376,7 @@ namespace electionguard
 
         [[nodiscard]] unique_ptr<ElementModQ> crypto_hash() const
         {
-            return hash_elems({pad.get(), data, mac});
+            return hash_elems(*pad, data, mac);
         }
 
         bool operator==(const Impl &other)
@@ -369,7 +454,7 @@ namespace electionguard
         auto publicKey_to_r = pow_mod_p(*pimpl->pad, secret_key);
 
         // hash g_to_r and publicKey_to_r to get the session key
-        auto session_key = hash_elems({pimpl->pad.get(), publicKey_to_r.get()});
+        auto session_key = hash_elems(*pimpl->pad, *publicKey_to_r);
 
         vector<uint8_t> mac_key = get_hmac(session_key->toBytes(), encryption_seed.toBytes(),
                                            number_of_blocks * HASHED_BLOCK_LENGTH_IN_BITS, 0);
@@ -512,13 +597,13 @@ namespace electionguard
             g_to_r = triple->get_g_to_exp();
             publicKey_to_r = triple->get_pubkey_to_exp();
         } else {
-            g_to_r = g_pow_p(nonce);
-
-            publicKey_to_r = pow_mod_p(publicKey, nonce);
+            auto powers = pow_mod_p_shared_exponent({G(), publicKey}, nonce);
+            g_to_r = move(powers[0]);
+            publicKey_to_r = move(powers[1]);
         }
 
         // hash g_to_r and publicKey_to_r to get the session key
-        auto session_key = hash_elems({g_to_r.get(), publicKey_to_r.get()});
+        auto session_key = hash_elems(*g_to_r, *publicKey_to_r);
 
         uint32_t plaintext_index = 0;
         for (uint32_t i = 0; i < number_of_blocks; i++) {
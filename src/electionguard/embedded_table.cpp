@@ -0,0 +1,9 @@
+#include "embedded_table.hpp"
+
+namespace electionguard
+{
+    // the library is built without EMBED_LOOKUP_TABLE,
+    // so the table of G is generated the first time it is used
+    const uint64_t *embedded_g_table() { return nullptr; }
+
+} // namespace electionguard
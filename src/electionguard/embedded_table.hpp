@@ -0,0 +1,26 @@
+#ifndef __ELECTIONGUARD_CPP_EMBEDDED_TABLE_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_EMBEDDED_TABLE_HPP_INCLUDED__
+
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The number of limbs in the embedded lookup table of the generator,
+    /// laid out like the values of a LookupTableType
+    /// </summary>
+    const uint64_t EMBEDDED_TABLE_LIMBS = LUT_TABLE_LENGTH * LUT_ORDER_BITS * MAX_P_LEN;
+
+    /// <summary>
+    /// The lookup table of G in montgomery form, generated when the library is built
+    /// and linked into its read-only data so that no table is generated at runtime.
+    ///
+    /// Returns nullptr when the library is built without the embedded table.
+    /// </summary>
+    EG_INTERNAL_API const uint64_t *embedded_g_table();
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_EMBEDDED_TABLE_HPP_INCLUDED__ */
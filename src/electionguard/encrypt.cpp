@@ -7,6 +7,7 @@
 #include "electionguard/hash.hpp"
 #include "electionguard/precompute_buffers.hpp"
 #include "log.hpp"
+#include "lookup_table.hpp"
 #include "nonces.hpp"
 #include "serialize.hpp"
 #include "utils.hpp"
@@ -124,6 +125,12 @@ namespace electionguard
                                    internalManifest.getManifestHash()->toHex() +
                                    " context:" + context.getManifestHash()->toHex());
         }
+
+        // the public key is a base of every encryption, so its lookup table is generated
+        // before the first ballot. contexts that never encrypt never generate it
+        auto &publicKey = *context.getElGamalPublicKey();
+        publicKey.setIsFixedBase(true);
+        LookupTableContext::getFixedTable(publicKey.cref());
     }
 
     EncryptionMediator::~EncryptionMediator() = default;
@@ -257,11 +264,41 @@ namespace electionguard
 
 #pragma region Encryption Functions
 
-    unique_ptr<CiphertextBallotSelection>
-    encryptSelection(const PlaintextBallotSelection &selection,
-                     const SelectionDescription &description, const ElementModP &elgamalPublicKey,
-                     const ElementModQ &cryptoExtendedBaseHash, const ElementModQ &nonceSeed,
-                     bool isPlaceholder /* = false */, bool shouldVerifyProofs /* = true */)
+    /// <summary>
+    /// The nonce of every selection, `Nonces(descriptionHash, nonceSeed).get(sequenceOrder)`,
+    /// with the hashes of all the selections finished together
+    /// </summary>
+    static vector<unique_ptr<ElementModQ>>
+    selectionNonces(const vector<reference_wrapper<SelectionDescription>> &descriptions,
+                    const vector<unique_ptr<ElementModQ>> &descriptionHashes,
+                    const ElementModQ &nonceSeed)
+    {
+        vector<vector<CryptoHashableType>> seedInputs;
+        seedInputs.reserve(descriptions.size());
+        for (const auto &descriptionHash : descriptionHashes) {
+            seedInputs.push_back({std::cref(*descriptionHash), std::cref(nonceSeed)});
+        }
+        auto seeds = hash_elems_batch(seedInputs);
+
+        vector<vector<CryptoHashableType>> nonceInputs;
+        nonceInputs.reserve(descriptions.size());
+        for (size_t i = 0; i < descriptions.size(); i++) {
+            nonceInputs.push_back({std::cref(*seeds[i]), descriptions[i].get().getSequenceOrder()});
+        }
+        return hash_elems_batch(nonceInputs);
+    }
+
+    /// <summary>
+    /// Encrypt the selection with the hash of its description and its nonce
+    /// </summary>
+    static unique_ptr<CiphertextBallotSelection>
+    encryptSelectionWithNonce(const PlaintextBallotSelection &selection,
+                              const SelectionDescription &description,
+                              const ElementModQ &descriptionHash,
+                              unique_ptr<ElementModQ> selectionNonce,
+                              const ElementModP &elgamalPublicKey,
+                              const ElementModQ &cryptoExtendedBaseHash, bool isPlaceholder,
+                              bool shouldVerifyProofs)
     {
         unique_ptr<CiphertextBallotSelection> encrypted = NULL;
         unique_ptr<ElGamalCiphertext> ciphertext;
@@ -273,14 +310,8 @@ namespace electionguard
             throw invalid_argument("malformed input selection " + selection.getObjectId());
         }
 
-        // Configure the crypto input values
-        auto descriptionHash = description.crypto_hash();
-        auto nonceSequence =
-          make_unique<Nonces>(*descriptionHash, &const_cast<ElementModQ &>(nonceSeed));
-        auto selectionNonce = nonceSequence->get(description.getSequenceOrder());
-
         Log::trace("encryptSelection: for " + description.getObjectId() + " hash: ",
-                   descriptionHash->toHex());
+                   descriptionHash.toHex());
 
         // this method runs off to look in the precomputed values buffer and if
         // it finds what it needs then the returned class will contain those values
@@ -304,7 +335,7 @@ namespace electionguard
             // was generated when precomputing and the public key was used in the
             // precomputation
             encrypted = CiphertextBallotSelection::make_with_precomputed(
-              selection.getObjectId(), description.getSequenceOrder(), *descriptionHash,
+              selection.getObjectId(), description.getSequenceOrder(), descriptionHash,
               move(ciphertext), cryptoExtendedBaseHash, selection.getVote(),
               move(precomputedTwoTriplesAndAQuad), isPlaceholder, true);
         } else {
@@ -315,7 +346,7 @@ namespace electionguard
             }
 
             encrypted = CiphertextBallotSelection::make(
-              selection.getObjectId(), description.getSequenceOrder(), *descriptionHash,
+              selection.getObjectId(), description.getSequenceOrder(), descriptionHash,
               move(ciphertext), elgamalPublicKey, cryptoExtendedBaseHash, selection.getVote(),
               isPlaceholder, true, move(selectionNonce));
         }
@@ -330,13 +361,31 @@ namespace electionguard
         }
 
         // verify the selection.
-        if (encrypted->isValidEncryption(*descriptionHash, elgamalPublicKey,
+        if (encrypted->isValidEncryption(descriptionHash, elgamalPublicKey,
                                          cryptoExtendedBaseHash)) {
             return encrypted;
         }
         throw runtime_error("encryptSelection failed validity check");
     }
 
+    unique_ptr<CiphertextBallotSelection>
+    encryptSelection(const PlaintextBallotSelection &selection,
+                     const SelectionDescription &description, const ElementModP &elgamalPublicKey,
+                     const ElementModQ &cryptoExtendedBaseHash, const ElementModQ &nonceSeed,
+                     bool isPlaceholder /* = false */, bool shouldVerifyProofs /* = true */)
+    {
+        // Configure the crypto input values
+        auto descriptionHash = description.crypto_hash();
+        auto nonceSequence =
+          make_unique<Nonces>(*descriptionHash, &const_cast<ElementModQ &>(nonceSeed));
+        auto selectionNonce = nonceSequence->get(description.getSequenceOrder());
+
+        return encryptSelectionWithNonce(selection, description, *descriptionHash,
+                                         move(selectionNonce), elgamalPublicKey,
+                                         cryptoExtendedBaseHash, isPlaceholder,
+                                         shouldVerifyProofs);
+    }
+
     string getOvervoteAndWriteIns(const PlaintextBallotContest &contest,
                                   const InternalManifest &internalManifest,
                                   eg_valid_contest_return_type_t is_overvote)
@@ -450,7 +499,21 @@ namespace electionguard
         // this allows consumers to only pass in the relevant selections made by a voter
         auto normalizedContest = emplaceMissingValues(contest, description);
         auto normalizedSelections = normalizedContest->getSelections();
-        for (const auto &selectionDescription : description.getSelections()) {
+
+        // the nonces of the selections and of the placeholders are derived together
+        auto selectionDescriptions = description.getSelections();
+        auto placeholders = description.getPlaceholders();
+        auto descriptions = selectionDescriptions;
+        descriptions.insert(descriptions.end(), placeholders.begin(), placeholders.end());
+        vector<unique_ptr<ElementModQ>> descriptionHashes;
+        descriptionHashes.reserve(descriptions.size());
+        for (const auto &selectionDescription : descriptions) {
+            descriptionHashes.push_back(selectionDescription.get().crypto_hash());
+        }
+        auto nonces = selectionNonces(descriptions, descriptionHashes, *sharedNonce);
+        size_t descriptionIndex = 0;
+
+        for (const auto &selectionDescription : selectionDescriptions) {
             auto description_id = selectionDescription.get().getObjectId();
             if (auto selection =
                   std::find_if(normalizedSelections.begin(), normalizedSelections.end(),
@@ -472,9 +535,11 @@ namespace electionguard
 
                 selectionCount += selection_ptr->getVote();
 
-                encryptedSelections.push_back(encryptSelection(
-                  *selection_ptr, selectionDescription.get(), *elgamalPublicKey_ptr,
-                  *cryptoExtendedBaseHash_ptr, *sharedNonce.get(), false, shouldVerifyProofs));
+                encryptedSelections.push_back(encryptSelectionWithNonce(
+                  *selection_ptr, selectionDescription.get(), *descriptionHashes[descriptionIndex],
+                  move(nonces[descriptionIndex]), *elgamalPublicKey_ptr,
+                  *cryptoExtendedBaseHash_ptr, false, shouldVerifyProofs));
+                descriptionIndex++;
             } else {
                 // Should never happen since the contest is normalized by emplaceMissingValues
                 throw runtime_error("encryptedContest:: Error constructing encrypted selection");
@@ -484,7 +549,7 @@ namespace electionguard
         // Handle Placeholder selections
         // After we loop through all of the real selections on the ballot,
         // we loop through each placeholder value and determine if it should be filled in
-        for (const auto &placeholder : description.getPlaceholders()) {
+        for (const auto &placeholder : placeholders) {
             bool selectPlaceholder = false;
             // if the is an overvote then we don't count any of the selections
             if (is_valid_contest == OVERVOTE) {
@@ -500,9 +565,11 @@ namespace electionguard
             }
 
             auto placeholderSelection = selectionFrom(placeholder, true, selectPlaceholder);
-            encryptedSelections.push_back(encryptSelection(
-              *placeholderSelection, placeholder, *elgamalPublicKey_ptr,
-              *cryptoExtendedBaseHash_ptr, *sharedNonce.get(), true, shouldVerifyProofs));
+            encryptedSelections.push_back(encryptSelectionWithNonce(
+              *placeholderSelection, placeholder, *descriptionHashes[descriptionIndex],
+              move(nonces[descriptionIndex]), *elgamalPublicKey_ptr, *cryptoExtendedBaseHash_ptr,
+              true, shouldVerifyProofs));
+            descriptionIndex++;
         }
 
         // Derive the extendedDataNonce from the selection nonce and a constant
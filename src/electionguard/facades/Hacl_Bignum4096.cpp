@@ -6,6 +6,9 @@
 #endif // _WIN32
 #include "../../karamel/Hacl_GenericField64.h"
 #include "../log.hpp"
+#include "../montgomery_kernels.hpp"
+
+#include <electionguard/constants.h>
 
 using electionguard::Log;
 
@@ -22,6 +25,16 @@ namespace hacl
     {
         HaclBignumContext4096 ctx{Hacl_Bignum4096_mont_ctx_init(elem)};
         context = std::move(ctx);
+
+        // (2^4160 mod n)^2 mod n
+        uint64_t wide[MAX_P_LEN_DOUBLE] = {};
+        wide[MAX_P_LEN + 1] = 1;
+        uint64_t reduced[MAX_P_LEN] = {};
+        Hacl_Bignum4096_mod(elem, static_cast<uint64_t *>(wide), static_cast<uint64_t *>(reduced));
+        Hacl_Bignum4096_mul(static_cast<uint64_t *>(reduced), static_cast<uint64_t *>(reduced),
+                            static_cast<uint64_t *>(wide));
+        lanesConversion.resize(MAX_P_LEN);
+        Hacl_Bignum4096_mod(elem, static_cast<uint64_t *>(wide), lanesConversion.data());
     }
 #endif // _WIN32
     Bignum4096::~Bignum4096() {}
@@ -150,6 +163,24 @@ namespace hacl
 #endif // _WIN32
     }
 
+    void Bignum4096::modExpQ(uint64_t *a, uint64_t *b, uint64_t *res,
+                             bool useConstTime /* = false */) const
+    {
+        const uint32_t exponentBits = MAX_Q_SIZE * 8U;
+        modExp(a, exponentBits, b, res, useConstTime);
+    }
+
+    void Bignum4096::modInvPrime(uint64_t *a, uint64_t *res) const
+    {
+#ifdef _WIN32
+        Hacl_Bignum4096_32_mod_inv_prime_vartime_precomp(context.get(),
+                                                         reinterpret_cast<uint32_t *>(a),
+                                                         reinterpret_cast<uint32_t *>(res));
+#else
+        Hacl_Bignum4096_mod_inv_prime_vartime_precomp(context.get(), a, res);
+#endif // _WIN32
+    }
+
     void Bignum4096::to_montgomery_form(uint64_t *a, uint64_t *aM) const
     {
 #ifdef _WIN32
@@ -176,7 +207,45 @@ namespace hacl
         Hacl_GenericField32_mul(context.get(), reinterpret_cast<uint32_t *>(aM),
                                 reinterpret_cast<uint32_t *>(bM), reinterpret_cast<uint32_t *>(cM));
 #else
-        Hacl_GenericField64_mul(context.get(), aM, bM, cM);
+        if (!electionguard::montgomery_mul_4096(context->n, context->mu, aM, bM, cM)) {
+            Hacl_GenericField64_mul(context.get(), aM, bM, cM);
+        }
+#endif // _WIN32
+    }
+
+    void Bignum4096::montgomery_mod_sqr_stay_in_mont_form(uint64_t *aM, uint64_t *cM) const
+    {
+#ifdef _WIN32
+        Hacl_GenericField32_sqr(context.get(), reinterpret_cast<uint32_t *>(aM),
+                                reinterpret_cast<uint32_t *>(cM));
+#else
+        if (!electionguard::montgomery_mul_4096(context->n, context->mu, aM, aM, cM)) {
+            Hacl_GenericField64_sqr(context.get(), aM, cM);
+        }
+#endif // _WIN32
+    }
+
+    void Bignum4096::montgomery_one(uint64_t *oneM) const
+    {
+#ifdef _WIN32
+        Hacl_GenericField32_one(context.get(), reinterpret_cast<uint32_t *>(oneM));
+#else
+        Hacl_GenericField64_one(context.get(), oneM);
+#endif // _WIN32
+    }
+
+    bool Bignum4096::modExpQLanes(uint32_t count, const uint64_t *const *a,
+                                  const uint64_t *const *b, uint64_t *const *res) const
+    {
+#ifdef _WIN32
+        return false;
+#else
+        if (!electionguard::canUseMontgomeryLanes()) {
+            return false;
+        }
+        electionguard::pow_mod_4096_lanes_ifma(context->n, context->mu, lanesConversion.data(),
+                                               count, a, b, res);
+        return true;
 #endif // _WIN32
     }
 
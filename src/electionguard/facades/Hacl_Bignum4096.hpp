@@ -9,6 +9,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 namespace hacl
 {
@@ -61,6 +62,23 @@ namespace hacl
         void modExp(uint64_t *a, uint32_t bBits, uint64_t *b, uint64_t *res,
                     bool useConstTime = false) const;
 
+        /// <summary>
+        /// Write `a ^ b mod n` in `res` where b is a 256-bit exponent, i.e. uint64_t[4].
+        ///
+        /// The exponent limbs are handed to hacl directly with a 256-bit bound
+        /// so only the significant bits of an ElementModQ are processed,
+        /// rather than widening the exponent to a 4096-bit bignum.
+        /// </summary>
+        void modExpQ(uint64_t *a, uint64_t *b, uint64_t *res, bool useConstTime = false) const;
+
+        /// <summary>
+        /// Write `a ^ -1 mod n` in `res` for a prime n and 0 &lt; a &lt; n.
+        ///
+        /// The inverse is computed as a ^ (n - 2), the exponent is public
+        /// so the exponentiation runs in variable time.
+        /// </summary>
+        void modInvPrime(uint64_t *a, uint64_t *res) const;
+
         void to_montgomery_form(uint64_t *a, uint64_t *aM) const;
 
         void from_montgomery_form(uint64_t *aM, uint64_t *a) const;
@@ -68,6 +86,22 @@ namespace hacl
         void montgomery_mod_mul_stay_in_mont_form(uint64_t *aM, uint64_t *bM,
                                                          uint64_t *cM) const;
 
+        void montgomery_mod_sqr_stay_in_mont_form(uint64_t *aM, uint64_t *cM) const;
+
+        /// <summary>
+        /// Write the multiplicative identity in montgomery form in `oneM`
+        /// </summary>
+        void montgomery_one(uint64_t *oneM) const;
+
+        /// <summary>
+        /// Write `a[i] ^ b[i] mod n` in `res[i]` for up to MONTGOMERY_LANES independent
+        /// exponentiations with 256-bit exponents, interleaved across vector lanes.
+        /// Returns false without writing anything when no lane kernel is available,
+        /// in which case the caller evaluates them one at a time.
+        /// </summary>
+        bool modExpQLanes(uint32_t count, const uint64_t *const *a, const uint64_t *const *b,
+                          uint64_t *const *res) const;
+
       private:
         struct handle_destructor {
 #ifdef _WIN32
@@ -90,6 +124,10 @@ namespace hacl
           HaclBignumContext4096;
 #endif // _WIN32
         HaclBignumContext4096 context;
+#ifndef _WIN32
+        // 2^8320 mod n, which converts into the lane kernel's montgomery form
+        std::vector<uint64_t> lanesConversion;
+#endif // _WIN32
     };
 
     /// <summary>
@@ -4,15 +4,23 @@
 #include "../karamel/Lib_Memzero0.h"
 #include "../karamel/Lib_RandomBuffer_System.h"
 #include "convert.hpp"
+#include "discrete_log.hpp"
 #include "facades/Hacl_Bignum256.hpp"
 #include "facades/Hacl_Bignum4096.hpp"
 #include "log.hpp"
 #include "lookup_table.hpp"
+#include "mont_element.hpp"
+#include "montgomery_kernels.hpp"
+#include "q_field.hpp"
 #include "random.hpp"
+#include "residue_cache.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <random>
@@ -24,15 +32,20 @@ using hacl::Bignum256;
 using hacl::Bignum4096;
 using hacl::CONTEXT_P;
 using hacl::CONTEXT_Q;
+using std::atomic;
 using std::copy;
+using std::fill;
+using std::future;
 using std::get;
 using std::holds_alternative;
 using std::invalid_argument;
 using std::make_unique;
+using std::min;
 using std::out_of_range;
 using std::overflow_error;
 using std::reference_wrapper;
 using std::runtime_error;
+using std::shared_ptr;
 using std::to_string;
 using std::unique_ptr;
 
@@ -106,75 +119,46 @@ namespace electionguard
 
 #pragma region ElementModP
 
-    struct ElementModP::Impl {
-
-        bool isFixedBase = false;
-        uint64_t data[MAX_P_LEN] = {};
-        string hexRepresentation;
-
-        Impl(const vector<uint64_t> &elem, bool unchecked, bool fixedBase)
-        {
-            uint64_t array[MAX_P_LEN] = {};
-            copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
-            if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
-                                                   static_cast<uint64_t *>(array)) > 0) {
-                throw out_of_range("Value for ElementModP is greater than allowed");
-            }
-            isFixedBase = fixedBase;
-            copy(begin(array), end(array), begin(data));
-        };
-
-        Impl(const uint64_t (&elem)[MAX_P_LEN], bool unchecked, bool fixedBase)
-        {
-            if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().get()),
-                                                   const_cast<uint64_t *>(elem)) > 0) {
-                throw out_of_range("Value for ElementModP is greater than allowed");
-            }
-            isFixedBase = fixedBase;
-            copy(begin(elem), end(elem), begin(data));
-        };
-
-        ~Impl() { Lib_Memzero0_memzero(static_cast<uint64_t *>(data), MAX_P_LEN); };
-
-        [[nodiscard]] unique_ptr<ElementModP::Impl> clone() const
-        {
-            return make_unique<ElementModP::Impl>(data, true, isFixedBase);
+    static void checkBoundsModP(const uint64_t (&elem)[MAX_P_LEN], bool unchecked)
+    {
+        if (!unchecked && Bignum4096::lessThan(const_cast<uint64_t *>(P().data()),
+                                               const_cast<uint64_t *>(elem)) > 0) {
+            throw out_of_range("Value for ElementModP is greater than allowed");
         }
+    }
 
-        bool operator==(const Impl &other)
-        {
-            for (uint8_t i = 0; i < MAX_P_LEN; i++) {
-                auto l = data[i];
-                auto r = other.data[i];
-                if (l != r) {
-                    return false;
-                }
-            }
-            return true;
-        }
+    // Lifecycle Methods
 
-        bool operator<(const Impl &other)
-        {
-            auto other_ = other;
-            return Bignum4096::lessThan(static_cast<uint64_t *>(data),
-                                        static_cast<uint64_t *>(other_.data)) > 0;
-        }
-    };
+    ElementModP::ElementModP() {}
 
-    // Lifecycle Methods
+    ElementModP::ElementModP(const ElementModP &other)
+        : value(other.value), fixedBase(other.fixedBase),
+          validatedResidue(other.validatedResidue.load())
+    {
+    }
 
-    ElementModP::ElementModP(const ElementModP &other) : pimpl(other.pimpl->clone()) {}
+    ElementModP::ElementModP(ElementModP &&other)
+        : ElementModP(static_cast<const ElementModP &>(other))
+    {
+    }
 
     ElementModP::ElementModP(const vector<uint64_t> &elem, bool unchecked /* = false */,
                              bool fixedBase /* = false */)
-        : pimpl(new Impl(elem, unchecked, fixedBase))
+        : fixedBase(fixedBase)
     {
+        uint64_t array[MAX_P_LEN] = {};
+        copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
+        checkBoundsModP(array, unchecked);
+        copy(begin(array), end(array), begin(value.data));
+        Lib_Memzero0_memzero(static_cast<uint64_t *>(array), MAX_P_LEN);
     }
 
     ElementModP::ElementModP(const uint64_t (&elem)[MAX_P_LEN], bool unchecked /* = false */,
                              bool fixedBase /* = false */)
-        : pimpl(new Impl(elem, unchecked, fixedBase))
+        : fixedBase(fixedBase)
     {
+        checkBoundsModP(elem, unchecked);
+        copy(begin(elem), end(elem), begin(value.data));
     }
 
     ElementModP::~ElementModP() = default;
@@ -183,25 +167,57 @@ namespace electionguard
 
     ElementModP &ElementModP::operator=(ElementModP other)
     {
-        swap(pimpl, other.pimpl);
+        value = other.value;
+        fixedBase = other.fixedBase;
+        validatedResidue = other.validatedResidue.load();
         return *this;
     }
 
-    bool ElementModP::operator==(const ElementModP &other) { return *pimpl == *other.pimpl; }
+    ElementModP &ElementModP::operator=(ElementModP &&other)
+    {
+        return *this = static_cast<const ElementModP &>(other);
+    }
+
+    bool ElementModP::operator==(const ElementModP &other) { return value == other.value; }
 
     bool ElementModP::operator!=(const ElementModP &other) { return !(*this == other); }
 
-    bool ElementModP::operator<(const ElementModP &other) { return *pimpl < *other.pimpl; }
+    bool ElementModP::operator<(const ElementModP &other)
+    {
+        return Bignum4096::lessThan(static_cast<uint64_t *>(value.data),
+                                    const_cast<uint64_t *>(other.value.data)) > 0;
+    }
 
     // Property Getters
 
-    uint64_t *ElementModP::get() const { return static_cast<uint64_t *>(pimpl->data); }
+    // the limbs may be written through the returned pointer, so the residue proof is dropped.
+    // it is only stored when set so that shared constants are never written by their readers
+    static void invalidateResidue(std::atomic<bool> &validated)
+    {
+        if (validated.load(std::memory_order_relaxed)) {
+            validated.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t *ElementModP::get() const
+    {
+        invalidateResidue(validatedResidue);
+        return const_cast<uint64_t *>(value.data);
+    }
+
+    uint64_t (&ElementModP::ref() const)[MAX_P_LEN]
+    {
+        invalidateResidue(validatedResidue);
+        return const_cast<uint64_t(&)[MAX_P_LEN]>(value.data);
+    }
+
+    const uint64_t *ElementModP::data() const { return static_cast<const uint64_t *>(value.data); }
 
-    uint64_t (&ElementModP::ref() const)[MAX_P_LEN] { return pimpl->data; }
+    const uint64_t (&ElementModP::cref() const)[MAX_P_LEN] { return value.data; }
 
     uint64_t ElementModP::length() const { return MAX_P_LEN; }
 
-    bool ElementModP::isFixedBase() const { return pimpl->isFixedBase; }
+    bool ElementModP::isFixedBase() const { return fixedBase; }
 
     bool ElementModP::isInBounds() const
     {
@@ -210,40 +226,47 @@ namespace electionguard
     }
     bool ElementModP::isValidResidue() const
     {
-        auto residue = (*pow_mod_p(*this, Q()) == const_cast<ElementModP &>(ONE_MOD_P()));
-        return this->isInBounds() && residue;
+        // an element only needs to be proven once for as long as its value is unchanged
+        if (validatedResidue.load()) {
+            return true;
+        }
+        auto digest = limbDigest(value.data);
+        if (ResidueCache::contains(value.data, digest)) {
+            validatedResidue = true;
+            return true;
+        }
+
+        // the element is public, so the exponentiation need not be constant time
+        ElementModP residue;
+        pow_mod_p(*this, Q(), residue, ExponentiationPolicy::variableTime);
+        auto valid = this->isInBounds() && residue == const_cast<ElementModP &>(ONE_MOD_P());
+        if (valid) {
+            validatedResidue = true;
+            ResidueCache::insert(value.data, digest);
+        }
+        return valid;
     }
 
     vector<uint8_t> ElementModP::toBytes() const
     {
         uint8_t byteResult[MAX_P_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum4096::toBytes(static_cast<uint64_t *>(pimpl->data),
-                            static_cast<uint8_t *>(byteResult));
+        Bignum4096::toBytes(const_cast<uint64_t *>(value.data), static_cast<uint8_t *>(byteResult));
         return vector<uint8_t>(begin(byteResult), end(byteResult));
     }
 
     string ElementModP::toHex() const
     {
-        if (!pimpl->hexRepresentation.empty()) {
-            return pimpl->hexRepresentation;
-        }
-
         // Returned bytes array from Hacl needs to be pre-allocated to 512 bytes
         uint8_t byteResult[MAX_P_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum4096::toBytes(static_cast<uint64_t *>(pimpl->data),
-                            static_cast<uint8_t *>(byteResult));
-        pimpl->hexRepresentation = bytes_to_hex(byteResult);
-        return pimpl->hexRepresentation;
+        Bignum4096::toBytes(const_cast<uint64_t *>(value.data), static_cast<uint8_t *>(byteResult));
+        return bytes_to_hex(byteResult);
     }
 
-    std::unique_ptr<ElementModP> ElementModP::clone() const
-    {
-        return make_unique<ElementModP>(pimpl->data, true, pimpl->isFixedBase);
-    }
+    std::unique_ptr<ElementModP> ElementModP::clone() const { return make_unique<ElementModP>(*this); }
 
-    void ElementModP::setIsFixedBase(bool fixedBase) const { pimpl->isFixedBase = fixedBase; }
+    void ElementModP::setIsFixedBase(bool fixedBase) const { this->fixedBase = fixedBase; }
 
     // Static Methods
 
@@ -269,91 +292,71 @@ namespace electionguard
 
 #pragma region ElementModQ
 
-    struct ElementModQ::Impl {
-
-        uint64_t data[MAX_Q_LEN] = {};
-
-        Impl(const vector<uint64_t> &elem, bool unchecked)
-        {
-            uint64_t array[MAX_Q_LEN] = {};
-            copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
-            if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
-                                                  static_cast<uint64_t *>(array)) > 0) {
-                throw out_of_range("Value for ElementModQ is greater than allowed");
-            }
-            copy(begin(array), end(array), begin(data));
-        };
-
-        Impl(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked)
-        {
-            if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
-                                                  const_cast<uint64_t *>(elem)) > 0) {
-                throw out_of_range("Value for ElementModQ is greater than allowed");
-            }
-            copy(begin(elem), end(elem), begin(data));
-        };
-
-        ~Impl() { Lib_Memzero0_memzero(static_cast<uint64_t *>(data), MAX_Q_LEN); };
-
-        [[nodiscard]] unique_ptr<ElementModQ::Impl> clone() const
-        {
-            return make_unique<ElementModQ::Impl>(data, true);
+    static void checkBoundsModQ(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked)
+    {
+        if (!unchecked && Bignum256::lessThan(const_cast<uint64_t *>(Q().get()),
+                                              const_cast<uint64_t *>(elem)) > 0) {
+            throw out_of_range("Value for ElementModQ is greater than allowed");
         }
+    }
 
-        bool operator==(const Impl &other)
-        {
-            for (uint8_t i = 0; i < MAX_Q_LEN; i++) {
-                auto l = data[i];
-                auto r = other.data[i];
-                if (l != r) {
-                    return false;
-                }
-            }
-            return true;
-        }
+    // Lifecycle Methods
 
-        bool operator<(const Impl &other)
-        {
-            auto other_ = other;
-            return Bignum256::lessThan(static_cast<uint64_t *>(data),
-                                       static_cast<uint64_t *>(other_.data)) > 0;
-        }
-    };
+    ElementModQ::ElementModQ() {}
 
-    // Lifecycle Methods
+    ElementModQ::ElementModQ(const ElementModQ &other) : value(other.value) {}
 
-    ElementModQ::ElementModQ(const ElementModQ &other) : pimpl(other.pimpl->clone()) {}
+    ElementModQ::ElementModQ(ElementModQ &&other) : value(other.value) {}
 
     ElementModQ::ElementModQ(const vector<uint64_t> &elem, bool unchecked /* = false */)
-        : pimpl(new Impl(elem, unchecked))
     {
+        uint64_t array[MAX_Q_LEN] = {};
+        copy(elem.begin(), elem.end(), static_cast<uint64_t *>(array));
+        checkBoundsModQ(array, unchecked);
+        copy(begin(array), end(array), begin(value.data));
+        Lib_Memzero0_memzero(static_cast<uint64_t *>(array), MAX_Q_LEN);
     }
 
     ElementModQ::ElementModQ(const uint64_t (&elem)[MAX_Q_LEN], bool unchecked /* = false*/)
-        : pimpl(new Impl(elem, unchecked))
     {
+        checkBoundsModQ(elem, unchecked);
+        copy(begin(elem), end(elem), begin(value.data));
     }
+
     ElementModQ::~ElementModQ() = default;
 
     // Operator Overloads
 
     ElementModQ &ElementModQ::operator=(ElementModQ other)
     {
-        swap(pimpl, other.pimpl);
+        value = other.value;
         return *this;
     }
 
-    bool ElementModQ::operator==(const ElementModQ &other) { return *pimpl == *other.pimpl; }
+    ElementModQ &ElementModQ::operator=(ElementModQ &&other)
+    {
+        value = other.value;
+        return *this;
+    }
+
+    bool ElementModQ::operator==(const ElementModQ &other) { return value == other.value; }
 
     bool ElementModQ::operator!=(const ElementModQ &other) { return !(*this == other); }
 
-    bool ElementModQ::operator<(const ElementModQ &other) { return *pimpl < *other.pimpl; }
+    bool ElementModQ::operator<(const ElementModQ &other)
+    {
+        return Bignum256::lessThan(static_cast<uint64_t *>(value.data),
+                                   const_cast<uint64_t *>(other.value.data)) > 0;
+    }
 
     // Property Getters
 
-    uint64_t *ElementModQ::get() const { return static_cast<uint64_t *>(pimpl->data); }
+    uint64_t *ElementModQ::get() const { return const_cast<uint64_t *>(value.data); }
 
-    uint64_t (&ElementModQ::ref() const)[MAX_Q_LEN] { return pimpl->data; }
+    uint64_t (&ElementModQ::ref() const)[MAX_Q_LEN]
+    {
+        return const_cast<uint64_t(&)[MAX_Q_LEN]>(value.data);
+    }
 
     uint64_t ElementModQ::length() const { return MAX_Q_LEN; }
 
@@ -367,8 +370,7 @@ namespace electionguard
     {
         uint8_t byteResult[MAX_Q_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum256::toBytes(static_cast<uint64_t *>(pimpl->data),
-                           static_cast<uint8_t *>(byteResult));
+        Bignum256::toBytes(get(), static_cast<uint8_t *>(byteResult));
         return vector<uint8_t>(begin(byteResult), end(byteResult));
     }
 
@@ -377,8 +379,7 @@ namespace electionguard
         // Returned bytes array from Hacl needs to be pre-allocated to 32 bytes
         uint8_t byteResult[MAX_Q_SIZE] = {};
         // Use Hacl to convert the bignum to byte array
-        Bignum256::toBytes(static_cast<uint64_t *>(pimpl->data),
-                           static_cast<uint8_t *>(byteResult));
+        Bignum256::toBytes(get(), static_cast<uint8_t *>(byteResult));
         return bytes_to_hex(byteResult);
     }
 
@@ -407,14 +408,11 @@ namespace electionguard
     unique_ptr<ElementModP> ElementModQ::toElementModP() const
     {
         uint64_t p4096[MAX_P_LEN] = {};
-        memcpy(static_cast<uint64_t *>(p4096), static_cast<uint64_t *>(pimpl->data), MAX_Q_SIZE);
+        memcpy(static_cast<uint64_t *>(p4096), get(), MAX_Q_SIZE);
         return make_unique<ElementModP>(p4096, true);
     }
 
-    std::unique_ptr<ElementModQ> ElementModQ::clone() const
-    {
-        return make_unique<ElementModQ>(pimpl->data);
-    }
+    std::unique_ptr<ElementModQ> ElementModQ::clone() const { return make_unique<ElementModQ>(*this); }
 
 #pragma endregion
 
@@ -504,13 +502,32 @@ namespace electionguard
 
 #pragma region ElementModP Global Functions
 
+    static void assign(ElementModP &result, const uint64_t (&limbs)[MAX_P_LEN])
+    {
+        // get() drops the residue proof of the previous value
+        copy(begin(limbs), end(limbs), result.get());
+        result.setIsFixedBase(false);
+    }
+
+    static void assign(ElementModQ &result, const uint64_t (&limbs)[MAX_Q_LEN])
+    {
+        copy(begin(limbs), end(limbs), result.get());
+    }
+
     unique_ptr<ElementModP> add_mod_p(const ElementModP &lhs, const ElementModP &rhs)
+    {
+        auto result = make_unique<ElementModP>();
+        add_mod_p(lhs, rhs, *result);
+        return result;
+    }
+
+    void add_mod_p(const ElementModP &lhs, const ElementModP &rhs, ElementModP &result)
     {
         const auto &p = P();
         uint64_t addResult[MAX_P_LEN_DOUBLE] = {};
         uint64_t carry =
-          Bignum4096::add(const_cast<ElementModP &>(lhs).get(),
-                          const_cast<ElementModP &>(rhs).get(), static_cast<uint64_t *>(addResult));
+          Bignum4096::add(const_cast<uint64_t *>(lhs.data()), const_cast<uint64_t *>(rhs.data()),
+                          static_cast<uint64_t *>(addResult));
 
         // handle the specific case where the the sum == MAX_4096
         // but the carry value is not set.  We still need to offset.
@@ -554,77 +571,309 @@ namespace electionguard
 
         uint64_t modResult[MAX_P_LEN] = {};
         CONTEXT_P().mod(static_cast<uint64_t *>(addResult), static_cast<uint64_t *>(modResult));
-        return make_unique<ElementModP>(modResult, true);
+        assign(result, modResult);
     }
 
     std::unique_ptr<ElementModP> mod_p(const ElementModP &element)
     {
         uint64_t modResult[MAX_P_LEN] = {};
-        CONTEXT_P().mod(element.get(), static_cast<uint64_t *>(modResult));
+        CONTEXT_P().mod(const_cast<uint64_t *>(element.data()), static_cast<uint64_t *>(modResult));
         return make_unique<ElementModP>(modResult, true);
     }
 
     unique_ptr<ElementModP> mul_mod_p(const ElementModP &lhs, const ElementModP &rhs)
     {
-        const auto &p = P();
+        auto result = make_unique<ElementModP>();
+        mul_mod_p(lhs, rhs, *result);
+        return result;
+    }
+
+    void mul_mod_p(const ElementModP &lhs, const ElementModP &rhs, ElementModP &result)
+    {
         uint64_t mulResult[MAX_P_LEN_DOUBLE] = {};
-        Bignum4096::mul(const_cast<ElementModP &>(lhs).get(), const_cast<ElementModP &>(rhs).get(),
+        Bignum4096::mul(const_cast<uint64_t *>(lhs.data()), const_cast<uint64_t *>(rhs.data()),
                         static_cast<uint64_t *>(mulResult));
         uint64_t modResult[MAX_P_LEN] = {};
         CONTEXT_P().mod(static_cast<uint64_t *>(mulResult), static_cast<uint64_t *>(modResult));
-        return make_unique<ElementModP>(modResult, true);
+        assign(result, modResult);
     }
 
     unique_ptr<ElementModP> mul_mod_p(const vector<ElementModPOrQ> &elems)
     {
-        auto product = ElementModP::fromUint64(1UL);
+        MontElementModP product;
         for (auto x : elems) {
             if (holds_alternative<ElementModQ *>(x)) {
-                auto elem = get<ElementModQ *>(x)->toElementModP();
-                auto res = mul_mod_p(*product, *elem);
-                product.swap(res);
+                uint64_t elem[MAX_P_LEN] = {};
+                copy(get<ElementModQ *>(x)->get(), get<ElementModQ *>(x)->get() + MAX_Q_LEN, elem);
+                product.mul(ElementModP(elem, true));
             } else if (holds_alternative<ElementModP *>(x)) {
-                auto *elem = get<ElementModP *>(x);
-                auto res = mul_mod_p(*product, *elem);
-                product.swap(res);
+                product.mul(*get<ElementModP *>(x));
             } else {
                 throw "invalid type";
             }
         }
-        return make_unique<ElementModP>(*product);
+        return product.toElementModP();
+    }
+
+    /// <summary>
+    /// window width in bits of the constant time exponentiation
+    /// </summary>
+    const uint32_t CONSTANT_TIME_WINDOW_BITS = 4U;
+
+    /// <summary>
+    /// window width in bits of the variable time exponentiation
+    /// </summary>
+    const uint32_t SLIDING_WINDOW_BITS = 5U;
+
+    static atomic<uint64_t> constantTimeExponentiations{0};
+    static atomic<uint64_t> variableTimeExponentiations{0};
+    static atomic<uint64_t> lookupTableExponentiations{0};
+    static atomic<uint64_t> maskedLookupTableExponentiations{0};
+    static atomic<ConstantTimeImplementation> constantTimeImplementation{
+      ConstantTimeImplementation::verified};
+
+    static void countExponentiation(ExponentiationPolicy policy)
+    {
+        if (policy == ExponentiationPolicy::variableTime) {
+            variableTimeExponentiations.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            constantTimeExponentiations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /// <summary>
+    /// count an exponentiation served by a lookup table, which is read
+    /// under masks unless the policy is variable time
+    /// </summary>
+    static void countLookupTable(ExponentiationPolicy policy, uint64_t count = 1)
+    {
+        if (policy == ExponentiationPolicy::variableTime) {
+            lookupTableExponentiations.fetch_add(count, std::memory_order_relaxed);
+        } else {
+            maskedLookupTableExponentiations.fetch_add(count, std::memory_order_relaxed);
+        }
+    }
+
+    ExponentiationStatistics get_exponentiation_statistics()
+    {
+        ExponentiationStatistics statistics;
+        statistics.constantTime = constantTimeExponentiations.load();
+        statistics.variableTime = variableTimeExponentiations.load();
+        statistics.lookupTable = lookupTableExponentiations.load();
+        statistics.maskedLookupTable = maskedLookupTableExponentiations.load();
+        return statistics;
+    }
+
+    void set_residue_cache_capacity(uint64_t capacity)
+    {
+        ResidueCache::setCapacity(static_cast<size_t>(capacity));
+    }
+
+    void set_constant_time_implementation(ConstantTimeImplementation implementation)
+    {
+        constantTimeImplementation.store(implementation);
+    }
+
+    ConstantTimeImplementation get_constant_time_implementation()
+    {
+        return constantTimeImplementation.load();
+    }
+
+    /// <summary>
+    /// whether the exponentiations of the policy run on the kernels and lookup tables
+    /// of this library, rather than the verified implementation of HACL*
+    /// </summary>
+    static bool usesLibraryKernels(ExponentiationPolicy policy)
+    {
+        return policy == ExponentiationPolicy::variableTime ||
+               get_constant_time_implementation() == ConstantTimeImplementation::maskedWindow;
+    }
+
+    /// <summary>
+    /// Compute base^exponent mod p with a fixed window. Every window costs the same
+    /// squarings and multiplication and each entry is copied out of the table under
+    /// a mask, so neither the branches nor the memory accesses depend on the exponent.
+    /// Unlike the HACL* ladder this is not verified, so it only runs once the masked
+    /// window implementation is chosen.
+    /// </summary>
+    static void constant_time_pow_mod_p(const uint64_t *base, const uint64_t *exponent,
+                                        uint32_t exponentBits, uint64_t *power)
+    {
+        const auto &context = CONTEXT_P();
+        const uint32_t entries = 1U << CONSTANT_TIME_WINDOW_BITS;
+        uint64_t table[entries][MAX_P_LEN];
+        context.montgomery_one(table[0]);
+        context.to_montgomery_form(const_cast<uint64_t *>(base), table[1]);
+        for (uint32_t e = 2; e < entries; e++) {
+            context.montgomery_mod_mul_stay_in_mont_form(table[e - 1], table[1], table[e]);
+        }
+
+        uint64_t entry[MAX_P_LEN] = {};
+        auto select = [&](uint32_t offset) {
+            uint64_t index = (exponent[offset / 64] >> (offset % 64)) & (entries - 1);
+            fill(entry, entry + MAX_P_LEN, 0);
+            for (uint64_t e = 0; e < entries; e++) {
+                uint64_t difference = e ^ index;
+                uint64_t mask = ((difference | (0 - difference)) >> 63) - 1;
+                for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+                    entry[i] |= table[e][i] & mask;
+                }
+            }
+        };
+
+        uint64_t accumulator[MAX_P_LEN] = {};
+        auto offset = exponentBits - CONSTANT_TIME_WINDOW_BITS;
+        select(offset);
+        copy(entry, entry + MAX_P_LEN, accumulator);
+        while (offset > 0) {
+            offset -= CONSTANT_TIME_WINDOW_BITS;
+            for (uint32_t j = 0; j < CONSTANT_TIME_WINDOW_BITS; j++) {
+                context.montgomery_mod_sqr_stay_in_mont_form(accumulator, accumulator);
+            }
+            select(offset);
+            context.montgomery_mod_mul_stay_in_mont_form(accumulator, entry, accumulator);
+        }
+        context.from_montgomery_form(accumulator, power);
+    }
+
+    /// <summary>
+    /// Compute base^exponent mod p with a sliding window over the odd powers of the base.
+    /// Runs of zero bits cost a squaring each and are skipped without a multiplication,
+    /// so the timing depends on the exponent, which therefore must be public.
+    /// </summary>
+    static void variable_time_pow_mod_p(const uint64_t *base, const uint64_t *exponent,
+                                        uint32_t exponentBits, uint64_t *power)
+    {
+        const auto &context = CONTEXT_P();
+        auto bit = [&](uint32_t i) { return (exponent[i / 64] >> (i % 64)) & 1; };
+
+        // base, base^3, ..., base^(2^w - 1)
+        const uint32_t entries = 1U << (SLIDING_WINDOW_BITS - 1);
+        uint64_t table[entries][MAX_P_LEN];
+        uint64_t squared[MAX_P_LEN];
+        context.to_montgomery_form(const_cast<uint64_t *>(base), table[0]);
+        context.montgomery_mod_sqr_stay_in_mont_form(table[0], squared);
+        for (uint32_t e = 1; e < entries; e++) {
+            context.montgomery_mod_mul_stay_in_mont_form(table[e - 1], squared, table[e]);
+        }
+
+        uint64_t accumulator[MAX_P_LEN] = {};
+        bool started = false;
+        int64_t i = static_cast<int64_t>(exponentBits) - 1;
+        while (i >= 0) {
+            if (bit(i) == 0) {
+                if (started) {
+                    context.montgomery_mod_sqr_stay_in_mont_form(accumulator, accumulator);
+                }
+                i--;
+                continue;
+            }
+
+            // the longest window starting at bit i that ends in a set bit
+            int64_t j = std::max<int64_t>(i - SLIDING_WINDOW_BITS + 1, 0);
+            while (bit(j) == 0) {
+                j++;
+            }
+            uint64_t window = 0;
+            for (int64_t k = i; k >= j; k--) {
+                window = (window << 1) | bit(k);
+            }
+
+            if (started) {
+                for (int64_t k = i; k >= j; k--) {
+                    context.montgomery_mod_sqr_stay_in_mont_form(accumulator, accumulator);
+                }
+                context.montgomery_mod_mul_stay_in_mont_form(accumulator, table[window >> 1],
+                                                             accumulator);
+            } else {
+                copy(table[window >> 1], table[window >> 1] + MAX_P_LEN, accumulator);
+                started = true;
+            }
+            i = j - 1;
+        }
+
+        if (!started) {
+            context.montgomery_one(accumulator);
+        }
+        context.from_montgomery_form(accumulator, power);
+    }
+
+    /// <summary>
+    /// Compute base^exponent mod p directly, following the policy
+    /// </summary>
+    static void pow_mod_p_with_policy(const uint64_t *base, const uint64_t *exponent,
+                                      uint32_t exponentBits, uint64_t *power,
+                                      ExponentiationPolicy policy)
+    {
+        if (policy == ExponentiationPolicy::variableTime) {
+            variable_time_pow_mod_p(base, exponent, exponentBits, power);
+        } else if (usesLibraryKernels(policy)) {
+            constant_time_pow_mod_p(base, exponent, exponentBits, power);
+        } else if (exponentBits == MAX_Q_SIZE * 8U) {
+            CONTEXT_P().modExpQ(const_cast<uint64_t *>(base), const_cast<uint64_t *>(exponent),
+                                power, true);
+        } else {
+            CONTEXT_P().modExp(const_cast<uint64_t *>(base), exponentBits,
+                               const_cast<uint64_t *>(exponent), power, true);
+        }
     }
 
-    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModP &exponent)
+    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModP &exponent,
+                                      ExponentiationPolicy policy /* = constantTime */)
     {
-        // HACL's input constraints require the exponent to be greater than zero
+        countExponentiation(policy);
+
+        // an exponent of zero is the identity
         if (const_cast<ElementModP &>(exponent) == ZERO_MOD_P()) {
             return ElementModP::fromUint64(1UL);
         }
 
         uint64_t result[MAX_P_LEN] = {};
-        CONTEXT_P().modExp(base.get(), MAX_P_SIZE, exponent.get(), static_cast<uint64_t *>(result));
+        pow_mod_p_with_policy(base.data(), exponent.data(), MAX_P_SIZE * 8U,
+                              static_cast<uint64_t *>(result), policy);
         return make_unique<ElementModP>(result, true);
     }
 
-    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModQ &exponent)
+    unique_ptr<ElementModP> pow_mod_p(const ElementModP &base, const ElementModQ &exponent,
+                                      ExponentiationPolicy policy /* = constantTime */)
+    {
+        auto result = make_unique<ElementModP>();
+        pow_mod_p(base, exponent, *result, policy);
+        return result;
+    }
+
+    void pow_mod_p(const ElementModP &base, const ElementModQ &exponent, ElementModP &result,
+                   ExponentiationPolicy policy /* = constantTime */)
     {
-        // HACL's input constraints require the exponent to be greater than zero
+        countExponentiation(policy);
+        uint64_t power[MAX_P_LEN] = {};
+
+        // an exponent of zero is the identity
         if (const_cast<ElementModQ &>(exponent) == ZERO_MOD_Q()) {
-            return ElementModP::fromUint64(1UL);
+            assign(result, ONE_MOD_P().cref());
+            return;
         }
 
-        // check if we have a lookup table initialized for this element
-        if (base.isFixedBase()) {
-            // TODO: use a smaller key
-            auto hex = base.toHex();
-            auto exp_ptr = exponent.get();
-            auto result = LookupTableContext::pow_mod_p(hex, base.ref(), exponent.ref());
-
-            return make_unique<ElementModP>(result, true);
+        // check if we have a lookup table initialized for this element,
+        // bases that are used often enough are promoted to a lookup table
+        auto served =
+          usesLibraryKernels(policy) &&
+          (base.isFixedBase()
+             ? LookupTableContext::pow_mod_p(base.cref(), exponent.ref(), power, policy)
+             : LookupTableContext::isAdaptive() &&
+                 LookupTableContext::adaptive_pow_mod_p(base.cref(), exponent.ref(), power,
+                                                        policy));
+        if (served) {
+            countLookupTable(policy);
+            assign(result, power);
+            return;
         }
 
         // if none exists, execute the modular exponentiation directly
-        return pow_mod_p(base, *exponent.toElementModP());
+        // using only the 256 significant bits of the exponent
+        pow_mod_p_with_policy(base.data(), exponent.get(), MAX_Q_SIZE * 8U,
+                              static_cast<uint64_t *>(power), policy);
+        assign(result, power);
     }
 
     unique_ptr<ElementModP> g_pow_p(const ElementModP &exponent)
@@ -637,159 +886,537 @@ namespace electionguard
         return pow_mod_p(G(), exponent);
     }
 
-#pragma endregion
+    void g_pow_p(const ElementModQ &exponent, ElementModP &result)
+    {
+        pow_mod_p(G(), exponent, result);
+    }
 
-#pragma region ElementModQ Global Functions
+    void set_lookup_table_cache_policy(uint64_t promotionThreshold, uint64_t byteBudget)
+    {
+        LookupTableContext::setPolicy(promotionThreshold, byteBudget);
+    }
 
-    unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    LookupTableCacheStatistics get_lookup_table_cache_statistics()
     {
-        const auto &q = Q();
-        uint64_t addResult[MAX_Q_LEN_DOUBLE] = {};
-        uint64_t carry =
-          Bignum256::add(const_cast<ElementModQ &>(lhs).get(), const_cast<ElementModQ &>(rhs).get(),
-                         static_cast<uint64_t *>(addResult));
+        return LookupTableContext::getStatistics();
+    }
 
-        // handle the specific case where the the sum == MAX_256
-        // but the carry value is not set.  We still need to offset.
-        if (carry > 0 || isMax(addResult)) {
+    void save_lookup_table(const ElementModP &base, const string &path)
+    {
+        LookupTableContext::save(base.cref(), path);
+    }
 
-            auto big_a = (const_cast<ElementModQ &>(q) < lhs);
-            auto big_b = (const_cast<ElementModQ &>(q) < rhs);
+    void load_lookup_table(const ElementModP &base, const string &path)
+    {
+        LookupTableContext::load(base.cref(), path);
+        base.setIsFixedBase(true);
+    }
 
-            if (big_a || big_b) {
+    future<void> prepare_lookup_table(const ElementModP &base)
+    {
+        auto prepared = LookupTableContext::prepare(base.cref());
+        base.setIsFixedBase(true);
+        return prepared;
+    }
 
-                uint64_t offset[MAX_Q_LEN] = {};
-                if (big_a) {
-                    // TODO: move the casts into the interface
-                    Bignum256::add(static_cast<uint64_t *>(offset),
-                                   const_cast<uint64_t *>(Q_ARRAY_INVERSE_OFFSET),
-                                   static_cast<uint64_t *>(offset));
-                    Bignum256::add(static_cast<uint64_t *>(offset),
-                                   const_cast<uint64_t *>(ONE_MOD_Q_ARRAY),
-                                   static_cast<uint64_t *>(offset));
-                }
+    void set_lookup_table_window_size(const ElementModP &base, uint64_t windowSize)
+    {
+        LookupTableContext::setWindowSize(base.cref(), windowSize);
+    }
 
-                if (big_b) {
-                    Bignum256::add(static_cast<uint64_t *>(offset),
-                                   const_cast<uint64_t *>(Q_ARRAY_INVERSE_OFFSET),
-                                   static_cast<uint64_t *>(offset));
-                    Bignum256::add(static_cast<uint64_t *>(offset),
-                                   const_cast<uint64_t *>(ONE_MOD_Q_ARRAY),
-                                   static_cast<uint64_t *>(offset));
-                }
+    void set_lookup_table_huge_pages(LookupTableHugePages hugePages)
+    {
+        LookupTableContext::setHugePages(hugePages);
+    }
 
-                // adjust
-                Bignum256::add(static_cast<uint64_t *>(addResult), static_cast<uint64_t *>(offset),
-                               static_cast<uint64_t *>(addResult));
+    uint64_t discrete_log(const ElementModP &element) { return DiscreteLogContext::find(element); }
+
+    void set_discrete_log_policy(uint64_t maxExponent, uint64_t byteBudget)
+    {
+        DiscreteLogContext::setPolicy(maxExponent, byteBudget);
+    }
+
+    void save_discrete_log_table(const string &path) { DiscreteLogContext::save(path); }
+
+    void load_discrete_log_table(const string &path) { DiscreteLogContext::load(path); }
+
+    void interleave_lookup_tables(const vector<reference_wrapper<const ElementModP>> &bases)
+    {
+        vector<uint64_t *> limbs;
+        for (const auto &base : bases) {
+            limbs.push_back(base.get().get());
+        }
+        LookupTableContext::interleave(limbs);
+        for (const auto &base : bases) {
+            base.get().setIsFixedBase(true);
+        }
+    }
+
+    vector<unique_ptr<ElementModP>>
+    pow_mod_p_shared_exponent(const vector<reference_wrapper<const ElementModP>> &bases,
+                              const ElementModQ &exponent,
+                              ExponentiationPolicy policy /* = constantTime */)
+    {
+        vector<shared_ptr<FixedBaseTable>> tables;
+        for (const auto &base : bases) {
+            if (!base.get().isFixedBase()) {
+                break;
+            }
+            auto table = LookupTableContext::getFixedTable(base.get().cref());
+            if (!table->serves(policy) ||
+                (!tables.empty() && table->windowSize() != tables[0]->windowSize())) {
+                break;
+            }
+            tables.push_back(table);
+        }
+
+        vector<unique_ptr<ElementModP>> results;
+        if (tables.size() == bases.size()) {
+            for (size_t i = 0; i < bases.size(); i++) {
+                countExponentiation(policy);
+            }
+            countLookupTable(policy, bases.size());
+            for (auto &result :
+                 FixedBaseTable::pow_mod_p_shared_exponent(tables, exponent.ref(), policy)) {
+                results.push_back(make_unique<ElementModP>(result, true));
+            }
+            return results;
+        }
 
+        for (const auto &base : bases) {
+            results.push_back(pow_mod_p(base, exponent, policy));
+        }
+        return results;
+    }
+
+    /// <summary>
+    /// the fewest exponentiations worth running across vector lanes, as the lanes
+    /// cost the same however many of them are in use
+    /// </summary>
+    const size_t POW_MOD_P_BATCH_MIN_LANES = 2U;
+
+    vector<unique_ptr<ElementModP>>
+    pow_mod_p_batch(const vector<reference_wrapper<const ElementModP>> &bases,
+                    const vector<reference_wrapper<const ElementModQ>> &exponents)
+    {
+        if (bases.size() != exponents.size()) {
+            throw invalid_argument("pow_mod_p_batch:: bases and exponents must be the same size");
+        }
+
+        vector<unique_ptr<ElementModP>> results(bases.size());
+        vector<size_t> variable;
+        for (size_t i = 0; i < bases.size(); i++) {
+            if (bases[i].get().isFixedBase()) {
+                results[i] = pow_mod_p(bases[i].get(), exponents[i].get());
             } else {
-                Bignum256::add(static_cast<uint64_t *>(addResult),
-                               const_cast<uint64_t *>(Q_ARRAY_INVERSE_OFFSET),
-                               static_cast<uint64_t *>(addResult));
+                variable.push_back(i);
+            }
+        }
+
+        size_t next = 0;
+        while (usesLibraryKernels(ExponentiationPolicy::constantTime) &&
+               variable.size() - next >= POW_MOD_P_BATCH_MIN_LANES) {
+            auto count = static_cast<uint32_t>(
+              min(variable.size() - next, static_cast<size_t>(MONTGOMERY_LANES)));
+            const uint64_t *laneBases[MONTGOMERY_LANES] = {};
+            const uint64_t *laneExponents[MONTGOMERY_LANES] = {};
+            uint64_t laneResults[MONTGOMERY_LANES][MAX_P_LEN] = {};
+            uint64_t *laneResultPointers[MONTGOMERY_LANES] = {};
+            for (uint32_t lane = 0; lane < count; lane++) {
+                laneBases[lane] = bases[variable[next + lane]].get().data();
+                laneExponents[lane] = exponents[variable[next + lane]].get().get();
+                laneResultPointers[lane] = laneResults[lane];
+            }
+
+            if (!CONTEXT_P().modExpQLanes(count, laneBases, laneExponents, laneResultPointers)) {
+                break;
             }
+            for (uint32_t lane = 0; lane < count; lane++) {
+                countExponentiation(ExponentiationPolicy::constantTime);
+                results[variable[next + lane]] = make_unique<ElementModP>(laneResults[lane], true);
+            }
+            next += count;
         }
 
-        uint64_t result[MAX_Q_LEN] = {};
-        CONTEXT_Q().mod(static_cast<uint64_t *>(addResult), static_cast<uint64_t *>(result));
-        return make_unique<ElementModQ>(result, true);
+        for (; next < variable.size(); next++) {
+            auto i = variable[next];
+            results[i] = pow_mod_p(bases[i].get(), exponents[i].get());
+        }
+        return results;
     }
 
-    unique_ptr<ElementModQ> add_mod_q(const vector<reference_wrapper<ElementModQ>> &elements)
+    vector<unique_ptr<ElementModP>>
+    inv_mod_p_batch(const vector<reference_wrapper<const ElementModP>> &elements)
     {
-        if (elements.empty()) {
-            throw invalid_argument("must have one or more elements");
+        auto count = elements.size();
+        if (count == 0) {
+            return {};
         }
 
-        auto result = ElementModQ::fromUint64(0UL, true);
-        for (auto element : elements) {
-            auto sum = add_mod_q(*result, element.get());
-            result.swap(sum);
+        // the running products a0 * a1 * ... * ai in montgomery form
+        vector<uint64_t> elementsM(count * MAX_P_LEN);
+        vector<uint64_t> prefixesM(count * MAX_P_LEN);
+        auto elementM = [&elementsM](size_t i) { return elementsM.data() + i * MAX_P_LEN; };
+        auto prefixM = [&prefixesM](size_t i) { return prefixesM.data() + i * MAX_P_LEN; };
+        for (size_t i = 0; i < count; i++) {
+            CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(elements[i].get().data()),
+                                           elementM(i));
         }
-        return result;
+        copy(elementM(0), elementM(0) + MAX_P_LEN, prefixM(0));
+        for (size_t i = 1; i < count; i++) {
+            CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(prefixM(i - 1), elementM(i),
+                                                             prefixM(i));
+        }
+
+        // a single inversion of the product of every element
+        uint64_t product[MAX_P_LEN] = {};
+        CONTEXT_P().from_montgomery_form(prefixM(count - 1), static_cast<uint64_t *>(product));
+        uint64_t zero[MAX_P_LEN] = {};
+        if (std::equal(std::begin(product), std::end(product), std::begin(zero))) {
+            throw invalid_argument("inv_mod_p_batch:: elements must be non-zero mod p");
+        }
+        uint64_t inverse[MAX_P_LEN] = {};
+        CONTEXT_P().modInvPrime(static_cast<uint64_t *>(product),
+                                static_cast<uint64_t *>(inverse));
+
+        // walk back peeling one element off the inverse at a time. the inverse stays in
+        // standard form since a montgomery product of a standard and a montgomery operand
+        // is in standard form.
+        vector<unique_ptr<ElementModP>> results(count);
+        for (size_t i = count - 1; i > 0; i--) {
+            uint64_t result[MAX_P_LEN] = {};
+            CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              static_cast<uint64_t *>(inverse), prefixM(i - 1), static_cast<uint64_t *>(result));
+            results[i] = make_unique<ElementModP>(result, true);
+            CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              static_cast<uint64_t *>(inverse), elementM(i), static_cast<uint64_t *>(inverse));
+        }
+        results[0] = make_unique<ElementModP>(inverse, true);
+        return results;
     }
 
-    unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b)
+    /// <summary>
+    /// window width in bits used when interleaving a few bases
+    /// </summary>
+    const uint32_t MULTI_POW_STRAUS_WINDOW_BITS = 4U;
+
+    /// <summary>
+    /// number of bases at which shared buckets outperform per-base window tables
+    /// </summary>
+    const size_t MULTI_POW_PIPPENGER_THRESHOLD = 128U;
+
+    /// <summary>
+    /// Extract `width` bits of the 256-bit exponent starting at bit `offset`
+    /// </summary>
+    static uint32_t exponent_window(const uint64_t *exponent, uint32_t offset, uint32_t width)
     {
-        const auto &q = Q();
-        uint64_t subResult[MAX_Q_LEN_DOUBLE] = {};
-        uint64_t carry =
-          Bignum256::sub(const_cast<ElementModQ &>(a).get(), const_cast<ElementModQ &>(b).get(),
-                         static_cast<uint64_t *>(subResult));
+        const uint32_t limbBits = 64U;
+        auto limb = offset / limbBits;
+        auto shift = offset % limbBits;
+        if (limb >= MAX_Q_LEN) {
+            return 0U;
+        }
+        uint64_t window = exponent[limb] >> shift;
+        if (shift + width > limbBits && limb + 1 < MAX_Q_LEN) {
+            window |= exponent[limb + 1] << (limbBits - shift);
+        }
+        return static_cast<uint32_t>(window & ((1ULL << width) - 1));
+    }
+
+    /// <summary>
+    /// Interleave the exponentiations of a few bases (Straus' method).
+    ///
+    /// Each base gets a table of b^1..b^(2^w - 1) in montgomery form and the
+    /// window digits of every exponent are consumed on one shared squaring chain.
+    /// The result is accumulated in montgomery form into `accM`.
+    /// </summary>
+    static void straus_pow_mod_p(const vector<const uint64_t *> &bases,
+                                 const vector<const uint64_t *> &exponents, uint64_t *accM,
+                                 bool &started)
+    {
+        const auto &context = CONTEXT_P();
+        const uint32_t windowSize = 1U << MULTI_POW_STRAUS_WINDOW_BITS;
+        const uint32_t windowCount = (MAX_Q_SIZE * 8U) / MULTI_POW_STRAUS_WINDOW_BITS;
+
+        vector<uint64_t> tables(bases.size() * windowSize * MAX_P_LEN);
+        for (size_t i = 0; i < bases.size(); i++) {
+            auto *table = &tables[i * windowSize * MAX_P_LEN];
+            context.to_montgomery_form(const_cast<uint64_t *>(bases[i]), &table[MAX_P_LEN]);
+            for (uint32_t j = 2; j < windowSize; j++) {
+                context.montgomery_mod_mul_stay_in_mont_form(&table[(j - 1) * MAX_P_LEN],
+                                                             &table[MAX_P_LEN],
+                                                             &table[j * MAX_P_LEN]);
+            }
+        }
 
-        if (carry > 0) {
+        for (uint32_t w = windowCount; w-- > 0;) {
+            if (started) {
+                for (uint32_t s = 0; s < MULTI_POW_STRAUS_WINDOW_BITS; s++) {
+                    context.montgomery_mod_sqr_stay_in_mont_form(accM, accM);
+                }
+            }
+            for (size_t i = 0; i < bases.size(); i++) {
+                auto digit =
+                  exponent_window(exponents[i], w * MULTI_POW_STRAUS_WINDOW_BITS,
+                                  MULTI_POW_STRAUS_WINDOW_BITS);
+                if (digit == 0) {
+                    continue;
+                }
+                auto *entry = &tables[(i * windowSize + digit) * MAX_P_LEN];
+                if (started) {
+                    context.montgomery_mod_mul_stay_in_mont_form(accM, entry, accM);
+                } else {
+                    copy(entry, entry + MAX_P_LEN, accM);
+                    started = true;
+                }
+            }
+        }
+    }
 
-            auto big_a = (const_cast<ElementModQ &>(q) < a);
-            auto big_b = (const_cast<ElementModQ &>(q) < b);
+    /// <summary>
+    /// Accumulate the exponentiations of many bases into shared buckets (Pippenger's method).
+    ///
+    /// For each window every base is multiplied into the bucket of its digit, and
+    /// the buckets are combined with a running product so that bucket d contributes d times.
+    /// The result is accumulated in montgomery form into `accM`.
+    /// </summary>
+    static void pippenger_pow_mod_p(const vector<const uint64_t *> &bases,
+                                    const vector<const uint64_t *> &exponents, uint64_t *accM,
+                                    bool &started)
+    {
+        const auto &context = CONTEXT_P();
+        const uint32_t exponentBits = MAX_Q_SIZE * 8U;
+        const auto count = bases.size();
+        const uint32_t windowBits = count < 256 ? 5U : count < 1024 ? 6U : count < 4096 ? 7U : 8U;
+        const uint32_t bucketCount = 1U << windowBits;
+        const uint32_t windowCount = (exponentBits + windowBits - 1) / windowBits;
+
+        vector<uint64_t> basesM(count * MAX_P_LEN);
+        for (size_t i = 0; i < count; i++) {
+            context.to_montgomery_form(const_cast<uint64_t *>(bases[i]), &basesM[i * MAX_P_LEN]);
+        }
 
-            if (big_a || big_b) {
+        vector<uint64_t> buckets(bucketCount * MAX_P_LEN);
+        vector<bool> used(bucketCount);
+        uint64_t runningM[MAX_P_LEN] = {};
+        uint64_t windowM[MAX_P_LEN] = {};
 
-                // TODO: ISSUE #135: precompute
+        for (uint32_t w = windowCount; w-- > 0;) {
+            if (started) {
+                for (uint32_t s = 0; s < windowBits; s++) {
+                    context.montgomery_mod_sqr_stay_in_mont_form(accM, accM);
+                }
+            }
 
-                uint64_t offset[MAX_Q_LEN] = {};
+            fill(used.begin(), used.end(), false);
+            for (size_t i = 0; i < count; i++) {
+                auto digit = exponent_window(exponents[i], w * windowBits, windowBits);
+                if (digit == 0) {
+                    continue;
+                }
+                auto *bucket = &buckets[digit * MAX_P_LEN];
+                auto *baseM = &basesM[i * MAX_P_LEN];
+                if (used[digit]) {
+                    context.montgomery_mod_mul_stay_in_mont_form(bucket, baseM, bucket);
+                } else {
+                    copy(baseM, baseM + MAX_P_LEN, bucket);
+                    used[digit] = true;
+                }
+            }
 
-                Bignum256::add(static_cast<uint64_t *>(offset),
-                               const_cast<uint64_t *>(Q_ARRAY_INVERSE_OFFSET),
-                               static_cast<uint64_t *>(offset));
-                Bignum256::add(static_cast<uint64_t *>(offset),
-                               const_cast<uint64_t *>(ONE_MOD_Q_ARRAY),
-                               static_cast<uint64_t *>(offset));
+            // sum of d * bucket[d] as the product of the running suffix products
+            bool hasRunning = false;
+            bool hasWindow = false;
+            for (uint32_t d = bucketCount; d-- > 1;) {
+                auto *bucket = &buckets[d * MAX_P_LEN];
+                if (used[d]) {
+                    if (hasRunning) {
+                        context.montgomery_mod_mul_stay_in_mont_form(
+                          static_cast<uint64_t *>(runningM), bucket,
+                          static_cast<uint64_t *>(runningM));
+                    } else {
+                        copy(bucket, bucket + MAX_P_LEN, static_cast<uint64_t *>(runningM));
+                        hasRunning = true;
+                    }
+                }
+                if (!hasRunning) {
+                    continue;
+                }
+                if (hasWindow) {
+                    context.montgomery_mod_mul_stay_in_mont_form(static_cast<uint64_t *>(windowM),
+                                                                 static_cast<uint64_t *>(runningM),
+                                                                 static_cast<uint64_t *>(windowM));
+                } else {
+                    copy(runningM, runningM + MAX_P_LEN, static_cast<uint64_t *>(windowM));
+                    hasWindow = true;
+                }
+            }
 
-                // adjust
-                Bignum256::sub(static_cast<uint64_t *>(subResult), static_cast<uint64_t *>(offset),
-                               static_cast<uint64_t *>(subResult));
+            if (!hasWindow) {
+                continue;
+            }
+            if (started) {
+                context.montgomery_mod_mul_stay_in_mont_form(accM, static_cast<uint64_t *>(windowM),
+                                                             accM);
+            } else {
+                copy(windowM, windowM + MAX_P_LEN, accM);
+                started = true;
+            }
+        }
+    }
+
+    unique_ptr<ElementModP>
+    multi_pow_mod_p(const vector<reference_wrapper<const ElementModP>> &bases,
+                    const vector<reference_wrapper<const ElementModQ>> &exponents,
+                    ExponentiationPolicy policy /* = constantTime */)
+    {
+        if (bases.size() != exponents.size()) {
+            throw invalid_argument("multi_pow_mod_p:: bases and exponents must be the same size");
+        }
+
+        MontElementModP accumulator;
+
+        // secret exponents cannot share the chain, which skips their zero windows
+        if (policy == ExponentiationPolicy::constantTime) {
+            for (size_t i = 0; i < bases.size(); i++) {
+                ElementModP power;
+                pow_mod_p(bases[i].get(), exponents[i].get(), power, policy);
+                accumulator.mul(power);
+            }
+            return accumulator.toElementModP();
+        }
+
+        // bases with a lookup table are cheaper to evaluate on their own,
+        // the rest share a single squaring chain
+        vector<const uint64_t *> variableBases;
+        vector<const uint64_t *> variableExponents;
+        for (size_t i = 0; i < bases.size(); i++) {
+            const auto &base = bases[i].get();
+            const auto &exponent = exponents[i].get();
+            if (!base.isFixedBase()) {
+                countExponentiation(policy);
+                variableBases.push_back(base.data());
+                variableExponents.push_back(exponent.get());
+                continue;
+            }
 
+            ElementModP power;
+            pow_mod_p(base, exponent, power, policy);
+            accumulator.mul(power);
+        }
+
+        // the squaring chain must start from the identity, so the
+        // variable bases are evaluated on their own and folded in
+        if (!variableBases.empty()) {
+            uint64_t variableM[MAX_P_LEN] = {};
+            bool variableStarted = false;
+            if (variableBases.size() < MULTI_POW_PIPPENGER_THRESHOLD) {
+                straus_pow_mod_p(variableBases, variableExponents,
+                                 static_cast<uint64_t *>(variableM), variableStarted);
             } else {
-                // if there is no carry then offset by the inverse
-                Bignum256::sub(static_cast<uint64_t *>(subResult),
-                               const_cast<uint64_t *>(Q_ARRAY_INVERSE_OFFSET),
-                               static_cast<uint64_t *>(subResult));
+                pippenger_pow_mod_p(variableBases, variableExponents,
+                                    static_cast<uint64_t *>(variableM), variableStarted);
             }
+
+            if (variableStarted) {
+                accumulator.mul(MontElementModP::fromMontgomeryForm(variableM));
+            }
+        }
+
+        return accumulator.toElementModP();
+    }
+
+#pragma endregion
+
+#pragma region ElementModQ Global Functions
+
+    unique_ptr<ElementModQ> add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs)
+    {
+        auto result = make_unique<ElementModQ>();
+        add_mod_q(lhs, rhs, *result);
+        return result;
+    }
+
+    void add_mod_q(const ElementModQ &lhs, const ElementModQ &rhs, ElementModQ &result)
+    {
+        uint64_t res[MAX_Q_LEN] = {};
+        mod_q_add(lhs.get(), rhs.get(), static_cast<uint64_t *>(res));
+        assign(result, res);
+    }
+
+    unique_ptr<ElementModQ> add_mod_q(const vector<reference_wrapper<ElementModQ>> &elements)
+    {
+        if (elements.empty()) {
+            throw invalid_argument("must have one or more elements");
         }
 
-        uint64_t resModQ[MAX_Q_LEN] = {};
-        CONTEXT_Q().mod(static_cast<uint64_t *>(subResult), static_cast<uint64_t *>(resModQ));
+        auto result = make_unique<ElementModQ>();
+        for (auto element : elements) {
+            add_mod_q(*result, element.get(), *result);
+        }
+        return result;
+    }
+
+    unique_ptr<ElementModQ> sub_mod_q(const ElementModQ &a, const ElementModQ &b)
+    {
+        auto result = make_unique<ElementModQ>();
+        sub_mod_q(a, b, *result);
+        return result;
+    }
 
-        return make_unique<ElementModQ>(resModQ, true);
+    void sub_mod_q(const ElementModQ &a, const ElementModQ &b, ElementModQ &result)
+    {
+        uint64_t res[MAX_Q_LEN] = {};
+        mod_q_sub(a.get(), b.get(), static_cast<uint64_t *>(res));
+        assign(result, res);
     }
 
     unique_ptr<ElementModQ> a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
                                             const ElementModQ &c)
     {
-        // multiply b * c and the result will be twice Q in size
-        uint64_t bc[MAX_Q_LEN_DOUBLE] = {};
-        Bignum256::mul(const_cast<ElementModQ &>(b).get(), const_cast<ElementModQ &>(c).get(),
-                       bc);
+        auto result = make_unique<ElementModQ>();
+        a_plus_bc_mod_q(a, b, c, *result);
+        return result;
+    }
 
-        // perform the mod operation on bc
-        uint64_t bc_mod_q[MAX_Q_LEN] = {};
-        const auto &q = Q();
-        bool modSuccess = Bignum256::mod(q.get(), bc, bc_mod_q);
-        if (!modSuccess) {
-            throw runtime_error("a_plus_bc_mod_q mod operation failed");
-        }
+    void a_plus_bc_mod_q(const ElementModQ &a, const ElementModQ &b, const ElementModQ &c,
+                         ElementModQ &result)
+    {
+        uint64_t res[MAX_Q_LEN] = {};
+        mod_q_mul_add(a.get(), b.get(), c.get(), static_cast<uint64_t *>(res));
+        assign(result, res);
+    }
 
-        uint64_t a_plus_bc[MAX_Q_LEN_DOUBLE] = {};
-        uint64_t carry = Bignum256::add(const_cast<ElementModQ &>(a).get(), bc_mod_q, a_plus_bc);
-        // put the carry in
-        a_plus_bc[MAX_Q_LEN] = carry;
+    unique_ptr<ElementModQ> a_minus_bc_mod_q(const ElementModQ &a, const ElementModQ &b,
+                                             const ElementModQ &c)
+    {
+        auto result = make_unique<ElementModQ>();
+        a_minus_bc_mod_q(a, b, c, *result);
+        return result;
+    }
 
+    void a_minus_bc_mod_q(const ElementModQ &a, const ElementModQ &b, const ElementModQ &c,
+                          ElementModQ &result)
+    {
         uint64_t res[MAX_Q_LEN] = {};
-        modSuccess = Bignum256::mod(q.get(), a_plus_bc, res);
-        if (!modSuccess) {
-            throw runtime_error("a_plus_bc_mod_q mod operation failed");
-        }
-
-        return make_unique<ElementModQ>(res, true);
+        mod_q_mul_sub(a.get(), b.get(), c.get(), static_cast<uint64_t *>(res));
+        assign(result, res);
     }
 
     unique_ptr<ElementModQ> sub_from_q(const ElementModQ &a)
     {
-        uint64_t result[MAX_Q_LEN] = {};
-        Bignum256::sub(const_cast<ElementModQ &>(Q()).get(), const_cast<ElementModQ &>(a).get(),
-                       static_cast<uint64_t *>(result));
+        auto result = make_unique<ElementModQ>();
+        sub_from_q(a, *result);
+        return result;
+    }
+
+    void sub_from_q(const ElementModQ &a, ElementModQ &result)
+    {
+        uint64_t difference[MAX_Q_LEN] = {};
+        Bignum256::sub(Q().get(), a.get(), static_cast<uint64_t *>(difference));
         // TODO: python version doesn't perform % Q on results,
         // but we still need to handle the overflow values between (Q, MAX_256]
-        return make_unique<ElementModQ>(result, true);
+        assign(result, difference);
     }
 
     unique_ptr<ElementModP> rand_p()
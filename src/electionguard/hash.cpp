@@ -1,257 +1,302 @@
 #include "electionguard/hash.hpp"
 
-#include "../karamel/Hacl_Bignum256.h"
-#include "../karamel/Hacl_Streaming_SHA2.h"
-#include "log.hpp"
+#include "hash_stream.hpp"
+#include "q_field.hpp"
+#include "sha256.hpp"
+#include "sha256_lanes.hpp"
 
-#include <iomanip>
-#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <variant>
 
-using std::get;
 using std::make_unique;
 using std::nullptr_t;
-using std::out_of_range;
-using std::reference_wrapper;
 using std::string;
-using std::to_string;
 using std::unique_ptr;
 using std::vector;
 
 namespace electionguard
 {
-    string get_hash_string(CryptoHashableType a);
-    template <typename T> string hash_inner_vector(vector<T> inner_vector);
-    void push_hash_update(Hacl_Streaming_SHA2_state_sha2_224 *p, CryptoHashableType a);
-    Hacl_Streaming_SHA2_state_sha2_224 *hash_open();
-    unique_ptr<ElementModQ> hash_close(Hacl_Streaming_SHA2_state_sha2_224 *p);
-
-    enum CryptoHashableTypeEnum {
-        NULL_PTR = 0,
-        CRYPTOHASHABLE_PTR = 1,
-        ELEMENTMODP_PTR = 2,
-        ELEMENTMODQ_PTR = 3,
-        CRYPTOHASHABLE_REF = 4,
-        ELEMENTMODP_REF = 5,
-        ELEMENTMODQ_REF = 6,
-        CRYPTOHASHABLE_CONST_REF = 7,
-        ELEMENTMODP_CONST_REF = 8,
-        ELEMENTMODQ_CONST_REF = 9,
-        UINT64_T = 10,
-        STRING = 11,
-        VECTOR_CRYPTOHASHABLE_PTR = 12,
-        VECTOR_ELEMENTMODP_PTR = 13,
-        VECTOR_ELEMENTMODQ_PTR = 14,
-        VECTOR_CRYPTOHASHABLE_REF = 15,
-        VECTOR_ELEMENTMODP_REF = 16,
-        VECTOR_ELEMENTMODQ_REF = 17,
-        VECTOR_CRYPTOHASHABLE_CONST_REF = 18,
-        VECTOR_ELEMENTMODP_CONST_REF = 19,
-        VECTOR_ELEMENTMODQ_CONST_REF = 20,
-        VECTOR_UINT64_T = 21,
-        VECTOR_STRING = 22,
-        VECTOR_UINT8_T = 23
-    };
-
     const char delimiter_char = '|';
-    const string null_string = "null";
+    const char null_string[] = "null";
+    const char hex_digits[] = "0123456789ABCDEF";
 
-    uint8_t delimiter[1] = {delimiter_char};
+    /// <summary>
+    /// the number of bytes hex encoded on the stack before they are fed to the hash
+    /// </summary>
+    const size_t HASH_HEX_CHUNK = 256U;
 
     unique_ptr<ElementModQ> hash_elems(const vector<CryptoHashableType> &a)
     {
-        uint8_t output[MAX_Q_SIZE] = {};
-        Hacl_Streaming_SHA2_state_sha2_224 *p = hash_open();
-
+        HashStream stream;
         if (a.empty()) {
-            push_hash_update(p, nullptr);
+            stream.append(nullptr);
         } else {
             for (const CryptoHashableType &item : a) {
-                push_hash_update(p, item);
+                stream.append(item);
             }
         }
-        return hash_close(p);
+
+        return stream.finish();
     }
 
     unique_ptr<ElementModQ> hash_elems(CryptoHashableType a)
     {
-        Hacl_Streaming_SHA2_state_sha2_224 *p = hash_open();
-        push_hash_update(p, a);
-        return hash_close(p);
+        HashStream stream;
+        stream.append(a);
+        return stream.finish();
+    }
+
+    vector<unique_ptr<ElementModQ>>
+    hash_elems_batch(const vector<vector<CryptoHashableType>> &inputs)
+    {
+        vector<HashStream> streams(inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++) {
+            if (inputs[i].empty()) {
+                streams[i].append(nullptr);
+            }
+            for (const CryptoHashableType &item : inputs[i]) {
+                streams[i].append(item);
+            }
+        }
+        return HashStream::finishBatch(streams);
+    }
+
+    /// <summary>
+    /// Reduce the big endian SHA-256 digest into [0, q-1]
+    /// </summary>
+    static void reduceDigest(const uint8_t *digest, uint64_t (&result)[MAX_Q_LEN])
+    {
+        // the digest is a big endian number, the limbs are little endian
+        uint64_t limbs[MAX_Q_LEN] = {};
+        for (size_t i = 0; i < MAX_Q_SIZE; i++) {
+            limbs[MAX_Q_LEN - 1 - i / 8] = (limbs[MAX_Q_LEN - 1 - i / 8] << 8) | digest[i];
+        }
+        mod_q_reduce(static_cast<uint64_t *>(limbs), static_cast<uint64_t *>(result));
     }
 
-    Hacl_Streaming_SHA2_state_sha2_224 *hash_open()
+#pragma region HashStream
+
+    HashStream::HashStream() : blockState(), buffer(), totalLength(0)
     {
-        Hacl_Streaming_SHA2_state_sha2_224 *p = Hacl_Streaming_SHA2_create_in_256();
-        Hacl_Streaming_SHA2_update_256(p, static_cast<uint8_t *>(delimiter), sizeof(delimiter));
-        return p;
+        sha256_init(static_cast<uint32_t *>(blockState));
+        update(&delimiter_char, sizeof(delimiter_char));
     }
 
-    unique_ptr<ElementModQ> hash_close(Hacl_Streaming_SHA2_state_sha2_224 *p)
+    void HashStream::append(const CryptoHashableType &a)
     {
-        uint8_t output[MAX_Q_SIZE] = {};
-        Hacl_Streaming_SHA2_finish_256(p, static_cast<uint8_t *>(output));
+        std::visit([this](const auto &value) { append(value); }, a);
+    }
+
+    void HashStream::append(nullptr_t) { appendString(null_string, sizeof(null_string) - 1); }
+
+    void HashStream::append(CryptoHashable &a)
+    {
+        auto hash = a.crypto_hash();
+        appendHex(hash->get(), MAX_Q_LEN);
+    }
 
-        auto *bigNum =
-          Hacl_Bignum256_new_bn_from_bytes_be(sizeof(output), static_cast<uint8_t *>(output));
-        if (bigNum == nullptr) {
-            throw out_of_range("bytes_to_p could not allocate");
+    void HashStream::append(const CryptoHashable &a)
+    {
+        auto hash = a.crypto_hash();
+        appendHex(hash->get(), MAX_Q_LEN);
+    }
+
+    void HashStream::append(const ElementModP &a) { appendHex(a.data(), MAX_P_LEN); }
+
+    void HashStream::append(const ElementModQ &a) { appendHex(a.get(), MAX_Q_LEN); }
+
+    void HashStream::append(uint64_t a)
+    {
+        if (a == 0) {
+            append(nullptr);
+            return;
         }
 
-        // The ElementModQ constructor expects the bignum
-        // to be a certain size, but there's no guarantee
-        // that constraint is satisfied by new_bn_from_bytes_be
-        // so copy it into a new element that is the correct size
-        // and free the allocated resources
-        uint64_t normalized[MAX_Q_LEN] = {};
-        memcpy(static_cast<uint64_t *>(normalized), bigNum, sizeof(output));
-        Hacl_Streaming_SHA2_free_256(p);
-        free(bigNum);
-
-        auto element = make_unique<ElementModQ>(normalized, true);
-
-        // TODO: take the result mod Q - 1
-        // to produce a result that is [0,q-1]
-        return add_mod_q(*element, ZERO_MOD_Q());
+        // write the decimal digits from the end of the buffer
+        char digits[20];
+        auto *first = std::end(digits);
+        for (; a != 0; a /= 10) {
+            *--first = static_cast<char>('0' + a % 10);
+        }
+        appendString(first, static_cast<size_t>(std::end(digits) - first));
     }
 
-    template <typename T> string hash_inner_vector(vector<T> inner_vector)
+    void HashStream::append(const string &a)
     {
-        if (inner_vector.empty()) {
-            return null_string;
+        if (a.empty()) {
+            append(nullptr);
+            return;
         }
-        vector<CryptoHashableType> hashable_vector(inner_vector.begin(), inner_vector.end());
-        return hash_elems(hashable_vector)->toHex();
+        appendString(a.data(), a.size());
     }
 
-    string get_hash_string(CryptoHashableType a)
+    void HashStream::append(const char *a)
     {
-        switch (a.index()) {
-            case NULL_PTR: // nullptr_t
-            {
-                return null_string;
-            }
-            case CRYPTOHASHABLE_PTR: // CryptoHashable *
-            {
-                auto hashable = get<CryptoHashable *>(a)->crypto_hash();
-                return hashable->toHex();
-            }
-            case ELEMENTMODP_PTR: // ElementModP *
-            {
-                return get<ElementModP *>(a)->toHex();
-            }
-            case ELEMENTMODQ_PTR: // ElementModQ *
-            {
-                return get<ElementModQ *>(a)->toHex();
-            }
-            case CRYPTOHASHABLE_REF: // reference_wrapper<CryptoHashable>
-            {
-                auto hashable = get<reference_wrapper<CryptoHashable>>(a).get().crypto_hash();
-                return hashable->toHex();
-                //Log::debug("input string: " + input_string);
-            }
-            case ELEMENTMODP_REF: // reference_wrapper<ElementModP>
-            {
-                return get<reference_wrapper<ElementModP>>(a).get().toHex();
-            }
-            case ELEMENTMODQ_REF: // reference_wrapper<ElementModQ>
-            {
-                return get<reference_wrapper<ElementModQ>>(a).get().toHex();
-            }
-            case CRYPTOHASHABLE_CONST_REF: // reference_wrapper<const CryptoHashable>
-            {
-                auto hashable = get<reference_wrapper<const CryptoHashable>>(a).get().crypto_hash();
-                return hashable->toHex();
-            }
-            case ELEMENTMODP_CONST_REF: // reference_wrapper<const ElementModP>
-            {
-                return get<reference_wrapper<const ElementModP>>(a).get().toHex();
-            }
-            case ELEMENTMODQ_CONST_REF: // reference_wrapper<const ElementModQ>
-            {
-                return get<reference_wrapper<const ElementModQ>>(a).get().toHex();
-            }
-            case UINT64_T: // uint64_t
-            {
-                uint64_t i = get<uint64_t>(a);
-                if (i != 0) {
-                    return to_string(i);
-                }
-                return null_string;
-            }
-            case STRING: // string
-            {
-                auto hashable = get<string>(a);
-                if (hashable.empty()) {
-                    return null_string;
+        if (a == nullptr || *a == '\0') {
+            append(nullptr);
+            return;
+        }
+        appendString(a, strlen(a));
+    }
+
+    void HashStream::append(const vector<uint8_t> &a) { appendHex(a.data(), a.size()); }
+
+    void HashStream::finish(uint64_t (&result)[MAX_Q_LEN])
+    {
+        uint8_t digest[MAX_Q_SIZE] = {};
+        sha256_finish(static_cast<const uint32_t *>(blockState),
+                      static_cast<const uint8_t *>(buffer), totalLength,
+                      static_cast<uint8_t *>(digest));
+        reduceDigest(static_cast<const uint8_t *>(digest), result);
+    }
+
+    unique_ptr<ElementModQ> HashStream::finish()
+    {
+        uint64_t result[MAX_Q_LEN] = {};
+        finish(result);
+        return make_unique<ElementModQ>(result, true);
+    }
+
+    vector<unique_ptr<ElementModQ>> HashStream::finishBatch(const vector<HashStream> &streams)
+    {
+        // pad the bytes that every stream has not compressed yet into one or two final blocks,
+        // which are compressed into copies of the states so the streams are left unchanged
+        auto count = streams.size();
+        vector<uint8_t> blocks(count * 2 * SHA256_BLOCK_SIZE, 0);
+        vector<size_t> blockCounts(count);
+        vector<uint32_t> blockStates(count * 8);
+        for (size_t i = 0; i < count; i++) {
+            const auto &stream = streams[i];
+            std::copy(std::begin(stream.blockState), std::end(stream.blockState),
+                      &blockStates[i * 8]);
+            blockCounts[i] = sha256_pad(static_cast<const uint8_t *>(stream.buffer),
+                                        stream.totalLength, &blocks[i * 2 * SHA256_BLOCK_SIZE]);
+        }
+
+        // compress the first final block of every stream, then the second of those that have one
+        vector<uint32_t *> states;
+        vector<const uint8_t *> laneBlocks;
+        states.reserve(count);
+        laneBlocks.reserve(count);
+        for (size_t round = 0; round < 2; round++) {
+            states.clear();
+            laneBlocks.clear();
+            for (size_t i = 0; i < count; i++) {
+                if (blockCounts[i] > round) {
+                    states.push_back(&blockStates[i * 8]);
+                    laneBlocks.push_back(&blocks[(i * 2 + round) * SHA256_BLOCK_SIZE]);
                 }
-                return hashable;
-            }
-            case VECTOR_CRYPTOHASHABLE_PTR: // vector<CryptoHashable *>
-            {
-                return hash_inner_vector<CryptoHashable *>(get<vector<CryptoHashable *>>(a));
-            }
-            case VECTOR_ELEMENTMODP_PTR: // vector<ElementModP *>
-            {
-                return hash_inner_vector<ElementModP *>(get<vector<ElementModP *>>(a));
-            }
-            case VECTOR_ELEMENTMODQ_PTR: // vector<ElementModQ *>
-            {
-                return hash_inner_vector<ElementModQ *>(get<vector<ElementModQ *>>(a));
-            }
-            case VECTOR_CRYPTOHASHABLE_REF: // vector<reference_wrapper<CryptoHashable>>
-            {
-                return hash_inner_vector<reference_wrapper<CryptoHashable>>(
-                  get<vector<reference_wrapper<CryptoHashable>>>(a));
-            }
-            case VECTOR_ELEMENTMODP_REF: // vector<reference_wrapper<ElementModP>>
-            {
-                return hash_inner_vector<reference_wrapper<ElementModP>>(
-                  get<vector<reference_wrapper<ElementModP>>>(a));
             }
-            case VECTOR_ELEMENTMODQ_REF: // vector<reference_wrapper<ElementModQ>>
-            {
-                return hash_inner_vector<reference_wrapper<ElementModQ>>(
-                  get<vector<reference_wrapper<ElementModQ>>>(a));
-            }
-            case VECTOR_CRYPTOHASHABLE_CONST_REF: // vector<reference_wrapper<const CryptoHashable>>
-            {
-                return hash_inner_vector<reference_wrapper<const CryptoHashable>>(
-                  get<vector<reference_wrapper<const CryptoHashable>>>(a));
-            }
-            case VECTOR_ELEMENTMODP_CONST_REF: // vector<reference_wrapper<const ElementModP>>
-            {
-                return hash_inner_vector<reference_wrapper<const ElementModP>>(
-                  get<vector<reference_wrapper<const ElementModP>>>(a));
-            }
-            case VECTOR_ELEMENTMODQ_CONST_REF: // vector<reference_wrapper<const ElementModQ>>
-            {
-                return hash_inner_vector<reference_wrapper<const ElementModQ>>(
-                  get<vector<reference_wrapper<const ElementModQ>>>(a));
-            }
-            case VECTOR_UINT64_T: // vector<uint64_t>
-            {
-                return hash_inner_vector<uint64_t>(get<vector<uint64_t>>(a));
-            }
-            case VECTOR_STRING: // vector<string>
-            {
-                return hash_inner_vector<string>(get<vector<string>>(a));
+            sha256_compress_lanes(static_cast<uint32_t>(states.size()), states.data(),
+                                  laneBlocks.data());
+        }
+
+        vector<unique_ptr<ElementModQ>> results;
+        results.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            uint8_t digest[MAX_Q_SIZE] = {};
+            sha256_digest(&blockStates[i * 8], static_cast<uint8_t *>(digest));
+            uint64_t result[MAX_Q_LEN] = {};
+            reduceDigest(static_cast<const uint8_t *>(digest), result);
+            results.push_back(make_unique<ElementModQ>(result, true));
+        }
+        return results;
+    }
+
+    void HashStream::update(const void *data, size_t size)
+    {
+        sha256_update(static_cast<uint32_t *>(blockState), static_cast<uint8_t *>(buffer),
+                      totalLength, static_cast<const uint8_t *>(data), size);
+    }
+
+    void HashStream::appendString(const char *data, size_t size)
+    {
+        update(data, size);
+        update(&delimiter_char, sizeof(delimiter_char));
+    }
+
+    void HashStream::appendHex(const uint64_t *limbs, size_t count)
+    {
+        // the big endian bytes of the little endian limbs
+        uint8_t bytes[MAX_P_SIZE];
+        for (size_t i = 0; i < count; i++) {
+            auto limb = limbs[count - 1 - i];
+            for (size_t j = 0; j < sizeof(uint64_t); j++) {
+                bytes[i * sizeof(uint64_t) + j] =
+                  static_cast<uint8_t>(limb >> (8 * (sizeof(uint64_t) - 1 - j)));
             }
-            case VECTOR_UINT8_T: // vector<string>
-            {
-                vector<uint8_t> temp = get<vector<uint8_t>>(a);
-                return vector_uint8_t_to_hex(temp);
+        }
+        appendHex(static_cast<const uint8_t *>(bytes), count * sizeof(uint64_t));
+    }
+
+    void HashStream::appendHex(const uint8_t *bytes, size_t size)
+    {
+        // leading zero bytes are not encoded, and a value without other bytes is 00
+        size_t first = 0;
+        while (first < size && bytes[first] == 0) {
+            first++;
+        }
+        if (first == size) {
+            appendString("00", 2);
+            return;
+        }
+
+        char hex[HASH_HEX_CHUNK * 2];
+        for (auto i = first; i < size; i += HASH_HEX_CHUNK) {
+            auto chunk = std::min(HASH_HEX_CHUNK, size - i);
+            for (size_t j = 0; j < chunk; j++) {
+                hex[2 * j] = hex_digits[bytes[i + j] >> 4];
+                hex[2 * j + 1] = hex_digits[bytes[i + j] & 0x0F];
             }
-                
+            update(static_cast<const char *>(hex), chunk * 2);
         }
+        update(&delimiter_char, sizeof(delimiter_char));
+    }
+
+#pragma endregion
+
+#pragma region HashPrefix
+
+    class HashPrefix::Impl
+    {
+      public:
+        HashStream stream;
+    };
+
+    HashPrefix::HashPrefix() : pimpl(new Impl()) {}
 
-        return null_string;
+    HashPrefix::HashPrefix(const vector<CryptoHashableType> &prefix) : pimpl(new Impl())
+    {
+        for (const CryptoHashableType &item : prefix) {
+            pimpl->stream.append(item);
+        }
+    }
+
+    HashPrefix::HashPrefix(const HashPrefix &other) : pimpl(new Impl(*other.pimpl)) {}
+
+    HashPrefix::HashPrefix(HashPrefix &&other) noexcept : pimpl(std::move(other.pimpl)) {}
+
+    HashPrefix::~HashPrefix() = default;
+
+    HashPrefix &HashPrefix::operator=(HashPrefix rhs)
+    {
+        swap(pimpl, rhs.pimpl);
+        return *this;
     }
 
-    void push_hash_update(Hacl_Streaming_SHA2_state_sha2_224 *p, CryptoHashableType a)
+    unique_ptr<ElementModQ> HashPrefix::hash(const vector<CryptoHashableType> &suffix) const
     {
-        string input_string = get_hash_string(a);
-        const auto *input = reinterpret_cast<const uint8_t *>(input_string.c_str());
-        Hacl_Streaming_SHA2_update_256(p, const_cast<uint8_t *>(input), input_string.size());
-        Hacl_Streaming_SHA2_update_256(p, static_cast<uint8_t *>(delimiter), sizeof(delimiter));
+        auto stream = begin();
+        for (const CryptoHashableType &item : suffix) {
+            stream.append(item);
+        }
+        return stream.finish();
     }
+
+    HashStream HashPrefix::begin() const { return pimpl->stream; }
+
+#pragma endregion
+
 } // namespace electionguard
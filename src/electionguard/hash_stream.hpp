@@ -0,0 +1,120 @@
+#ifndef __ELECTIONGUARD_CPP_HASH_STREAM_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_HASH_STREAM_HPP_INCLUDED__
+
+#include <cstddef>
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+#include <electionguard/hash.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace electionguard
+{
+    /// <Summary>
+    /// Writes the byte stream of `hash_elems` straight into SHA-256.
+    ///
+    /// Every element is encoded as its string form followed by the delimiter `|`,
+    /// after a leading delimiter: elements as upper case hex without leading zero bytes,
+    /// non-zero integers in decimal, and empty values as `null`. A non-empty vector is
+    /// encoded as the hex of the hash of its elements. The hex is written from the limbs
+    /// through a buffer on the stack and the SHA-256 state lives on the stack,
+    /// so hashing does not allocate. A copy of a stream continues from the same midstate.
+    /// </Summary>
+    class EG_INTERNAL_API HashStream
+    {
+      public:
+        HashStream();
+
+        /// <Summary>
+        /// append one element followed by the delimiter
+        /// </Summary>
+        void append(const CryptoHashableType &a);
+
+        void append(std::nullptr_t);
+        void append(CryptoHashable &a);
+        void append(const CryptoHashable &a);
+        void append(const ElementModP &a);
+        void append(const ElementModQ &a);
+        void append(uint64_t a);
+        void append(const std::string &a);
+        void append(const char *a);
+        void append(const std::vector<uint8_t> &a);
+
+        template <typename T> void append(T *a) { append(*a); }
+        template <typename T> void append(const std::reference_wrapper<T> &a) { append(a.get()); }
+
+        template <typename T> void append(const std::vector<T> &a)
+        {
+            if (a.empty()) {
+                append(nullptr);
+                return;
+            }
+
+            HashStream inner;
+            for (const auto &item : a) {
+                inner.append(item);
+            }
+            uint64_t digest[MAX_Q_LEN] = {};
+            inner.finish(digest);
+            appendHex(static_cast<const uint64_t *>(digest), MAX_Q_LEN);
+        }
+
+        /// <Summary>
+        /// write the digest reduced into [0, q-1]
+        /// </Summary>
+        void finish(uint64_t (&result)[MAX_Q_LEN]);
+        std::unique_ptr<ElementModQ> finish();
+
+        /// <Summary>
+        /// Finish every stream exactly like `finish`, but the final blocks of the streams
+        /// are compressed together, as many at once as the processor has SIMD lanes.
+        /// </Summary>
+        static std::vector<std::unique_ptr<ElementModQ>>
+        finishBatch(const std::vector<HashStream> &streams);
+
+      private:
+        void update(const void *data, size_t size);
+        void appendString(const char *data, size_t size);
+        void appendHex(const uint64_t *limbs, size_t count);
+        void appendHex(const uint8_t *bytes, size_t size);
+
+        // the sha-256 state, the bytes of the incomplete block and the message length
+        uint32_t blockState[8];
+        uint8_t buffer[64];
+        uint64_t totalLength;
+    };
+
+    /// <Summary>
+    /// Calculate the cryptographic hash of the elements exactly like `hash_elems({a...})`,
+    /// but the encoding of every argument is selected at compile time, so the arguments
+    /// are neither copied into a vector nor dispatched as a `CryptoHashableType`.
+    /// </Summary>
+    template <typename... Ts> std::unique_ptr<ElementModQ> hash_elems(const Ts &...a)
+    {
+        HashStream stream;
+        if constexpr (sizeof...(Ts) == 0) {
+            stream.append(nullptr);
+        } else {
+            (stream.append(a), ...);
+        }
+        return stream.finish();
+    }
+
+    /// <Summary>
+    /// Calculate the hash of the prefix followed by the suffix exactly like
+    /// `prefix.hash({suffix...})`, with the encoding of every argument selected
+    /// at compile time like the variadic `hash_elems`.
+    /// </Summary>
+    template <typename... Ts>
+    std::unique_ptr<ElementModQ> hash_elems(const HashPrefix &prefix, const Ts &...suffix)
+    {
+        static_assert(sizeof...(Ts) > 0, "the suffix must have at least one element");
+        auto stream = prefix.begin();
+        (stream.append(suffix), ...);
+        return stream.finish();
+    }
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_HASH_STREAM_HPP_INCLUDED__ */
@@ -1,8 +1,8 @@
 #include "electionguard/hmac.hpp"
 
 #include "../karamel/Lib_Memzero0.h"
-#include "../karamel/internal/Hacl_HMAC.h"
 #include "log.hpp"
+#include "sha256.hpp"
 
 #include <iomanip>
 #include <iostream>
@@ -36,9 +36,9 @@ namespace electionguard
         }
 
         // calculate the hmac and then zeroize the buffer holding the data we hmaced
-        Hacl_HMAC_compute_sha2_256(&hmac.front(), &key.front(), key.size(), &data_to_hmac.front(),
-                                   data_to_hmac.size());
-        Lib_Memzero0_memzero(&data_to_hmac.front(), data_to_hmac.size());
+        hmac_sha256(key.data(), key.size(), data_to_hmac.data(), data_to_hmac.size(),
+                    hmac.data());
+        Lib_Memzero0_memzero(data_to_hmac.data(), data_to_hmac.size());
 
         return hmac;
     }
@@ -0,0 +1,68 @@
+#include "hmac_drbg.hpp"
+
+#include "../karamel/Lib_Memzero0.h"
+
+#include <algorithm>
+#include <cstring>
+
+using std::min;
+using std::vector;
+
+namespace electionguard
+{
+    HmacDrbg::HmacDrbg(const vector<uint8_t> &entropy, const vector<uint8_t> &nonce,
+                       const vector<uint8_t> &personalization)
+        : reseedCounter(1)
+    {
+        memset(key, 0x00, sizeof(key));
+        memset(value, 0x01, sizeof(value));
+
+        vector<uint8_t> seed;
+        seed.reserve(entropy.size() + nonce.size() + personalization.size());
+        seed.insert(seed.end(), entropy.begin(), entropy.end());
+        seed.insert(seed.end(), nonce.begin(), nonce.end());
+        seed.insert(seed.end(), personalization.begin(), personalization.end());
+        update(seed);
+        Lib_Memzero0_memzero(seed.data(), seed.size());
+    }
+
+    HmacDrbg::~HmacDrbg()
+    {
+        Lib_Memzero0_memzero(key, sizeof(key));
+        Lib_Memzero0_memzero(value, sizeof(value));
+    }
+
+    bool HmacDrbg::generate(uint8_t *output, size_t size, const vector<uint8_t> &additionalInput)
+    {
+        if (reseedCounter > HMAC_DRBG_RESEED_INTERVAL) {
+            return false;
+        }
+        if (!additionalInput.empty()) {
+            update(additionalInput);
+        }
+
+        for (size_t written = 0; written < size; written += SHA256_DIGEST_SIZE) {
+            hmac_sha256(key, sizeof(key), value, sizeof(value), value);
+            memcpy(output + written, value, min(SHA256_DIGEST_SIZE, size - written));
+        }
+
+        update(additionalInput);
+        reseedCounter++;
+        return true;
+    }
+
+    void HmacDrbg::update(const vector<uint8_t> &provided)
+    {
+        // key = hmac(key, value || round || provided) and value = hmac(key, value),
+        // a second round only when data is provided
+        vector<uint8_t> input(sizeof(value) + 1 + provided.size());
+        for (uint8_t round = 0; round < (provided.empty() ? 1 : 2); round++) {
+            memcpy(input.data(), value, sizeof(value));
+            input[sizeof(value)] = round;
+            std::copy(provided.begin(), provided.end(), input.begin() + sizeof(value) + 1);
+            hmac_sha256(key, sizeof(key), input.data(), input.size(), key);
+            hmac_sha256(key, sizeof(key), value, sizeof(value), value);
+        }
+        Lib_Memzero0_memzero(input.data(), input.size());
+    }
+} // namespace electionguard
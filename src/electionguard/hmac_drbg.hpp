@@ -0,0 +1,53 @@
+#ifndef __ELECTIONGUARD_CPP_HMAC_DRBG_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_HMAC_DRBG_HPP_INCLUDED__
+
+#include "sha256.hpp"
+
+#include <cstdint>
+#include <electionguard/export.h>
+#include <vector>
+
+namespace electionguard
+{
+    /// <summary>
+    /// the number of requests an instantiation serves before it must be reseeded,
+    /// the interval of the HACL* HMAC_DRBG
+    /// </summary>
+    const uint64_t HMAC_DRBG_RESEED_INTERVAL = 1024U;
+
+    /// <summary>
+    /// The HMAC_DRBG of NIST SP 800-90A with HMAC-SHA256, on the selected `Sha256Kernel`.
+    ///
+    /// It produces the same bits as the HACL* HMAC_DRBG for the same inputs.
+    /// The key and the value are zeroized when the generator is destroyed.
+    /// Please refer to the NIST publication for more information:
+    /// https://nvlpubs.nist.gov/nistpubs/SpecialPublications/NIST.SP.800-90Ar1.pdf
+    /// </summary>
+    class EG_INTERNAL_API HmacDrbg
+    {
+      public:
+        HmacDrbg(const std::vector<uint8_t> &entropy, const std::vector<uint8_t> &nonce,
+                 const std::vector<uint8_t> &personalization);
+        HmacDrbg(const HmacDrbg &) = delete;
+        HmacDrbg &operator=(const HmacDrbg &) = delete;
+        ~HmacDrbg();
+
+        /// <summary>
+        /// Write `size` pseudo-random bytes in `output`.
+        /// Returns false without writing when the generator must be reseeded.
+        /// </summary>
+        bool generate(uint8_t *output, size_t size, const std::vector<uint8_t> &additionalInput);
+
+      private:
+        /// <summary>
+        /// The HMAC_DRBG update function, which mixes the provided data into the key and the value
+        /// </summary>
+        void update(const std::vector<uint8_t> &provided);
+
+        uint8_t key[SHA256_DIGEST_SIZE];
+        uint8_t value[SHA256_DIGEST_SIZE];
+        uint64_t reseedCounter;
+    };
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_HMAC_DRBG_HPP_INCLUDED__ */
@@ -2,17 +2,31 @@
 #define __ELECTIONGUARD_CPP_LOOKUP_TABLE_HPP_INCLUDED__
 
 #include "async.hpp"
+#include "embedded_table.hpp"
 #include "facades/Hacl_Bignum256.hpp"
 #include "facades/Hacl_Bignum4096.hpp"
+#include "mapped_file.hpp"
+#include "sha256.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
 #include <electionguard/constants.h>
 #include <electionguard/export.h>
+#include <electionguard/group.hpp>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <future>
+#include <iterator>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
 
 using hacl::Bignum256;
 using hacl::Bignum4096;
@@ -24,6 +38,240 @@ using std::unique_ptr;
 
 namespace electionguard
 {
+    /// <summary>
+    /// The header of a serialized lookup table file.
+    ///
+    /// The table values follow the header starting at LUT_FILE_HEADER_SIZE
+    /// so they are page aligned when the file is memory mapped.
+    /// The digest binds the file to the table shape, the group parameters and the base,
+    /// a file built for anything else is rejected when it is loaded.
+    /// The body digest covers the table values, so a corrupted file is rejected as well.
+    /// </summary>
+    struct LookupTableFileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t windowSize;
+        uint32_t orderBits;
+        uint32_t tableLength;
+        uint32_t limbCount;
+        uint32_t reserved;
+        uint64_t tableSize;
+        uint8_t digest[32];
+        uint8_t bodyDigest[32];
+    };
+
+    /// <summary>
+    /// The widest window whose table is read under masks for a constant time exponentiation.
+    /// Scanning a row of a wider table costs more than a constant time exponentiation
+    /// without a table, so constant time exponentiations do not use those tables.
+    /// </summary>
+    const uint64_t LUT_MASKED_MAX_WINDOW_SIZE = 10U;
+
+    const char LUT_FILE_MAGIC[8] = {'E', 'G', 'L', 'U', 'T', 'A', 'B', 'L'};
+    const uint32_t LUT_FILE_VERSION = 2U;
+    const uint64_t LUT_FILE_HEADER_SIZE = 4096U;
+
+    /// <summary>
+    /// Ask the cpu to start loading a table entry into the cache
+    /// </summary>
+    inline void prefetchEntry(const uint64_t *entry)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        const uint64_t CACHE_LINE_LIMBS = 64 / sizeof(uint64_t);
+        for (uint64_t i = 0; i < MAX_P_LEN; i += CACHE_LINE_LIMBS) {
+            __builtin_prefetch(entry + i, 0, 3);
+        }
+#else
+        (void)entry;
+#endif
+    }
+
+    /// <summary>
+    /// The operations shared by the lookup tables of every geometry,
+    /// so that tables with different window sizes can be held side by side.
+    /// </summary>
+    class EG_INTERNAL_API FixedBaseTable
+    {
+      public:
+        virtual ~FixedBaseTable() {}
+
+        /// <summary>
+        /// the number of exponent bits consumed by each row of the table
+        /// </summary>
+        virtual uint64_t windowSize() const = 0;
+
+        /// <summary>
+        /// the number of bytes occupied by the table values
+        /// </summary>
+        virtual uint64_t byteSize() const = 0;
+
+        /// <summary>
+        /// calcuate pow_mod_p using the precomputed fixed base, writing the power to result
+        /// </summary>
+        virtual void pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN],
+                               uint64_t (&result)[MAX_P_LEN]) const = 0;
+
+        /// <summary>
+        /// calcuate pow_mod_p using the precomputed fixed base.
+        /// </summary>
+        std::vector<uint64_t> pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN]) const
+        {
+            uint64_t result[MAX_P_LEN] = {};
+            pow_mod_p(exponent, result);
+            return std::vector<uint64_t>(begin(result), end(result));
+        }
+
+        /// <summary>
+        /// Write the table to a file that can be memory mapped by `load`
+        /// </summary>
+        virtual void save(const std::string &path, const uint64_t (&base)[MAX_P_LEN]) const = 0;
+
+        /// <summary>
+        /// the number of rows, each consuming `windowSize` bits of the exponent
+        /// </summary>
+        virtual uint64_t rowCount() const = 0;
+
+        /// <summary>
+        /// the entry in montgomery form selected by the exponent slice of the row,
+        /// nullptr when the slice is zero
+        /// </summary>
+        virtual const uint64_t *sliceEntry(const uint64_t (&exponent)[MAX_Q_LEN],
+                                           uint64_t row) const = 0;
+
+        /// <summary>
+        /// copy the entry in montgomery form selected by the exponent slice of the row,
+        /// one when the slice is zero. every entry of the row is read and only the
+        /// selected one passes its mask, so the memory accesses do not depend on the exponent.
+        /// </summary>
+        virtual void maskedSliceEntry(const uint64_t (&exponent)[MAX_Q_LEN], uint64_t row,
+                                      uint64_t (&selected)[MAX_P_LEN]) const = 0;
+
+        /// <summary>
+        /// calcuate pow_mod_p using the precomputed fixed base without branches or memory
+        /// accesses that depend on the exponent, for secret exponents.
+        /// every row is scanned under masks and multiplied, zero slices included.
+        /// </summary>
+        void constant_time_pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN],
+                                     uint64_t (&result)[MAX_P_LEN]) const
+        {
+            uint64_t montgomery_result[MAX_P_LEN] = {};
+            uint64_t selected[MAX_P_LEN] = {};
+            CONTEXT_P().montgomery_one(static_cast<uint64_t *>(montgomery_result));
+            for (uint64_t row = 0; row < rowCount(); row++) {
+                maskedSliceEntry(exponent, row, selected);
+                CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+                  montgomery_result, static_cast<uint64_t *>(selected), montgomery_result);
+            }
+            CONTEXT_P().from_montgomery_form(montgomery_result, result);
+        }
+
+        /// <summary>
+        /// whether the table serves exponentiations with the policy. secret exponents
+        /// are only served under masks with the masked window implementation.
+        /// </summary>
+        bool serves(ExponentiationPolicy policy) const
+        {
+            return policy == ExponentiationPolicy::variableTime ||
+                   (get_constant_time_implementation() ==
+                      ConstantTimeImplementation::maskedWindow &&
+                    windowSize() <= LUT_MASKED_MAX_WINDOW_SIZE);
+        }
+
+        /// <summary>
+        /// calcuate pow_mod_p using the precomputed fixed base following the policy,
+        /// the table is read under masks unless the exponent is public.
+        /// returns false without a result when the table does not serve the policy.
+        /// </summary>
+        bool pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN], uint64_t (&result)[MAX_P_LEN],
+                       ExponentiationPolicy policy) const
+        {
+            if (!serves(policy)) {
+                return false;
+            }
+            if (policy == ExponentiationPolicy::variableTime) {
+                pow_mod_p(exponent, result);
+            } else {
+                constant_time_pow_mod_p(exponent, result);
+            }
+            return true;
+        }
+
+        /// <summary>
+        /// calcuate pow_mod_p of several fixed bases with the same exponent.
+        ///
+        /// the tables must have the same window size. the rows are walked once for
+        /// all the tables. a public exponent prefetches the next entry while multiplying
+        /// the current one, a secret exponent reads every row of every table under masks.
+        /// </summary>
+        static std::vector<std::vector<uint64_t>>
+        pow_mod_p_shared_exponent(const std::vector<std::shared_ptr<FixedBaseTable>> &tables,
+                                  uint64_t (&exponent)[MAX_Q_LEN], ExponentiationPolicy policy)
+        {
+            auto count = tables.size();
+            std::vector<uint64_t> montgomery_results(count * MAX_P_LEN);
+            uint64_t one[MAX_P_LEN] = {};
+            CONTEXT_P().montgomery_one(static_cast<uint64_t *>(one));
+            for (size_t i = 0; i < count; i++) {
+                copy(begin(one), end(one), montgomery_results.data() + i * MAX_P_LEN);
+            }
+
+            if (policy == ExponentiationPolicy::constantTime) {
+                uint64_t selected[MAX_P_LEN] = {};
+                for (uint64_t row = 0; count > 0 && row < tables[0]->rowCount(); row++) {
+                    for (size_t i = 0; i < count; i++) {
+                        auto *result = montgomery_results.data() + i * MAX_P_LEN;
+                        tables[i]->maskedSliceEntry(exponent, row, selected);
+                        CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+                          result, static_cast<uint64_t *>(selected), result);
+                    }
+                }
+                return fromMontgomery(montgomery_results, count);
+            }
+
+            std::vector<std::pair<size_t, const uint64_t *>> entries;
+            entries.reserve(count * (count > 0 ? tables[0]->rowCount() : 0));
+            for (uint64_t row = 0; count > 0 && row < tables[0]->rowCount(); row++) {
+                for (size_t i = 0; i < count; i++) {
+                    if (auto *entry = tables[i]->sliceEntry(exponent, row)) {
+                        entries.emplace_back(i, entry);
+                    }
+                }
+            }
+
+            for (size_t k = 0; k < entries.size(); k++) {
+                if (k + 1 < entries.size()) {
+                    prefetchEntry(entries[k + 1].second);
+                }
+                auto *result = montgomery_results.data() + entries[k].first * MAX_P_LEN;
+                CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+                  result, const_cast<uint64_t *>(entries[k].second), result);
+            }
+            return fromMontgomery(montgomery_results, count);
+        }
+
+      protected:
+        /// <summary>
+        /// all ones when the values are equal and zero otherwise, without a branch
+        /// </summary>
+        static uint64_t equalMask(uint64_t lhs, uint64_t rhs)
+        {
+            uint64_t difference = lhs ^ rhs;
+            return ((difference | (0 - difference)) >> 63) - 1;
+        }
+
+      private:
+        static std::vector<std::vector<uint64_t>>
+        fromMontgomery(std::vector<uint64_t> &montgomery_results, size_t count)
+        {
+            std::vector<std::vector<uint64_t>> results(count, std::vector<uint64_t>(MAX_P_LEN));
+            for (size_t i = 0; i < count; i++) {
+                CONTEXT_P().from_montgomery_form(montgomery_results.data() + i * MAX_P_LEN,
+                                                 results[i].data());
+            }
+            return results;
+        }
+    };
+
     /// <summary>
     /// A fixed-base lookup tables used to precompute components for exponentiation.
     ///
@@ -33,90 +281,270 @@ namespace electionguard
     /// when executing a `pow_mod_p` operation, the exponent is sliced into k-bits
     /// and each slice is multiplied together using the values precomputed in the lookup table
     ///
-    /// note this implementation is tuned sepcifically for the following values:
+    /// the order bits must be 2^k and the table must have enough rows to cover
+    /// every bit of the exponent, the last slice is padded with zero bits when k
+    /// does not divide 256. the default geometry is:
     /// b order bits = 256
     /// k window size = 8
     /// m table length = 32
     ///
-    /// any changes to these values may impact the internal operation of the functions.
+    /// The table values are either generated into memory owned by the table
+    /// or read from a memory mapped file produced by `save`.
+    /// When generated in parallel, the base of every row is computed first
+    /// and the rows are then filled concurrently on the Scheduler.
+    ///
+    /// Generated tables are aligned to huge pages. The tables of several bases can share
+    /// one block of memory with their entries interleaved, so that the entries of every
+    /// base for the same row and slice are adjacent.
     /// </summary>
     template <uint64_t WindowSize, uint64_t OrderBits, uint64_t TableLength>
-    class EG_INTERNAL_API LookupTable
+    class EG_INTERNAL_API LookupTable : public FixedBaseTable
     {
-        typedef std::array<std::array<uint64_t[MAX_P_LEN], OrderBits>, TableLength> FixedBaseTable;
+        static_assert(WindowSize > 0 && WindowSize < 64, "unsupported window size");
+        static_assert(OrderBits == 1ULL << WindowSize, "order bits must be 2^WindowSize");
+        static_assert(TableLength * WindowSize >= MAX_Q_LEN * 64,
+                      "the table must cover every bit of the exponent");
+
+        // the number of limbs in the table
+        static constexpr uint64_t TableSize = TableLength * OrderBits * MAX_P_LEN;
 
       public:
-        explicit LookupTable(uint64_t *base) { generateTable(base, MAX_P_LEN); }
+        explicit LookupTable(uint64_t *base, bool parallel = false,
+                             LookupTableHugePages hugePages = LookupTableHugePages::transparent)
+            : _storage(std::make_shared<MappedMemory>(sizeInBytes(), hugePages))
+        {
+            generateTable(base, parallel);
+        }
 
         /// <summary>
-        /// calcuate pow_mod_p using the precomputed fixed base.
+        /// generate the tables of the bases into one block of memory
+        /// with the entries of the bases interleaved
         /// </summary>
-        std::vector<uint64_t> pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN]) const
+        static std::vector<std::shared_ptr<LookupTable>>
+        interleave(const std::vector<uint64_t *> &bases, bool parallel = false,
+                   LookupTableHugePages hugePages = LookupTableHugePages::transparent)
+        {
+            auto storage = std::make_shared<MappedMemory>(sizeInBytes() * bases.size(), hugePages);
+            std::vector<std::shared_ptr<LookupTable>> tables;
+            for (size_t lane = 0; lane < bases.size(); lane++) {
+                tables.emplace_back(new LookupTable(storage, bases.size(), lane));
+                tables.back()->generateTable(bases[lane], parallel);
+            }
+            return tables;
+        }
+
+        /// <summary>
+        /// the number of bytes occupied by the table values
+        /// </summary>
+        static constexpr uint64_t sizeInBytes() { return TableSize * sizeof(uint64_t); }
+
+        uint64_t windowSize() const override { return WindowSize; }
+
+        uint64_t byteSize() const override { return sizeInBytes(); }
+
+        uint64_t rowCount() const override { return TableLength; }
+
+        const uint64_t *sliceEntry(const uint64_t (&exponent)[MAX_Q_LEN],
+                                   uint64_t row) const override
+        {
+            auto slice = exponentSlice(exponent, row);
+            return slice == 0 ? nullptr : entry(row, slice);
+        }
+
+        void maskedSliceEntry(const uint64_t (&exponent)[MAX_Q_LEN], uint64_t row,
+                              uint64_t (&selected)[MAX_P_LEN]) const override
+        {
+            auto slice = exponentSlice(exponent, row);
+
+            // column zero is not stored, its value is one
+            auto mask = equalMask(slice, 0);
+            for (uint64_t i = 0; i < MAX_P_LEN; i++) {
+                selected[i] = one_in_montgomery_form[i] & mask;
+            }
+            for (uint64_t j = 1; j < OrderBits; j++) {
+                mask = equalMask(slice, j);
+                const auto *values = entry(row, j);
+                for (uint64_t i = 0; i < MAX_P_LEN; i++) {
+                    selected[i] |= values[i] & mask;
+                }
+            }
+        }
+
+        using FixedBaseTable::pow_mod_p;
+
+        /// <summary>
+        /// calcuate pow_mod_p using the precomputed fixed base, writing the power to result
+        /// </summary>
+        void pow_mod_p(uint64_t (&exponent)[MAX_Q_LEN],
+                       uint64_t (&result)[MAX_P_LEN]) const override
         {
             uint64_t montgomery_result[MAX_P_LEN] = {};
-            uint64_t result[MAX_P_LEN] = {};
-            uint8_t exponentBytes[MAX_Q_SIZE] = {};
 
             // copy the 1 in montgomery form into montgomery_result to start
             copy((uint64_t *)one_in_montgomery_form, (uint64_t *)one_in_montgomery_form + MAX_P_LEN,
                  montgomery_result);
 
-            // convert the bignum to byte array
-            // which aligns with the k window size
-            Bignum256::toBytes(static_cast<uint64_t *>(exponent),
-                               static_cast<uint8_t *>(exponentBytes));
-            // reverse the byte order to account for the way hacl offsets its limbs
-            std::reverse(std::begin(exponentBytes), std::end(exponentBytes));
-
             // iterate over rows-m slicing each segment of the exponent
-            // and lookup the table values before executing a mul_mod_p operation
-            for (uint64_t i = 0; i < _lookupTable.size(); i++) {
-                auto slice = exponentBytes[i];
-
-                // skip zero bytes
-                if (slice == 0) {
-                    continue;
+            // and lookup the table values, skipping zero slices
+            const uint64_t *entries[TableLength] = {};
+            uint64_t count = 0;
+            for (uint64_t i = 0; i < TableLength; i++) {
+                auto slice = exponentSlice(exponent, i);
+                if (slice != 0) {
+                    entries[count++] = entry(i, slice);
                 }
+            }
 
-                mul_mod_p_mont(montgomery_result, const_cast<uint64_t *>(_lookupTable[i][slice]),
-                          montgomery_result);
+            // the entries are scattered across the table, so load the next one
+            // while the mul_mod_p operation of the current one runs
+            for (uint64_t i = 0; i < count; i++) {
+                if (i + 1 < count) {
+                    prefetchEntry(entries[i + 1]);
+                }
+                mul_mod_p_mont(montgomery_result, const_cast<uint64_t *>(entries[i]),
+                               montgomery_result);
             }
 
             // convert from montogomery form
             CONTEXT_P().from_montgomery_form(montgomery_result, result);
+        }
 
-            // wrap in a vector for convenience
-            std::vector<uint64_t> vec(begin(result), end(result));
-            return vec;
+        /// <summary>
+        /// Write the table to a file that can be memory mapped by `load`
+        /// </summary>
+        void save(const std::string &path, const uint64_t (&base)[MAX_P_LEN]) const override
+        {
+            auto header = makeHeader(base);
+            digestValues(header.bodyDigest);
+            std::vector<char> padding(LUT_FILE_HEADER_SIZE - sizeof(header), 0);
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("LookupTable:: could not open " + path);
+            }
+            file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+            // the file holds a single table, so interleaved entries are written one by one
+            for (uint64_t i = 0; i < TableLength; i++) {
+                for (uint64_t j = 0; j < OrderBits; j++) {
+                    file.write(reinterpret_cast<const char *>(entry(i, j)),
+                               static_cast<std::streamsize>(MAX_P_SIZE));
+                }
+            }
+            if (!file) {
+                throw std::runtime_error("LookupTable:: could not write " + path);
+            }
         }
 
-      protected:
-        void generateTable(uint64_t *base, uint64_t len)
+        /// <summary>
+        /// Memory map a table written by `save` without regenerating it.
+        ///
+        /// Throws runtime_error when the file was produced for a different base,
+        /// group or table shape, when it is truncated, or when its values do not match
+        /// the body digest or do not chain from the base from one row to the next.
+        /// </summary>
+        static std::unique_ptr<LookupTable> load(const std::string &path,
+                                                 const uint64_t (&base)[MAX_P_LEN])
         {
-            // checking for power of two ensures the table is uniform
-            if (!isPowerOfTwo(WindowSize)) {
-                throw;
+            auto mapping = std::make_unique<MappedFile>(path);
+            if (mapping->size() != LUT_FILE_HEADER_SIZE + sizeInBytes()) {
+                throw std::runtime_error("LookupTable:: unexpected file size for " + path);
             }
 
-            uint64_t row_base[MAX_P_LEN] = {};
-            uint64_t running_base[MAX_P_LEN] = {};
+            LookupTableFileHeader header;
+            memcpy(&header, mapping->data(), sizeof(header));
+            auto expected = makeHeader(base);
+            memcpy(expected.bodyDigest, header.bodyDigest, sizeof(expected.bodyDigest));
+            if (memcmp(&header, &expected, sizeof(header)) != 0) {
+                throw std::runtime_error("LookupTable:: " + path +
+                                         " does not match the base or the group parameters");
+            }
+
+            std::unique_ptr<LookupTable> table(new LookupTable(std::move(mapping)));
+
+            uint8_t bodyDigest[32] = {};
+            table->digestValues(bodyDigest);
+            if (memcmp(bodyDigest, header.bodyDigest, sizeof(bodyDigest)) != 0 ||
+                !table->hasRowBases(base)) {
+                throw std::runtime_error("LookupTable:: " + path + " contains unexpected values");
+            }
+            return table;
+        }
+
+        /// <summary>
+        /// Use table values that outlive the table, such as the table of G linked into
+        /// the library, without copying or regenerating them.
+        ///
+        /// Throws runtime_error when the values were not generated for the base.
+        /// </summary>
+        static std::unique_ptr<LookupTable> view(const uint64_t *values,
+                                                 const uint64_t (&base)[MAX_P_LEN])
+        {
+            std::unique_ptr<LookupTable> table(new LookupTable(values));
+
+            // the first value of the table is the base itself in montgomery form
+            uint64_t baseCopy[MAX_P_LEN] = {};
+            uint64_t baseMontgomery[MAX_P_LEN] = {};
+            copy(begin(base), end(base), baseCopy);
+            CONTEXT_P().to_montgomery_form(baseCopy, baseMontgomery);
+            if (!std::equal(begin(baseMontgomery), end(baseMontgomery), table->entry(0, 1))) {
+                throw std::runtime_error("LookupTable:: the values do not belong to the base");
+            }
+            return table;
+        }
+
+      protected:
+        LookupTable(std::shared_ptr<MappedMemory> storage, uint64_t lanes, uint64_t lane)
+            : _storage(std::move(storage)), _lanes(lanes), _lane(lane)
+        {
+        }
+
+        explicit LookupTable(std::unique_ptr<MappedFile> mapping) : _mapping(std::move(mapping))
+        {
+            _table = reinterpret_cast<const uint64_t *>(_mapping->data() + LUT_FILE_HEADER_SIZE);
             uint64_t one[MAX_P_LEN] = {1UL};
+            CONTEXT_P().to_montgomery_form(one, one_in_montgomery_form);
+        }
 
+        explicit LookupTable(const uint64_t *values) : _table(values)
+        {
+            uint64_t one[MAX_P_LEN] = {1UL};
+            CONTEXT_P().to_montgomery_form(one, one_in_montgomery_form);
+        }
 
-            // convert base to montgomery form
-            CONTEXT_P().to_montgomery_form(base, row_base);
+        void generateTable(uint64_t *base, bool parallel)
+        {
+            uint64_t one[MAX_P_LEN] = {1UL};
+            _table = reinterpret_cast<const uint64_t *>(_storage->data());
 
-            // assign initial values
-            copy(row_base, row_base + len, running_base);
+            // the base of each row is the base of the previous row raised to OrderBits,
+            // so every row can be filled independently once the row bases are known
+            std::vector<uint64_t> rowBases(TableLength * MAX_P_LEN);
+            CONTEXT_P().to_montgomery_form(base, rowBases.data());
+            for (uint64_t i = 1; i < TableLength; i++) {
+                auto *previous = rowBases.data() + (i - 1) * MAX_P_LEN;
+                auto *current = rowBases.data() + i * MAX_P_LEN;
+                copy(previous, previous + MAX_P_LEN, current);
+                for (uint64_t bits = 1; bits < OrderBits; bits <<= 1) {
+                    CONTEXT_P().montgomery_mod_sqr_stay_in_mont_form(current, current);
+                }
+            }
 
-            // iterate over each m-row in the table
-            for (uint64_t i = 0; i < TableLength; i++) {
+            auto fillRow = [this, &rowBases](uint64_t i) {
+                auto *row_base = rowBases.data() + i * MAX_P_LEN;
+                copy(row_base, row_base + MAX_P_LEN, mutableEntry(i, 1));
                 // iterate over each b-bit and compute the table values
-                for (uint64_t j = 1; j < OrderBits; j++) {
-                    copy(begin(running_base), end(running_base), begin(_lookupTable[i][j]));
-                    mul_mod_p_mont(running_base, row_base, running_base);
+                for (uint64_t j = 2; j < OrderBits; j++) {
+                    mul_mod_p_mont(mutableEntry(i, j - 1), row_base, mutableEntry(i, j));
+                }
+            };
+
+            if (parallel) {
+                parallel_for(TableLength, fillRow);
+            } else {
+                for (uint64_t i = 0; i < TableLength; i++) {
+                    fillRow(i);
                 }
-                copy(begin(running_base), end(running_base), begin(row_base));
             }
 
             // also convert 1 to montgomery form and store it because we use it to
@@ -125,22 +553,274 @@ namespace electionguard
             CONTEXT_P().to_montgomery_form(one, one_in_montgomery_form);
         }
 
+        /// <summary>
+        /// the k bits of the exponent selecting the value of the row,
+        /// hacl limbs are little endian so row i starts at bit i * k
+        /// </summary>
+        static uint64_t exponentSlice(const uint64_t (&exponent)[MAX_Q_LEN], uint64_t row)
+        {
+            auto bit = row * WindowSize;
+            auto limb = bit / 64;
+            auto offset = bit % 64;
+            if (limb >= MAX_Q_LEN) {
+                return 0;
+            }
+
+            auto slice = exponent[limb] >> offset;
+            // a slice that is not aligned to the limbs continues in the next limb
+            if (offset + WindowSize > 64 && limb + 1 < MAX_Q_LEN) {
+                slice |= exponent[limb + 1] << (64 - offset);
+            }
+            return slice & (OrderBits - 1);
+        }
+
         void mul_mod_p_mont(uint64_t *lhs, uint64_t *rhs, uint64_t *res) const
         {
             CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(lhs, rhs, res);
         }
+
+        const uint64_t *entry(uint64_t row, uint64_t column) const
+        {
+            return _table + ((row * OrderBits + column) * _lanes + _lane) * MAX_P_LEN;
+        }
+
+        uint64_t *mutableEntry(uint64_t row, uint64_t column)
+        {
+            return const_cast<uint64_t *>(entry(row, column));
+        }
+
+        /// <summary>
+        /// digest the table values in the order they are saved, one row after the other
+        /// </summary>
+        void digestValues(uint8_t (&digest)[32]) const
+        {
+            Sha256 hash;
+            for (uint64_t i = 0; i < TableLength; i++) {
+                for (uint64_t j = 0; j < OrderBits; j++) {
+                    hash.update(reinterpret_cast<const uint8_t *>(entry(i, j)), MAX_P_SIZE);
+                }
+            }
+            hash.finish(digest);
+        }
+
+        /// <summary>
+        /// check that the first value of every row is the base of the row in montgomery form,
+        /// the base itself for the first row and the base of the previous row raised to
+        /// OrderBits for the others
+        /// </summary>
+        bool hasRowBases(const uint64_t (&base)[MAX_P_LEN]) const
+        {
+            uint64_t rowBase[MAX_P_LEN] = {};
+            CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(base), rowBase);
+            for (uint64_t i = 0; i < TableLength; i++) {
+                if (i > 0) {
+                    for (uint64_t bits = 1; bits < OrderBits; bits <<= 1) {
+                        CONTEXT_P().montgomery_mod_sqr_stay_in_mont_form(rowBase, rowBase);
+                    }
+                }
+                if (!std::equal(begin(rowBase), end(rowBase), entry(i, 1))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static LookupTableFileHeader makeHeader(const uint64_t (&base)[MAX_P_LEN])
+        {
+            LookupTableFileHeader header = {};
+            memcpy(header.magic, LUT_FILE_MAGIC, sizeof(header.magic));
+            header.version = LUT_FILE_VERSION;
+            header.windowSize = static_cast<uint32_t>(WindowSize);
+            header.orderBits = static_cast<uint32_t>(OrderBits);
+            header.tableLength = static_cast<uint32_t>(TableLength);
+            header.limbCount = static_cast<uint32_t>(MAX_P_LEN);
+            header.tableSize = sizeInBytes();
+
+            // digest the shape of the table, the group and the base
+            Sha256 hash;
+            auto update = [&hash](const void *data, size_t size) {
+                hash.update(static_cast<const uint8_t *>(data), size);
+            };
+            update(&header, sizeof(header));
+            update(P_ARRAY_REVERSE, sizeof(P_ARRAY_REVERSE));
+            update(Q_ARRAY_REVERSE, sizeof(Q_ARRAY_REVERSE));
+            update(G_ARRAY_REVERSE, sizeof(G_ARRAY_REVERSE));
+            update(base, MAX_P_LEN * sizeof(uint64_t));
+            hash.finish(header.digest);
+            return header;
+        }
+
       private:
-        FixedBaseTable _lookupTable = {};
+        std::shared_ptr<MappedMemory> _storage;
+        std::unique_ptr<MappedFile> _mapping;
+        const uint64_t *_table = nullptr;
+        // the number of interleaved tables sharing the storage and the position of this one
+        uint64_t _lanes = 1;
+        uint64_t _lane = 0;
         uint64_t one_in_montgomery_form[MAX_P_LEN] = {};
     };
 
     typedef LookupTable<LUT_WINDOW_SIZE, LUT_ORDER_BITS, LUT_TABLE_LENGTH> LookupTableType;
 
+    // the compiled geometries, the table length covers the 256 bits of the exponent
+    typedef LookupTable<4, 16, 64> LookupTable4;
+    typedef LookupTable<6, 64, 43> LookupTable6;
+    typedef LookupTable<8, 256, 32> LookupTable8;
+    typedef LookupTable<10, 1024, 26> LookupTable10;
+    typedef LookupTable<12, 4096, 22> LookupTable12;
+
+    /// <summary>
+    /// whether a lookup table geometry is compiled for the window size
+    /// </summary>
+    inline bool isSupportedWindowSize(uint64_t windowSize)
+    {
+        switch (windowSize) {
+            case 4:
+            case 6:
+            case 8:
+            case 10:
+            case 12:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /// <summary>
+    /// generate the lookup table of the base using the geometry of the window size
+    /// </summary>
+    inline std::shared_ptr<FixedBaseTable>
+    makeLookupTable(uint64_t windowSize, uint64_t *base, bool parallel = false,
+                    LookupTableHugePages hugePages = LookupTableHugePages::transparent)
+    {
+        switch (windowSize) {
+            case 4:
+                return std::make_shared<LookupTable4>(base, parallel, hugePages);
+            case 6:
+                return std::make_shared<LookupTable6>(base, parallel, hugePages);
+            case 8:
+                return std::make_shared<LookupTable8>(base, parallel, hugePages);
+            case 10:
+                return std::make_shared<LookupTable10>(base, parallel, hugePages);
+            case 12:
+                return std::make_shared<LookupTable12>(base, parallel, hugePages);
+            default:
+                throw std::invalid_argument("makeLookupTable:: unsupported window size " +
+                                            std::to_string(windowSize));
+        }
+    }
+
+    /// <summary>
+    /// generate the interleaved lookup tables of the bases using the geometry of the window size
+    /// </summary>
+    inline std::vector<std::shared_ptr<FixedBaseTable>>
+    makeInterleavedLookupTables(uint64_t windowSize, const std::vector<uint64_t *> &bases,
+                                bool parallel = false,
+                                LookupTableHugePages hugePages = LookupTableHugePages::transparent)
+    {
+        auto convert = [](auto tables) {
+            return std::vector<std::shared_ptr<FixedBaseTable>>(tables.begin(), tables.end());
+        };
+        switch (windowSize) {
+            case 4:
+                return convert(LookupTable4::interleave(bases, parallel, hugePages));
+            case 6:
+                return convert(LookupTable6::interleave(bases, parallel, hugePages));
+            case 8:
+                return convert(LookupTable8::interleave(bases, parallel, hugePages));
+            case 10:
+                return convert(LookupTable10::interleave(bases, parallel, hugePages));
+            case 12:
+                return convert(LookupTable12::interleave(bases, parallel, hugePages));
+            default:
+                throw std::invalid_argument("makeInterleavedLookupTables:: unsupported window size " +
+                                            std::to_string(windowSize));
+        }
+    }
+
+    /// <summary>
+    /// memory map a lookup table file using the geometry recorded in its header
+    /// </summary>
+    inline std::shared_ptr<FixedBaseTable> loadLookupTable(const std::string &path,
+                                                           const uint64_t (&base)[MAX_P_LEN])
+    {
+        LookupTableFileHeader header = {};
+        std::ifstream file(path, std::ios::binary);
+        if (!file.read(reinterpret_cast<char *>(&header), sizeof(header))) {
+            throw std::runtime_error("LookupTable:: could not read " + path);
+        }
+
+        switch (header.windowSize) {
+            case 4:
+                return LookupTable4::load(path, base);
+            case 6:
+                return LookupTable6::load(path, base);
+            case 8:
+                return LookupTable8::load(path, base);
+            case 10:
+                return LookupTable10::load(path, base);
+            case 12:
+                return LookupTable12::load(path, base);
+            default:
+                throw std::runtime_error("LookupTable:: " + path +
+                                         " has an unsupported window size");
+        }
+    }
+
     /// <summary>
     /// A singleton context for a collection of fixed base lookup tables.
+    ///
+    /// Tables are generated for bases flagged as fixed bases and, when promotion is enabled,
+    /// for bases that are exponentiated about `promotionThreshold` times. Uses are counted
+    /// without a lock in a fixed number of slots, and a promoted table is generated on the
+    /// Scheduler rather than by the caller that crossed the threshold. The least recently
+    /// used tables are evicted whenever the tables occupy more than `byteBudget` bytes,
+    /// a table is rebuilt if its base is used again after it was evicted.
+    ///
+    /// Tables are keyed by a digest of the limbs of the base and the full base is compared
+    /// on lookup. The collection of tables is an immutable map that is replaced on every
+    /// change, which advances an epoch. Each thread keeps its own reference to the map and
+    /// only reloads it when the epoch moved, so finding a table takes no lock and the use of
+    /// a table is recorded at most once per epoch. A thread holds on to the tables of its
+    /// last map, evicted ones included, until it looks up a table again, when a stale map is
+    /// dropped, and the workers of the Scheduler release theirs whenever they go idle.
+    /// The memory of evicted tables is therefore returned once the threads that used them
+    /// move on, rather than when each of them next happens to use a table. When several
+    /// callers need the same missing table, one of them builds it while the others wait.
+    /// Tables use the default geometry unless another window size is selected for the base.
+    /// The table of G is not generated when the library is built with the embedded table,
+    /// the linked values are used instead.
     /// </summary>
     class EG_INTERNAL_API LookupTableContext
     {
+        struct TableEntry {
+            std::array<uint64_t, MAX_P_LEN> base;
+            std::shared_ptr<FixedBaseTable> table;
+            mutable std::atomic<uint64_t> lastUsed;
+
+            ~TableEntry()
+            {
+                if (table != nullptr) {
+                    residentBytes().fetch_sub(table->byteSize(), std::memory_order_relaxed);
+                }
+            }
+        };
+
+        struct PendingEntry {
+            std::array<uint64_t, MAX_P_LEN> base;
+            std::shared_future<std::shared_ptr<FixedBaseTable>> table;
+        };
+
+        typedef std::unordered_multimap<uint64_t, std::shared_ptr<const TableEntry>> TableMap;
+
+        /// <summary>
+        /// the tables held by the calling thread and the epoch they were published in
+        /// </summary>
+        struct Snapshot {
+            uint64_t epoch = 0;
+            std::shared_ptr<const TableMap> tables;
+        };
+
       public:
         LookupTableContext(const LookupTableContext &) = delete;
         LookupTableContext(LookupTableContext &&) = delete;
@@ -148,7 +828,7 @@ namespace electionguard
         LookupTableContext &operator=(LookupTableContext &&) = delete;
 
       private:
-        LookupTableContext() {}
+        LookupTableContext() { Scheduler::onIdle(&LookupTableContext::releaseSnapshot); }
         ~LookupTableContext() {}
 
       public:
@@ -160,31 +840,555 @@ namespace electionguard
 
         /// <summary>
         /// calcuate pow_mod_p using the provided fixed base.
+        /// the table is read under masks unless the policy is variable time.
+        /// returns false when the table of the base does not serve the policy.
         /// </summary>
-        static std::vector<uint64_t> pow_mod_p(string key, uint64_t (&base)[MAX_P_LEN],
-                                               uint64_t (&exponent)[MAX_Q_LEN])
+        static bool pow_mod_p(const uint64_t (&base)[MAX_P_LEN], uint64_t (&exponent)[MAX_Q_LEN],
+                              uint64_t (&result)[MAX_P_LEN], ExponentiationPolicy policy)
         {
-            LookupTableType *public_key_table = NULL;
-            {
-                getInstance().task_lock.wait();
-                public_key_table = getInstance().getBaseLookupTable(key, base);
+            auto &instance = getInstance();
+            auto digest = limbDigest(base);
+            if (const auto *table = instance.findCurrent(digest, base)) {
+                instance.counters().hits.fetch_add(1, std::memory_order_relaxed);
+                return table->pow_mod_p(exponent, result, policy);
+            }
+            return instance.getTable(base, true)->pow_mod_p(exponent, result, policy);
+        }
+
+        /// <summary>
+        /// get the lookup table of the provided fixed base, generating it if needed
+        /// </summary>
+        static std::shared_ptr<FixedBaseTable> getFixedTable(const uint64_t (&base)[MAX_P_LEN])
+        {
+            return getInstance().getTable(base, true);
+        }
+
+        /// <summary>
+        /// calcuate pow_mod_p of a base that is not flagged as a fixed base with its table.
+        ///
+        /// the use of the base is counted and a table is generated on the Scheduler once
+        /// the base crosses the promotion threshold. the table is read under masks unless
+        /// the policy is variable time. returns false while no table serves the policy.
+        /// </summary>
+        static bool adaptive_pow_mod_p(const uint64_t (&base)[MAX_P_LEN],
+                                       uint64_t (&exponent)[MAX_Q_LEN],
+                                       uint64_t (&result)[MAX_P_LEN], ExponentiationPolicy policy)
+        {
+            auto &instance = getInstance();
+            auto digest = limbDigest(base);
+            if (const auto *table = instance.findCurrent(digest, base)) {
+                instance.counters().hits.fetch_add(1, std::memory_order_relaxed);
+                return table->pow_mod_p(exponent, result, policy);
+            }
+
+            instance.counters().misses.fetch_add(1, std::memory_order_relaxed);
+            if (instance.promote(digest)) {
+                instance.schedule(digest, base);
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// whether bases without the fixed base flag are counted towards promotion
+        /// </summary>
+        static bool isAdaptive() { return getInstance().promotion_threshold.load() > 0; }
+
+        /// <summary>
+        /// generate the lookup table of the provided fixed base on the Scheduler.
+        /// the returned future is ready once the table is available to pow_mod_p.
+        /// </summary>
+        static std::future<void> prepare(const uint64_t (&base)[MAX_P_LEN])
+        {
+            uint64_t fixedBase[MAX_P_LEN];
+            std::copy(std::begin(base), std::end(base), fixedBase);
+            return Scheduler::submit(
+              [fixedBase]() mutable { getInstance().getTable(fixedBase, true); });
+        }
+
+        /// <summary>
+        /// write the lookup table of the provided fixed base to a file,
+        /// generating the table first if it does not exist yet.
+        /// </summary>
+        static void save(const uint64_t (&base)[MAX_P_LEN], const string &path)
+        {
+            auto table = getInstance().getTable(base, true);
+            table->save(path, base);
+        }
+
+        /// <summary>
+        /// memory map a lookup table file for the provided fixed base
+        /// so that it is used by subsequent calls to pow_mod_p.
+        /// a table that already exists for the base is kept.
+        /// </summary>
+        static void load(const uint64_t (&base)[MAX_P_LEN], const string &path)
+        {
+            auto table = loadLookupTable(path, base);
+            auto &instance = getInstance();
+            std::lock_guard<std::mutex> lock(instance.write_lock);
+            instance.publish(limbDigest(base), base, table);
+        }
+
+        /// <summary>
+        /// configure the number of uses before a base is promoted to a table (0 disables
+        /// promotion) and the number of bytes the tables may occupy
+        /// </summary>
+        static void setPolicy(uint64_t promotionThreshold, uint64_t byteBudget)
+        {
+            auto &instance = getInstance();
+            instance.promotion_threshold = std::min(promotionThreshold, CANDIDATE_COUNT_MASK);
+            for (auto &candidate : instance.candidates) {
+                candidate.store(0, std::memory_order_relaxed);
+            }
+
+            std::lock_guard<std::mutex> lock(instance.write_lock);
+            instance.byte_budget = byteBudget;
+            auto tables = std::make_shared<TableMap>(*std::atomic_load(&instance.published));
+            instance.evict(*tables, nullptr);
+            instance.store(tables);
+        }
+
+        static LookupTableCacheStatistics getStatistics()
+        {
+            auto &instance = getInstance();
+            auto tables = std::atomic_load(&instance.published);
+            LookupTableCacheStatistics statistics;
+            for (const auto &shard : instance.shards) {
+                statistics.hits += shard.hits.load(std::memory_order_relaxed);
+                statistics.misses += shard.misses.load(std::memory_order_relaxed);
+            }
+            statistics.promotions = instance.promotions.load();
+            statistics.evictions = instance.evictions.load();
+            statistics.tables = tables->size();
+            statistics.bytes = byteSize(*tables);
+            statistics.residentBytes = residentBytes().load(std::memory_order_relaxed);
+            return statistics;
+        }
+
+        /// <summary>
+        /// select how the memory of the tables generated from now on is backed by huge pages
+        /// </summary>
+        static void setHugePages(LookupTableHugePages hugePages)
+        {
+            getInstance().huge_pages = hugePages;
+        }
+
+        /// <summary>
+        /// generate interleaved tables for the provided fixed bases,
+        /// replacing the existing tables of the bases
+        /// </summary>
+        static void interleave(const std::vector<uint64_t *> &bases)
+        {
+            auto &instance = getInstance();
+            std::vector<uint64_t> digests;
+            for (auto *base : bases) {
+                digests.push_back(limbDigest(limbs(base)));
+            }
+
+            auto windowSize = bases.empty() ? LUT_WINDOW_SIZE : instance.windowSize(digests[0]);
+            for (auto digest : digests) {
+                if (instance.windowSize(digest) != windowSize) {
+                    throw std::invalid_argument(
+                      "interleave:: the bases must use the same window size");
+                }
+            }
+
+            auto tables =
+              makeInterleavedLookupTables(windowSize, bases, true, instance.huge_pages.load());
+            std::lock_guard<std::mutex> lock(instance.write_lock);
+            for (size_t i = 0; i < bases.size(); i++) {
+                instance.publish(digests[i], limbs(bases[i]), tables[i], true);
+            }
+        }
+
+        /// <summary>
+        /// select the window size of the table generated for the base.
+        /// a table of the base with another window size is discarded
+        /// and the base gets a new table when it is used again.
+        /// </summary>
+        static void setWindowSize(const uint64_t (&base)[MAX_P_LEN], uint64_t windowSize)
+        {
+            if (!isSupportedWindowSize(windowSize)) {
+                throw std::invalid_argument("setWindowSize:: unsupported window size " +
+                                            std::to_string(windowSize));
+            }
+
+            auto &instance = getInstance();
+            auto digest = limbDigest(base);
+            std::lock_guard<std::mutex> lock(instance.write_lock);
+            instance.window_sizes[digest] = windowSize;
+
+            auto tables = std::make_shared<TableMap>(*std::atomic_load(&instance.published));
+            auto range = tables->equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (matches(it->second->base, base)) {
+                    if (it->second->table->windowSize() != windowSize) {
+                        tables->erase(it);
+                        instance.store(tables);
+                    }
+                    return;
+                }
             }
-            return public_key_table->pow_mod_p(exponent);
         }
 
       private:
-        AsyncSemaphore task_lock;
-        std::map<string, std::unique_ptr<LookupTableType>> key_map;
+        // the current tables, replaced as a whole while holding the write lock
+        std::shared_ptr<const TableMap> published = std::make_shared<const TableMap>();
+        std::mutex write_lock;
+        std::unordered_multimap<uint64_t, PendingEntry> pending;
+        // window sizes selected for bases, a colliding digest only changes the geometry
+        std::unordered_map<uint64_t, uint64_t> window_sizes;
+        std::atomic<LookupTableHugePages> huge_pages{LookupTableHugePages::transparent};
+        uint64_t byte_budget = LUT_CACHE_BYTE_BUDGET;
+
+        // the low bits of a candidate slot count the uses of the base whose digest
+        // fills the high bits, so that a slot is updated with a single atomic operation
+        static constexpr uint64_t CANDIDATE_COUNT_MASK = (1ULL << 24) - 1;
+        std::atomic<uint64_t> promotion_threshold{LUT_PROMOTION_THRESHOLD};
+        std::array<std::atomic<uint64_t>, LUT_PROMOTION_CANDIDATES> candidates = {};
+
+        // advanced by two every time the tables are replaced, it also serves as the coarse
+        // clock of the least recently used order. a use is recorded with the current epoch
+        // and a new table with the next odd value, so that it is more recent than the
+        // tables used before it was published and older than the ones used after
+        std::atomic<uint64_t> epoch{2};
+
+        // the hits and misses are counted on a shard per thread, so that threads
+        // using tables at the same time do not write to the same cache line
+        struct alignas(64) CounterShard {
+            std::atomic<uint64_t> hits{0};
+            std::atomic<uint64_t> misses{0};
+        };
+        static constexpr size_t COUNTER_SHARDS = 16;
+        std::array<CounterShard, COUNTER_SHARDS> shards;
+        std::atomic<size_t> next_shard{0};
+        std::atomic<uint64_t> promotions{0};
+        std::atomic<uint64_t> evictions{0};
+
+        static const uint64_t (&limbs(const uint64_t *base))[MAX_P_LEN]
+        {
+            return *reinterpret_cast<const uint64_t(*)[MAX_P_LEN]>(base);
+        }
+
+        static bool matches(const std::array<uint64_t, MAX_P_LEN> &lhs,
+                            const uint64_t (&rhs)[MAX_P_LEN])
+        {
+            return std::equal(lhs.begin(), lhs.end(), std::begin(rhs));
+        }
+
+        CounterShard &counters()
+        {
+            thread_local size_t shard = next_shard.fetch_add(1) % COUNTER_SHARDS;
+            return shards[shard];
+        }
 
-        LookupTableType *getBaseLookupTable(const string key, uint64_t (&base)[MAX_P_LEN])
+        static Snapshot &threadSnapshot()
         {
-            auto const iter = key_map.find(key);
-            if (iter != key_map.end()) {
-                return key_map[key].get();
+            thread_local Snapshot snapshot;
+            return snapshot;
+        }
+
+        /// <summary>
+        /// release the tables held by the calling thread, the next lookup reloads them.
+        /// the entries found by the thread before are no longer valid.
+        /// </summary>
+        static void releaseSnapshot()
+        {
+            auto &snapshot = threadSnapshot();
+            snapshot.tables = nullptr;
+            snapshot.epoch = 0;
+        }
+
+        /// <summary>
+        /// the bytes of the tables in every map that is still held
+        /// </summary>
+        static std::atomic<uint64_t> &residentBytes()
+        {
+            static std::atomic<uint64_t> bytes{0};
+            return bytes;
+        }
+
+        /// <summary>
+        /// replace the tables, must hold the write lock
+        /// </summary>
+        void store(std::shared_ptr<const TableMap> tables)
+        {
+            std::atomic_store(&published, std::move(tables));
+            epoch.fetch_add(2, std::memory_order_release);
+        }
+
+        /// <summary>
+        /// find the entry of the base in the tables of the calling thread,
+        /// reloading them first when they were replaced since the last lookup.
+        /// the entry remains valid until the thread looks up a table again.
+        /// </summary>
+        const TableEntry *findEntry(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            auto &snapshot = threadSnapshot();
+            auto current = epoch.load(std::memory_order_acquire);
+            if (snapshot.epoch != current) {
+                // drop the stale map first, so that its tables are not held twice
+                snapshot.tables = nullptr;
+                snapshot.tables = std::atomic_load(&published);
+                snapshot.epoch = current;
+            }
+
+            auto range = snapshot.tables->equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (matches(it->second->base, base)) {
+                    // the entry is only written once per epoch
+                    const auto &entry = *it->second;
+                    if (entry.lastUsed.load(std::memory_order_relaxed) != current) {
+                        entry.lastUsed.store(current, std::memory_order_relaxed);
+                    }
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        const FixedBaseTable *findCurrent(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            const auto *entry = findEntry(digest, base);
+            return entry == nullptr ? nullptr : entry->table.get();
+        }
+
+        std::shared_ptr<FixedBaseTable> find(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            const auto *entry = findEntry(digest, base);
+            return entry == nullptr ? nullptr : entry->table;
+        }
+
+        std::shared_ptr<FixedBaseTable> getTable(const uint64_t (&base)[MAX_P_LEN], bool fixedBase)
+        {
+            auto digest = limbDigest(base);
+            auto table = find(digest, base);
+            if (table != nullptr) {
+                counters().hits.fetch_add(1, std::memory_order_relaxed);
+                return table;
+            }
+
+            counters().misses.fetch_add(1, std::memory_order_relaxed);
+            if (fixedBase) {
+                return build(digest, base);
+            }
+            if (promote(digest)) {
+                schedule(digest, base);
+            }
+            return nullptr;
+        }
+
+        /// <summary>
+        /// count a use of the base, returns true when the base should get a table.
+        ///
+        /// each base counts in the slot selected by its digest. a use of another base
+        /// decrements the count and takes over the slot once the count is exhausted,
+        /// so a base that is used often keeps its slot among bases that are used rarely.
+        /// </summary>
+        bool promote(uint64_t digest)
+        {
+            auto threshold = promotion_threshold.load(std::memory_order_relaxed);
+            if (threshold == 0) {
+                return false;
+            }
+
+            auto &slot = candidates[digest % LUT_PROMOTION_CANDIDATES];
+            auto tag = digest & ~CANDIDATE_COUNT_MASK;
+            auto current = slot.load(std::memory_order_relaxed);
+            while (true) {
+                auto count = current & CANDIDATE_COUNT_MASK;
+                uint64_t next = 0;
+                bool promoted = false;
+                if ((current & ~CANDIDATE_COUNT_MASK) == tag) {
+                    promoted = count + 1 >= threshold;
+                    next = promoted ? 0 : tag | (count + 1);
+                } else if (count <= 1) {
+                    promoted = threshold == 1;
+                    next = promoted ? 0 : tag | 1;
+                } else {
+                    next = current - 1;
+                }
+
+                if (slot.compare_exchange_weak(current, next, std::memory_order_relaxed)) {
+                    if (promoted) {
+                        promotions++;
+                    }
+                    return promoted;
+                }
+            }
+        }
+
+        /// <summary>
+        /// build the table of a promoted base on the Scheduler,
+        /// unless it exists or is already being built
+        /// </summary>
+        void schedule(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            {
+                std::lock_guard<std::mutex> lock(write_lock);
+                auto range = pending.equal_range(digest);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (matches(it->second.base, base)) {
+                        return;
+                    }
+                }
+            }
+
+            uint64_t promotedBase[MAX_P_LEN];
+            std::copy(std::begin(base), std::end(base), promotedBase);
+            Scheduler::submit(
+              [this, digest, promotedBase]() mutable { build(digest, promotedBase); });
+        }
+
+        /// <summary>
+        /// build the table for the base, or wait for the caller that is already building it
+        /// </summary>
+        std::shared_ptr<FixedBaseTable> build(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            std::promise<std::shared_ptr<FixedBaseTable>> promise;
+            {
+                std::unique_lock<std::mutex> lock(write_lock);
+                auto table = find(digest, base);
+                if (table != nullptr) {
+                    return table;
+                }
+
+                auto range = pending.equal_range(digest);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (matches(it->second.base, base)) {
+                        auto future = it->second.table;
+                        lock.unlock();
+                        return future.get();
+                    }
+                }
+
+                PendingEntry entry;
+                std::copy(std::begin(base), std::end(base), entry.base.begin());
+                entry.table = promise.get_future().share();
+                pending.emplace(digest, entry);
+            }
+
+            std::shared_ptr<FixedBaseTable> table;
+            try {
+                table = makeTable(digest, base);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(write_lock);
+                erasePending(digest, base);
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(write_lock);
+                erasePending(digest, base);
+                table = publish(digest, base, table);
+            }
+            promise.set_value(table);
+            return table;
+        }
+
+        /// <summary>
+        /// use the table of G linked into the library when it has the geometry
+        /// selected for the base, otherwise generate the table
+        /// </summary>
+        std::shared_ptr<FixedBaseTable> makeTable(uint64_t digest,
+                                                  const uint64_t (&base)[MAX_P_LEN])
+        {
+            auto selected = windowSize(digest);
+            const auto *embedded = embedded_g_table();
+            if (embedded != nullptr && selected == LUT_WINDOW_SIZE &&
+                std::equal(std::begin(base), std::end(base), std::begin(G_ARRAY_REVERSE))) {
+                return LookupTableType::view(embedded, base);
+            }
+            return makeLookupTable(selected, const_cast<uint64_t *>(base), true,
+                                   huge_pages.load());
+        }
+
+        uint64_t windowSize(uint64_t digest)
+        {
+            std::lock_guard<std::mutex> lock(write_lock);
+            auto found = window_sizes.find(digest);
+            return found == window_sizes.end() ? LUT_WINDOW_SIZE : found->second;
+        }
+
+        static uint64_t byteSize(const TableMap &tables)
+        {
+            uint64_t bytes = 0;
+            for (const auto &it : tables) {
+                bytes += it.second->table->byteSize();
+            }
+            return bytes;
+        }
+
+        void erasePending(uint64_t digest, const uint64_t (&base)[MAX_P_LEN])
+        {
+            auto range = pending.equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (matches(it->second.base, base)) {
+                    pending.erase(it);
+                    return;
+                }
             }
+        }
 
-            key_map.emplace(std::pair(key, new LookupTableType(static_cast<uint64_t *>(base))));
-            return key_map[key].get();
+        /// <summary>
+        /// publish a new map including the table, must hold the write lock.
+        /// returns the table that is published for the base, which is the existing
+        /// table of the base unless `replace` is set.
+        /// </summary>
+        std::shared_ptr<FixedBaseTable> publish(uint64_t digest, const uint64_t (&base)[MAX_P_LEN],
+                                                std::shared_ptr<FixedBaseTable> table,
+                                                bool replace = false)
+        {
+            auto existing = find(digest, base);
+            if (existing != nullptr && !replace) {
+                return existing;
+            }
+
+            auto entry = std::make_shared<TableEntry>();
+            std::copy(std::begin(base), std::end(base), entry->base.begin());
+            entry->table = table;
+            entry->lastUsed = epoch.load(std::memory_order_relaxed) + 1;
+            residentBytes().fetch_add(table->byteSize(), std::memory_order_relaxed);
+
+            auto tables = std::make_shared<TableMap>(*std::atomic_load(&published));
+            auto range = tables->equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (matches(it->second->base, base)) {
+                    tables->erase(it);
+                    break;
+                }
+            }
+            tables->emplace(digest, entry);
+            evict(*tables, entry.get());
+            store(tables);
+            return table;
+        }
+
+        /// <summary>
+        /// remove the least recently used tables until the budget is met,
+        /// except for the provided entry. tables in use elsewhere stay alive
+        /// until they are released.
+        /// </summary>
+        void evict(TableMap &tables, const TableEntry *keep)
+        {
+            auto bytes = byteSize(tables);
+            while (bytes > byte_budget) {
+                auto oldest = tables.end();
+                for (auto it = tables.begin(); it != tables.end(); ++it) {
+                    if (it->second.get() != keep &&
+                        (oldest == tables.end() ||
+                         it->second->lastUsed.load(std::memory_order_relaxed) <
+                           oldest->second->lastUsed.load(std::memory_order_relaxed))) {
+                        oldest = it;
+                    }
+                }
+                if (oldest == tables.end()) {
+                    return;
+                }
+                bytes -= oldest->second->table->byteSize();
+                tables.erase(oldest);
+                evictions++;
+            }
         }
     };
 
@@ -0,0 +1,163 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif // _WIN32
+
+using std::runtime_error;
+using std::string;
+using std::to_string;
+
+namespace electionguard
+{
+#ifdef _WIN32
+    MappedFile::MappedFile(const string &path)
+    {
+        auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            throw runtime_error("MappedFile:: could not open " + path);
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            CloseHandle(file);
+            throw runtime_error("MappedFile:: could not read the size of " + path);
+        }
+
+        auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            CloseHandle(file);
+            throw runtime_error("MappedFile:: could not map " + path);
+        }
+
+        auto *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (view == nullptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            throw runtime_error("MappedFile:: could not map " + path);
+        }
+
+        _file = file;
+        _mapping = mapping;
+        _data = static_cast<const uint8_t *>(view);
+        _size = static_cast<size_t>(fileSize.QuadPart);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+    }
+
+    MappedMemory::MappedMemory(size_t size, LookupTableHugePages hugePages)
+    {
+        if (hugePages == LookupTableHugePages::reserved) {
+            // large pages need the SeLockMemoryPrivilege, fall back without it
+            auto largePage = GetLargePageMinimum();
+            if (largePage > 0) {
+                auto largeSize = (size + largePage - 1) / largePage * largePage;
+                auto *view = VirtualAlloc(nullptr, largeSize,
+                                          MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                                          PAGE_READWRITE);
+                if (view != nullptr) {
+                    _data = static_cast<uint8_t *>(view);
+                    _size = largeSize;
+                    _reserved = true;
+                    return;
+                }
+            }
+        }
+
+        auto *view = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+        if (view == nullptr) {
+            throw runtime_error("MappedMemory:: could not map " + to_string(size) + " bytes");
+        }
+        _data = static_cast<uint8_t *>(view);
+        _size = size;
+    }
+
+    MappedMemory::~MappedMemory() { VirtualFree(_data, 0, MEM_RELEASE); }
+#else
+    MappedFile::MappedFile(const string &path)
+    {
+        auto descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw runtime_error("MappedFile:: could not open " + path);
+        }
+
+        struct stat status;
+        if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+            close(descriptor);
+            throw runtime_error("MappedFile:: could not read the size of " + path);
+        }
+
+        auto size = static_cast<size_t>(status.st_size);
+        auto *view = mmap(nullptr, size, PROT_READ, MAP_SHARED, descriptor, 0);
+
+        // the mapping holds its own reference to the file
+        close(descriptor);
+        if (view == MAP_FAILED) {
+            throw runtime_error("MappedFile:: could not map " + path);
+        }
+
+        _data = static_cast<const uint8_t *>(view);
+        _size = size;
+    }
+
+    MappedFile::~MappedFile() { munmap(const_cast<uint8_t *>(_data), _size); }
+
+    MappedMemory::MappedMemory(size_t size, LookupTableHugePages hugePages)
+    {
+        _size = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+
+#    ifdef MAP_HUGETLB
+        if (hugePages == LookupTableHugePages::reserved) {
+            // fails unless the system has enough huge pages reserved, fall back without them
+            auto *view = mmap(nullptr, _size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (view != MAP_FAILED) {
+                _mapping = view;
+                _mappingSize = _size;
+                _data = static_cast<uint8_t *>(view);
+                _reserved = true;
+                return;
+            }
+        }
+#    endif // MAP_HUGETLB
+
+        // map an extra huge page so the start can be aligned to a huge page boundary
+        auto alignment = hugePages == LookupTableHugePages::none ? 0 : HUGE_PAGE_SIZE;
+        _mappingSize = _size + alignment;
+        auto *view = mmap(nullptr, _mappingSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (view == MAP_FAILED) {
+            throw runtime_error("MappedMemory:: could not map " + to_string(size) + " bytes");
+        }
+        _mapping = view;
+
+        auto address = reinterpret_cast<uintptr_t>(view);
+        if (alignment > 0) {
+            address = (address + alignment - 1) / alignment * alignment;
+        }
+        _data = reinterpret_cast<uint8_t *>(address);
+
+#    ifdef MADV_HUGEPAGE
+        if (hugePages != LookupTableHugePages::none) {
+            // a hint only, the kernel may still back the mapping with regular pages
+            madvise(_data, _size, MADV_HUGEPAGE);
+        }
+#    endif // MADV_HUGEPAGE
+    }
+
+    MappedMemory::~MappedMemory() { munmap(_mapping, _mappingSize); }
+#endif // _WIN32
+} // namespace electionguard
@@ -0,0 +1,91 @@
+#ifndef __ELECTIONGUARD_CPP_MAPPED_FILE_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_MAPPED_FILE_HPP_INCLUDED__
+
+#include <cstddef>
+#include <cstdint>
+#include <electionguard/export.h>
+#include <electionguard/group.hpp>
+#include <string>
+
+namespace electionguard
+{
+    /// <summary>
+    /// A read-only memory map of an entire file.
+    ///
+    /// The pages are mapped shared so that every process mapping the same
+    /// file on a host is backed by the same physical memory.
+    /// The mapping is released when the instance is destroyed.
+    /// </summary>
+    class EG_INTERNAL_API MappedFile
+    {
+      public:
+        /// <summary>
+        /// Map the file at the path. Throws runtime_error if the file cannot be mapped.
+        /// </summary>
+        explicit MappedFile(const std::string &path);
+        MappedFile(const MappedFile &) = delete;
+        MappedFile(MappedFile &&) = delete;
+        ~MappedFile();
+
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile &operator=(MappedFile &&) = delete;
+
+        const uint8_t *data() const { return _data; }
+        size_t size() const { return _size; }
+
+      private:
+        const uint8_t *_data = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void *_file = nullptr;
+        void *_mapping = nullptr;
+#endif // _WIN32
+    };
+
+    /// <summary>
+    /// A private read-write anonymous memory mapping, zero filled and aligned
+    /// to the huge page size so that it can be backed by huge pages.
+    ///
+    /// Reserved huge pages are used when requested and available, otherwise the
+    /// mapping is advised for transparent huge pages where the platform supports it.
+    /// The mapping is released when the instance is destroyed.
+    /// </summary>
+    class EG_INTERNAL_API MappedMemory
+    {
+      public:
+        /// <summary>
+        /// Map at least `size` bytes. Throws runtime_error if the memory cannot be mapped.
+        /// </summary>
+        MappedMemory(size_t size, LookupTableHugePages hugePages);
+        MappedMemory(const MappedMemory &) = delete;
+        MappedMemory(MappedMemory &&) = delete;
+        ~MappedMemory();
+
+        MappedMemory &operator=(const MappedMemory &) = delete;
+        MappedMemory &operator=(MappedMemory &&) = delete;
+
+        uint8_t *data() const { return _data; }
+        size_t size() const { return _size; }
+
+        /// <summary>
+        /// whether the mapping is backed by reserved huge pages
+        /// </summary>
+        bool isReserved() const { return _reserved; }
+
+      private:
+        uint8_t *_data = nullptr;
+        size_t _size = 0;
+        bool _reserved = false;
+#ifndef _WIN32
+        void *_mapping = nullptr;
+        size_t _mappingSize = 0;
+#endif // _WIN32
+    };
+
+    /// <summary>
+    /// the size and alignment of huge pages assumed for transparent huge pages
+    /// </summary>
+    const size_t HUGE_PAGE_SIZE = 2U * 1024U * 1024U;
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_MAPPED_FILE_HPP_INCLUDED__ */
@@ -0,0 +1,168 @@
+#ifndef __ELECTIONGUARD_CPP_MONT_ELEMENT_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_MONT_ELEMENT_HPP_INCLUDED__
+
+#include "facades/Hacl_Bignum4096.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+#include <electionguard/group.hpp>
+#include <memory>
+
+namespace electionguard
+{
+    /// <summary>
+    /// An element mod p held in montgomery form, used as the accumulator of
+    /// multiplication chains such as homomorphic tallies and proof checks.
+    ///
+    /// Every product is a single montgomery multiplication instead of a
+    /// double width multiplication followed by a full reduction,
+    /// and the element is only converted back once when the chain ends.
+    ///
+    /// Elements in standard form can be multiplied in without converting them first.
+    /// Each such product leaves one factor of R^-1 behind, which is counted
+    /// and restored with a single power of R when the element is converted back.
+    /// </summary>
+    class EG_INTERNAL_API MontElementModP
+    {
+      public:
+        /// <summary>
+        /// Create the multiplicative identity
+        /// </summary>
+        MontElementModP() { hacl::CONTEXT_P().montgomery_one(value.data); }
+
+        /// <summary>
+        /// Convert an element in standard form into montgomery form
+        /// </summary>
+        explicit MontElementModP(const ElementModP &element)
+        {
+            hacl::CONTEXT_P().to_montgomery_form(const_cast<uint64_t *>(element.data()), value.data);
+        }
+
+        /// <summary>
+        /// Wrap limbs that are already in montgomery form
+        /// </summary>
+        static MontElementModP fromMontgomeryForm(const uint64_t (&elementM)[MAX_P_LEN])
+        {
+            MontElementModP result;
+            std::copy(std::begin(elementM), std::end(elementM), result.value.data);
+            return result;
+        }
+
+        /// <summary>
+        /// Multiply by another element in montgomery form
+        /// </summary>
+        MontElementModP &mul(const MontElementModP &other)
+        {
+            hacl::CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              value.data, const_cast<uint64_t *>(other.value.data), value.data);
+            deficit += other.deficit;
+            return *this;
+        }
+
+        /// <summary>
+        /// Multiply by an element in standard form without converting it
+        /// </summary>
+        MontElementModP &mul(const ElementModP &other)
+        {
+            hacl::CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(
+              value.data, const_cast<uint64_t *>(other.data()), value.data);
+            deficit++;
+            return *this;
+        }
+
+        /// <summary>
+        /// Square the element in place
+        /// </summary>
+        MontElementModP &sqr()
+        {
+            hacl::CONTEXT_P().montgomery_mod_sqr_stay_in_mont_form(value.data, value.data);
+            deficit *= 2;
+            return *this;
+        }
+
+        /// <summary>
+        /// Convert the element back to standard form, writing it into `result`
+        /// </summary>
+        void toElementModP(ElementModP &result) const
+        {
+            MontElementModP normalized(*this);
+            normalized.normalize();
+
+            uint64_t element[MAX_P_LEN] = {};
+            hacl::CONTEXT_P().from_montgomery_form(normalized.value.data,
+                                                   static_cast<uint64_t *>(element));
+            const ElementModP converted(element, true);
+            result = converted;
+        }
+
+        /// <summary>
+        /// Convert the element back to standard form
+        /// </summary>
+        std::unique_ptr<ElementModP> toElementModP() const
+        {
+            auto result = std::make_unique<ElementModP>();
+            toElementModP(*result);
+            return result;
+        }
+
+      private:
+        ElementModPValue value;
+        // the number of R^-1 factors left behind by products with standard form elements
+        uint64_t deficit = 0;
+
+        /// <summary>
+        /// Restore the missing factors by multiplying with R^deficit
+        /// </summary>
+        void normalize()
+        {
+            if (deficit == 0) {
+                return;
+            }
+
+            const auto &context = hacl::CONTEXT_P();
+            const auto &radix = radixM();
+
+            // R^deficit in montgomery form by square and multiply
+            int bit = 63;
+            while (((deficit >> bit) & 1) == 0) {
+                bit--;
+            }
+            uint64_t powerM[MAX_P_LEN] = {};
+            std::copy(std::begin(radix.data), std::end(radix.data), powerM);
+            for (bit--; bit >= 0; bit--) {
+                context.montgomery_mod_sqr_stay_in_mont_form(static_cast<uint64_t *>(powerM),
+                                                             static_cast<uint64_t *>(powerM));
+                if ((deficit >> bit) & 1) {
+                    context.montgomery_mod_mul_stay_in_mont_form(
+                      static_cast<uint64_t *>(powerM), const_cast<uint64_t *>(radix.data),
+                      static_cast<uint64_t *>(powerM));
+                }
+            }
+
+            context.montgomery_mod_mul_stay_in_mont_form(
+              value.data, static_cast<uint64_t *>(powerM), value.data);
+            deficit = 0;
+        }
+
+        /// <summary>
+        /// The montgomery radix R mod p, itself in montgomery form
+        /// </summary>
+        static const ElementModPValue &radixM()
+        {
+            static const ElementModPValue instance = [] {
+                const auto &context = hacl::CONTEXT_P();
+                ElementModPValue oneM;
+                context.montgomery_one(oneM.data);
+                ElementModPValue result;
+                context.to_montgomery_form(oneM.data, result.data);
+                return result;
+            }();
+            return instance;
+        }
+    };
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_MONT_ELEMENT_HPP_INCLUDED__ */
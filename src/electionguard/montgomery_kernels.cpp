@@ -0,0 +1,506 @@
+#include "montgomery_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+// the x86 kernels are written with GNU inline assembly and the 128 bit integer extension,
+// so MSVC, including clang-cl, only builds the portable fallbacks below
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(_MSC_VER) &&  \
+  !defined(_WIN32)
+#define EG_MONTGOMERY_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+using std::atomic;
+using std::copy;
+using std::invalid_argument;
+
+namespace electionguard
+{
+    static atomic<MontgomeryKernel> &activeKernel()
+    {
+        static atomic<MontgomeryKernel> instance{detectMontgomeryKernel()};
+        return instance;
+    }
+
+    bool isMontgomeryKernelSupported(MontgomeryKernel kernel)
+    {
+        switch (kernel) {
+            case MontgomeryKernel::portable:
+                return true;
+#ifdef EG_MONTGOMERY_X86_KERNELS
+            case MontgomeryKernel::adx:
+                return __builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2");
+            case MontgomeryKernel::ifma:
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512ifma");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    MontgomeryKernel detectMontgomeryKernel()
+    {
+        if (isMontgomeryKernelSupported(MontgomeryKernel::ifma)) {
+            return MontgomeryKernel::ifma;
+        }
+        if (isMontgomeryKernelSupported(MontgomeryKernel::adx)) {
+            return MontgomeryKernel::adx;
+        }
+        return MontgomeryKernel::portable;
+    }
+
+    MontgomeryKernel getMontgomeryKernel() { return activeKernel().load(std::memory_order_relaxed); }
+
+    void setMontgomeryKernel(MontgomeryKernel kernel)
+    {
+        if (!isMontgomeryKernelSupported(kernel)) {
+            throw invalid_argument("setMontgomeryKernel:: kernel is not supported on this processor");
+        }
+        activeKernel().store(kernel, std::memory_order_relaxed);
+    }
+
+    bool canUseMontgomeryLanes() { return getMontgomeryKernel() == MontgomeryKernel::ifma; }
+
+    bool montgomery_mul_4096(const uint64_t *n, uint64_t mu, const uint64_t *a, const uint64_t *b,
+                             uint64_t *res)
+    {
+        switch (getMontgomeryKernel()) {
+#ifdef EG_MONTGOMERY_X86_KERNELS
+            case MontgomeryKernel::adx:
+                montgomery_mul_4096_adx(n, mu, a, b, res);
+                return true;
+            case MontgomeryKernel::ifma:
+                montgomery_mul_4096_ifma(n, mu, a, b, res);
+                return true;
+#endif
+            default:
+                return false;
+        }
+    }
+
+#ifdef EG_MONTGOMERY_X86_KERNELS
+
+    __extension__ typedef unsigned __int128 uint128_t;
+
+    /// <summary>
+    /// Subtract n from the 65 limb value x:top when it is not less than n,
+    /// without branching on the value
+    /// </summary>
+    static void conditionalSubtract(uint64_t *x, uint64_t &top, const uint64_t *n)
+    {
+        uint64_t difference[MAX_P_LEN];
+        uint64_t borrow = 0;
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            auto d = static_cast<uint128_t>(x[i]) - n[i] - borrow;
+            difference[i] = static_cast<uint64_t>(d);
+            borrow = static_cast<uint64_t>(d >> 64) & 1;
+        }
+        auto topDifference = static_cast<uint128_t>(top) - borrow;
+        uint64_t keep = 0 - (static_cast<uint64_t>(topDifference >> 64) & 1);
+
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            x[i] = (x[i] & keep) | (difference[i] & ~keep);
+        }
+        top = (top & keep) | (static_cast<uint64_t>(topDifference) & ~keep);
+    }
+
+    /// <summary>
+    /// Add a * b to the 66 limb value t
+    /// </summary>
+    static void mulAddScalar(uint64_t *t, const uint64_t *a, uint64_t b)
+    {
+        uint64_t carry = 0;
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            auto product = static_cast<uint128_t>(a[i]) * b + t[i] + carry;
+            t[i] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        auto sum = static_cast<uint128_t>(t[MAX_P_LEN]) + carry;
+        t[MAX_P_LEN] = static_cast<uint64_t>(sum);
+        t[MAX_P_LEN + 1] += static_cast<uint64_t>(sum >> 64);
+    }
+
+#pragma region ADX
+
+    /// <summary>
+    /// Add a * b to t[0..MAX_P_LEN], adding the carry out into t[MAX_P_LEN + 1].
+    ///
+    /// MULX leaves the flags alone, so the low halves of the products are
+    /// accumulated on the carry flag with ADCX while the high halves are
+    /// accumulated on the overflow flag with ADOX, as two independent chains.
+    /// </summary>
+    static inline void mulAddRow(uint64_t *t, const uint64_t *a, uint64_t b)
+    {
+        uint64_t blocks = MAX_P_LEN / 8;
+        __asm__ volatile("xorl %%r10d, %%r10d\n\t"
+                         "1:\n\t"
+                         ".irp j,0,1,2,3,4,5,6,7\n\t"
+                         "mulxq 8*\\j(%[a]), %%r8, %%r9\n\t"
+                         "adcxq 8*\\j(%[t]), %%r8\n\t"
+                         "adoxq %%r10, %%r8\n\t"
+                         "movq %%r8, 8*\\j(%[t])\n\t"
+                         "movq %%r9, %%r10\n\t"
+                         ".endr\n\t"
+                         "leaq 64(%[a]), %[a]\n\t"
+                         "leaq 64(%[t]), %[t]\n\t"
+                         "leaq -1(%[blocks]), %[blocks]\n\t"
+                         "jrcxz 2f\n\t"
+                         "jmp 1b\n\t"
+                         "2:\n\t"
+                         "movq $0, %%r9\n\t"
+                         "movq (%[t]), %%r8\n\t"
+                         "adcxq %%r9, %%r8\n\t"
+                         "adoxq %%r10, %%r8\n\t"
+                         "movq %%r8, (%[t])\n\t"
+                         "movq $0, %%r8\n\t"
+                         "adcxq %%r9, %%r8\n\t"
+                         "adoxq %%r9, %%r8\n\t"
+                         "addq %%r8, 8(%[t])\n\t"
+                         : [t] "+r"(t), [a] "+r"(a), [blocks] "+c"(blocks)
+                         : "d"(b)
+                         : "r8", "r9", "r10", "cc", "memory");
+    }
+
+    void montgomery_mul_4096_adx(const uint64_t *n, uint64_t mu, const uint64_t *a,
+                                 const uint64_t *b, uint64_t *res)
+    {
+        // operand scanning: each row adds a * b_i and then the multiple of n
+        // that clears the lowest limb, so the window moves up one limb per row
+        uint64_t t[2 * MAX_P_LEN + 2] = {};
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            mulAddRow(&t[i], a, b[i]);
+            mulAddRow(&t[i], n, t[i] * mu);
+        }
+
+        uint64_t top = t[2 * MAX_P_LEN];
+        conditionalSubtract(&t[MAX_P_LEN], top, n);
+        copy(&t[MAX_P_LEN], &t[2 * MAX_P_LEN], res);
+    }
+
+#pragma endregion
+
+#pragma region IFMA
+
+    const uint32_t RADIX52_BITS = 52;
+    const uint64_t RADIX52_MASK = (1ULL << RADIX52_BITS) - 1;
+    // 80 digits fill ten 512-bit registers, of which 79 hold a 4096-bit value
+    const uint32_t RADIX52_DIGITS = 80;
+    const uint32_t RADIX52_VECTORS = RADIX52_DIGITS / 8;
+    // 78 full digit reductions plus a final 40 bit reduction remove exactly 2^4096
+    const uint32_t RADIX52_REDUCTIONS = 78;
+    const uint32_t FINAL_REDUCTION_BITS = MAX_P_LEN * 64 - RADIX52_REDUCTIONS * RADIX52_BITS;
+
+    static void toRadix52(const uint64_t *x, uint64_t *digits)
+    {
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            auto bit = k * RADIX52_BITS;
+            auto limb = bit / 64;
+            auto offset = bit % 64;
+            uint64_t digit = 0;
+            if (limb < MAX_P_LEN) {
+                digit = x[limb] >> offset;
+                if (offset > 64 - RADIX52_BITS && limb + 1 < MAX_P_LEN) {
+                    digit |= x[limb + 1] << (64 - offset);
+                }
+            }
+            digits[k] = digit & RADIX52_MASK;
+        }
+    }
+
+    /// <summary>
+    /// Pack RADIX52_DIGITS + 1 normalized digits into MAX_P_LEN + 2 limbs
+    /// </summary>
+    static void fromRadix52(const uint64_t *digits, uint64_t *limbs)
+    {
+        for (uint32_t k = 0; k <= RADIX52_DIGITS; k++) {
+            auto bit = k * RADIX52_BITS;
+            auto limb = bit / 64;
+            auto offset = bit % 64;
+            auto shifted = static_cast<uint128_t>(digits[k]) << offset;
+            if (limb < MAX_P_LEN + 2) {
+                limbs[limb] |= static_cast<uint64_t>(shifted);
+            }
+            if (limb + 1 < MAX_P_LEN + 2) {
+                limbs[limb + 1] |= static_cast<uint64_t>(shifted >> 64);
+            }
+        }
+    }
+
+    // gcc reports the placeholder operands inside its own avx512 intrinsics as uninitialized
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#endif
+    __attribute__((target("avx512f,avx512ifma"))) void
+    montgomery_mul_4096_ifma(const uint64_t *n, uint64_t mu, const uint64_t *a, const uint64_t *b,
+                             uint64_t *res)
+    {
+        alignas(64) uint64_t a52[RADIX52_DIGITS];
+        alignas(64) uint64_t n52[RADIX52_DIGITS];
+        alignas(64) uint64_t b52[RADIX52_DIGITS];
+        toRadix52(a, a52);
+        toRadix52(n, n52);
+        toRadix52(b, b52);
+
+        __m512i av[RADIX52_VECTORS];
+        __m512i nv[RADIX52_VECTORS];
+        __m512i acc[RADIX52_VECTORS];
+        for (uint32_t k = 0; k < RADIX52_VECTORS; k++) {
+            av[k] = _mm512_load_si512(&a52[8 * k]);
+            nv[k] = _mm512_load_si512(&n52[8 * k]);
+            acc[k] = _mm512_setzero_si512();
+        }
+
+        // almost montgomery multiplication, one digit of b per iteration.
+        // the digits are left unnormalized, the low halves of the products
+        // are added in place and the high halves after shifting down one digit
+        const uint64_t k0 = mu & RADIX52_MASK;
+        const __m512i zero = _mm512_setzero_si512();
+        for (uint32_t i = 0; i < RADIX52_REDUCTIONS; i++) {
+            auto bi = _mm512_set1_epi64(static_cast<long long>(b52[i]));
+            for (uint32_t k = 0; k < RADIX52_VECTORS; k++) {
+                acc[k] = _mm512_madd52lo_epu64(acc[k], av[k], bi);
+            }
+
+            auto low = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm512_castsi512_si128(acc[0])));
+            auto mi = (low * k0) & RADIX52_MASK;
+            auto m = _mm512_set1_epi64(static_cast<long long>(mi));
+            for (uint32_t k = 0; k < RADIX52_VECTORS; k++) {
+                acc[k] = _mm512_madd52lo_epu64(acc[k], nv[k], m);
+            }
+
+            // the lowest digit is now a multiple of 2^52, track it in a scalar
+            // rather than waiting on the vector to carry its high bits up
+            low += (mi * n52[0]) & RADIX52_MASK;
+            for (uint32_t k = 0; k + 1 < RADIX52_VECTORS; k++) {
+                acc[k] = _mm512_alignr_epi64(acc[k + 1], acc[k], 1);
+            }
+            acc[RADIX52_VECTORS - 1] = _mm512_alignr_epi64(zero, acc[RADIX52_VECTORS - 1], 1);
+            acc[0] = _mm512_mask_add_epi64(
+              acc[0], 1, acc[0], _mm512_set1_epi64(static_cast<long long>(low >> RADIX52_BITS)));
+
+            for (uint32_t k = 0; k < RADIX52_VECTORS; k++) {
+                acc[k] = _mm512_madd52hi_epu64(acc[k], av[k], bi);
+                acc[k] = _mm512_madd52hi_epu64(acc[k], nv[k], m);
+            }
+        }
+
+        // normalize the digits and repack them into limbs
+        alignas(64) uint64_t digits[RADIX52_DIGITS + 1];
+        for (uint32_t k = 0; k < RADIX52_VECTORS; k++) {
+            _mm512_store_si512(&digits[8 * k], acc[k]);
+        }
+        uint64_t carry = 0;
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            auto digit = digits[k] + carry;
+            digits[k] = digit & RADIX52_MASK;
+            carry = digit >> RADIX52_BITS;
+        }
+        digits[RADIX52_DIGITS] = carry;
+
+        uint64_t t[MAX_P_LEN + 2] = {};
+        fromRadix52(digits, t);
+
+        // the last digit of b and the remaining 40 bits of the reduction
+        const uint64_t finalMask = (1ULL << FINAL_REDUCTION_BITS) - 1;
+        mulAddScalar(t, a, b52[RADIX52_REDUCTIONS]);
+        mulAddScalar(t, n, (t[0] * mu) & finalMask);
+
+        uint64_t result[MAX_P_LEN];
+        for (uint32_t i = 0; i < MAX_P_LEN; i++) {
+            result[i] =
+              (t[i] >> FINAL_REDUCTION_BITS) | (t[i + 1] << (64 - FINAL_REDUCTION_BITS));
+        }
+        uint64_t top = (t[MAX_P_LEN] >> FINAL_REDUCTION_BITS) |
+                       (t[MAX_P_LEN + 1] << (64 - FINAL_REDUCTION_BITS));
+
+        conditionalSubtract(result, top, n);
+        conditionalSubtract(result, top, n);
+        copy(result, result + MAX_P_LEN, res);
+    }
+
+    /// <summary>
+    /// Almost montgomery multiplication of eight independent operands, one per lane.
+    ///
+    /// Each vector holds the same digit of all eight operands, so every lane
+    /// runs its own multiplication and no digit ever crosses lanes.
+    /// Writes a * b * 2^-4160 mod n, less than 2n, with normalized digits.
+    /// `res` may alias either operand.
+    /// </summary>
+    __attribute__((target("avx512f,avx512ifma"))) static void
+    ammLanes(const __m512i *a, const __m512i *b, const __m512i *n, __m512i k0, __m512i *res)
+    {
+        const __m512i zero = _mm512_setzero_si512();
+        __m512i t[RADIX52_DIGITS + 1];
+        for (uint32_t k = 0; k <= RADIX52_DIGITS; k++) {
+            t[k] = zero;
+        }
+
+        for (uint32_t i = 0; i < RADIX52_DIGITS; i++) {
+            auto bi = b[i];
+            t[0] = _mm512_madd52lo_epu64(t[0], a[0], bi);
+            auto m = _mm512_madd52lo_epu64(zero, t[0], k0);
+            t[0] = _mm512_madd52lo_epu64(t[0], n[0], m);
+            for (uint32_t k = 1; k < RADIX52_DIGITS; k++) {
+                t[k] = _mm512_madd52lo_epu64(_mm512_madd52lo_epu64(t[k], a[k], bi), n[k], m);
+            }
+
+            // the lowest digit is now a multiple of 2^52, drop it and
+            // add the high halves of the products one digit down
+            auto carry = _mm512_srli_epi64(t[0], RADIX52_BITS);
+            for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+                t[k] = _mm512_madd52hi_epu64(_mm512_madd52hi_epu64(t[k + 1], a[k], bi), n[k], m);
+            }
+            t[0] = _mm512_add_epi64(t[0], carry);
+        }
+
+        const __m512i mask = _mm512_set1_epi64(static_cast<long long>(RADIX52_MASK));
+        __m512i carry = zero;
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            auto digit = _mm512_add_epi64(t[k], carry);
+            res[k] = _mm512_and_si512(digit, mask);
+            carry = _mm512_srli_epi64(digit, RADIX52_BITS);
+        }
+    }
+
+    /// <summary>
+    /// Copy the entry selected by each lane's index out of the table,
+    /// reading every entry so the access pattern does not depend on the indices
+    /// </summary>
+    __attribute__((target("avx512f"))) static void
+    selectLanes(const __m512i *table, uint32_t entries, __m512i indices, __m512i *out)
+    {
+        __mmask8 masks[1U << MONTGOMERY_LANES_WINDOW];
+        for (uint32_t e = 0; e < entries; e++) {
+            masks[e] = _mm512_cmpeq_epi64_mask(indices, _mm512_set1_epi64(e));
+        }
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            auto digit = _mm512_setzero_si512();
+            for (uint32_t e = 0; e < entries; e++) {
+                digit = _mm512_mask_mov_epi64(digit, masks[e], table[e * RADIX52_DIGITS + k]);
+            }
+            out[k] = digit;
+        }
+    }
+
+    /// <summary>
+    /// Gather the exponent bits of one window from every lane, unused lanes select entry zero
+    /// </summary>
+    __attribute__((target("avx512f"))) static __m512i
+    windowIndices(const uint64_t *const *exponents, uint32_t count, uint32_t window)
+    {
+        const uint64_t windowMask = (1U << MONTGOMERY_LANES_WINDOW) - 1;
+        alignas(64) uint64_t indices[MONTGOMERY_LANES] = {};
+        auto bit = window * MONTGOMERY_LANES_WINDOW;
+        for (uint32_t lane = 0; lane < count; lane++) {
+            indices[lane] = (exponents[lane][bit / 64] >> (bit % 64)) & windowMask;
+        }
+        return _mm512_load_si512(indices);
+    }
+
+    __attribute__((target("avx512f,avx512ifma"))) void
+    pow_mod_4096_lanes_ifma(const uint64_t *n, uint64_t mu, const uint64_t *rr, uint32_t count,
+                            const uint64_t *const *bases, const uint64_t *const *exponents,
+                            uint64_t *const *results)
+    {
+        if (count > MONTGOMERY_LANES) {
+            throw invalid_argument("pow_mod_4096_lanes_ifma:: too many exponentiations");
+        }
+
+        // transpose the operands so each vector holds one digit of every lane,
+        // unused lanes raise zero to the zero power
+        alignas(64) uint64_t digits[RADIX52_DIGITS * MONTGOMERY_LANES] = {};
+        uint64_t laneDigits[RADIX52_DIGITS];
+        for (uint32_t lane = 0; lane < count; lane++) {
+            toRadix52(bases[lane], laneDigits);
+            for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+                digits[k * MONTGOMERY_LANES + lane] = laneDigits[k];
+            }
+        }
+
+        __m512i base[RADIX52_DIGITS];
+        __m512i nv[RADIX52_DIGITS];
+        __m512i rrv[RADIX52_DIGITS];
+        __m512i one[RADIX52_DIGITS];
+        uint64_t n52[RADIX52_DIGITS];
+        uint64_t rr52[RADIX52_DIGITS];
+        toRadix52(n, n52);
+        toRadix52(rr, rr52);
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            base[k] = _mm512_load_si512(&digits[k * MONTGOMERY_LANES]);
+            nv[k] = _mm512_set1_epi64(static_cast<long long>(n52[k]));
+            rrv[k] = _mm512_set1_epi64(static_cast<long long>(rr52[k]));
+            one[k] = _mm512_set1_epi64(k == 0 ? 1 : 0);
+        }
+        const auto k0 = _mm512_set1_epi64(static_cast<long long>(mu & RADIX52_MASK));
+
+        // fixed window table of base^e in montgomery form
+        const uint32_t entries = 1U << MONTGOMERY_LANES_WINDOW;
+        __m512i table[entries * RADIX52_DIGITS];
+        ammLanes(one, rrv, nv, k0, &table[0]);
+        ammLanes(base, rrv, nv, k0, &table[RADIX52_DIGITS]);
+        for (uint32_t e = 2; e < entries; e++) {
+            ammLanes(&table[(e - 1) * RADIX52_DIGITS], &table[RADIX52_DIGITS], nv, k0,
+                     &table[e * RADIX52_DIGITS]);
+        }
+
+        const uint32_t windows = MAX_Q_LEN * 64 / MONTGOMERY_LANES_WINDOW;
+        __m512i acc[RADIX52_DIGITS];
+        __m512i entry[RADIX52_DIGITS];
+        selectLanes(table, entries, windowIndices(exponents, count, windows - 1), acc);
+        for (uint32_t window = windows - 1; window-- > 0;) {
+            for (uint32_t j = 0; j < MONTGOMERY_LANES_WINDOW; j++) {
+                ammLanes(acc, acc, nv, k0, acc);
+            }
+            selectLanes(table, entries, windowIndices(exponents, count, window), entry);
+            ammLanes(acc, entry, nv, k0, acc);
+        }
+
+        // leave montgomery form, which leaves each lane at most n
+        ammLanes(acc, one, nv, k0, acc);
+        for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+            _mm512_store_si512(&digits[k * MONTGOMERY_LANES], acc[k]);
+        }
+        for (uint32_t lane = 0; lane < count; lane++) {
+            uint64_t laneResult[RADIX52_DIGITS + 1] = {};
+            for (uint32_t k = 0; k < RADIX52_DIGITS; k++) {
+                laneResult[k] = digits[k * MONTGOMERY_LANES + lane];
+            }
+            uint64_t limbs[MAX_P_LEN + 2] = {};
+            fromRadix52(laneResult, limbs);
+            conditionalSubtract(limbs, limbs[MAX_P_LEN], n);
+            copy(limbs, limbs + MAX_P_LEN, results[lane]);
+        }
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#endif
+
+#pragma endregion
+
+#else
+
+    void montgomery_mul_4096_adx(const uint64_t *n, uint64_t mu, const uint64_t *a,
+                                 const uint64_t *b, uint64_t *res)
+    {
+        throw invalid_argument("montgomery_mul_4096_adx:: kernel is not available");
+    }
+
+    void montgomery_mul_4096_ifma(const uint64_t *n, uint64_t mu, const uint64_t *a,
+                                  const uint64_t *b, uint64_t *res)
+    {
+        throw invalid_argument("montgomery_mul_4096_ifma:: kernel is not available");
+    }
+
+    void pow_mod_4096_lanes_ifma(const uint64_t *n, uint64_t mu, const uint64_t *rr, uint32_t count,
+                                 const uint64_t *const *bases, const uint64_t *const *exponents,
+                                 uint64_t *const *results)
+    {
+        throw invalid_argument("pow_mod_4096_lanes_ifma:: kernel is not available");
+    }
+
+#endif // EG_MONTGOMERY_X86_KERNELS
+
+} // namespace electionguard
@@ -0,0 +1,101 @@
+#ifndef __ELECTIONGUARD_CPP_MONTGOMERY_KERNELS_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_MONTGOMERY_KERNELS_HPP_INCLUDED__
+
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The implementations of the 4096-bit montgomery multiplication.
+    ///
+    /// `portable` is the hacl implementation, which is always available and
+    /// serves as the reference the other kernels are checked against.
+    /// `adx` uses the MULX, ADCX and ADOX instructions (Broadwell and later).
+    /// `ifma` uses AVX-512 IFMA with a 52-bit radix (Ice Lake and later).
+    /// </summary>
+    enum class MontgomeryKernel { portable = 0, adx = 1, ifma = 2 };
+
+    /// <summary>
+    /// Check whether the kernel was compiled in and the processor supports it
+    /// </summary>
+    EG_INTERNAL_API bool isMontgomeryKernelSupported(MontgomeryKernel kernel);
+
+    /// <summary>
+    /// The fastest kernel supported by the processor, selected at startup
+    /// </summary>
+    EG_INTERNAL_API MontgomeryKernel detectMontgomeryKernel();
+
+    /// <summary>
+    /// The kernel currently used by the 4096-bit montgomery multiplication
+    /// </summary>
+    EG_INTERNAL_API MontgomeryKernel getMontgomeryKernel();
+
+    /// <summary>
+    /// Select the kernel used by the 4096-bit montgomery multiplication.
+    /// Throws invalid_argument if the kernel is not supported on this processor.
+    /// </summary>
+    EG_INTERNAL_API void setMontgomeryKernel(MontgomeryKernel kernel);
+
+    /// <summary>
+    /// Write `a * b * 2^-4096 mod n` in `res` with the selected kernel.
+    ///
+    /// n is an odd 4096-bit modulus, mu is -n^-1 mod 2^64 and a, b are less than n.
+    /// `res` may alias either operand.
+    /// Returns false without writing `res` when the portable kernel is selected,
+    /// in which case the caller uses hacl.
+    /// </summary>
+    EG_INTERNAL_API bool montgomery_mul_4096(const uint64_t *n, uint64_t mu, const uint64_t *a,
+                                             const uint64_t *b, uint64_t *res);
+
+    /// <summary>
+    /// Write `a * b * 2^-4096 mod n` in `res` using MULX, ADCX and ADOX.
+    /// Only call when isMontgomeryKernelSupported(MontgomeryKernel::adx).
+    /// </summary>
+    EG_INTERNAL_API void montgomery_mul_4096_adx(const uint64_t *n, uint64_t mu, const uint64_t *a,
+                                                 const uint64_t *b, uint64_t *res);
+
+    /// <summary>
+    /// Write `a * b * 2^-4096 mod n` in `res` using AVX-512 IFMA.
+    /// Only call when isMontgomeryKernelSupported(MontgomeryKernel::ifma).
+    /// </summary>
+    EG_INTERNAL_API void montgomery_mul_4096_ifma(const uint64_t *n, uint64_t mu,
+                                                  const uint64_t *a, const uint64_t *b,
+                                                  uint64_t *res);
+
+    /// <summary>
+    /// The number of independent exponentiations evaluated at once by the lane kernel
+    /// </summary>
+    const uint32_t MONTGOMERY_LANES = 8;
+
+    /// <summary>
+    /// The fixed window size, in bits, of the lane kernel's exponentiation
+    /// </summary>
+    const uint32_t MONTGOMERY_LANES_WINDOW = 4;
+
+    /// <summary>
+    /// Check whether independent exponentiations can be interleaved across vector lanes,
+    /// which is the case when the ifma kernel is selected
+    /// </summary>
+    EG_INTERNAL_API bool canUseMontgomeryLanes();
+
+    /// <summary>
+    /// Write `bases[i] ^ exponents[i] mod n` in `results[i]` for up to MONTGOMERY_LANES
+    /// independent exponentiations at once, one per AVX-512 lane.
+    ///
+    /// n is an odd 4096-bit modulus, mu is -n^-1 mod 2^64 and rr is 2^8320 mod n,
+    /// which converts into the kernel's own montgomery form.
+    /// The bases are less than n and the exponents are 256-bit, i.e. uint64_t[4].
+    /// Every lane runs the same sequence of operations and the window
+    /// entries are selected without data dependent memory accesses.
+    /// Only call when canUseMontgomeryLanes().
+    /// </summary>
+    EG_INTERNAL_API void pow_mod_4096_lanes_ifma(const uint64_t *n, uint64_t mu, const uint64_t *rr,
+                                                 uint32_t count, const uint64_t *const *bases,
+                                                 const uint64_t *const *exponents,
+                                                 uint64_t *const *results);
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_MONTGOMERY_KERNELS_HPP_INCLUDED__ */
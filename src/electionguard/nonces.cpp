@@ -1,27 +1,32 @@
 #include "nonces.hpp"
 
 #include "electionguard/hash.hpp"
+#include "hash_stream.hpp"
 #include "log.hpp"
 #include "variant_cast.hpp"
 
 using std::make_unique;
 using std::string;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
     struct Nonces::Impl {
 
         unique_ptr<ElementModQ> seed;
+        // every nonce hashes the seed first, so the seed is only absorbed once
+        HashPrefix prefix;
         uint64_t nextItem;
 
         Impl(const ElementModQ &seed, const NoncesHeaderType &headers)
         {
             CryptoHashableType headers_ = variant_cast(headers);
             this->seed = hash_elems({&const_cast<ElementModQ &>(seed), headers_});
+            prefix = HashPrefix({this->seed.get()});
             nextItem = 0;
         }
-        explicit Impl(const ElementModQ &seed)
+        explicit Impl(const ElementModQ &seed) : prefix({std::cref(seed)})
         {
             this->seed = make_unique<ElementModQ>(const_cast<ElementModQ &>(seed));
             nextItem = 0;
@@ -30,13 +35,26 @@ namespace electionguard
         unique_ptr<ElementModQ> get(uint64_t item)
         {
             nextItem = item + 1;
-            return hash_elems({seed.get(), item});
+            return hash_elems(prefix, item);
         }
 
-        unique_ptr<ElementModQ> get(uint64_t item, string headers)
+        unique_ptr<ElementModQ> get(uint64_t item, const string &headers)
         {
             nextItem = item + 1;
-            return hash_elems({seed.get(), item, headers});
+            return hash_elems(prefix, item, headers);
+        }
+
+        vector<unique_ptr<ElementModQ>> get(uint64_t startItem, uint64_t count)
+        {
+            // TODO: ISSUE #137: address possible overflow
+            vector<HashStream> streams(count, prefix.begin());
+            for (uint64_t i = 0; i < count; i++) {
+                streams[i].append(startItem + i);
+            }
+            if (count > 0) {
+                nextItem = startItem + count;
+            }
+            return HashStream::finishBatch(streams);
         }
 
         unique_ptr<ElementModQ> next() { return this->get(nextItem); }
@@ -66,13 +84,7 @@ namespace electionguard
 
     vector<unique_ptr<ElementModQ>> Nonces::get(uint64_t startItem, uint64_t count)
     {
-        // TODO: ISSUE #137: preallocate and address possible overflow
-        vector<unique_ptr<ElementModQ>> result;
-        uint64_t endItem = startItem + count;
-        for (uint64_t i(startItem); i < endItem; i++) {
-            result.push_back(this->get(i));
-        }
-        return result;
+        return pimpl->get(startItem, count);
     }
 
     unique_ptr<ElementModQ> Nonces::next() { return pimpl->next(); }
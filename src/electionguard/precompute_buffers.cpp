@@ -11,13 +11,16 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 using std::begin;
 using std::copy;
 using std::end;
 using std::lock_guard;
 using std::make_unique;
+using std::reference_wrapper;
 using std::unique_ptr;
+using std::vector;
 
 namespace electionguard
 {
@@ -65,8 +68,9 @@ namespace electionguard
     {
         // generate a random rho
         exp = rand_q();
-        g_to_exp = g_pow_p(*exp);
-        pubkey_to_exp = pow_mod_p(publicKey, *exp);
+        auto powers = pow_mod_p_shared_exponent({G(), publicKey}, *exp);
+        g_to_exp = move(powers[0]);
+        pubkey_to_exp = move(powers[1]);
     }
 
     unique_ptr<Triple> Triple::clone()
@@ -128,7 +132,7 @@ namespace electionguard
         exp1 = rand_q();
         exp2 = rand_q();
         g_to_exp1 = g_pow_p(*exp1);
-        g_to_exp2_mult_by_pubkey_to_exp1 = mul_mod_p(*g_pow_p(*exp2), *pow_mod_p(publicKey, *exp1));
+        g_to_exp2_mult_by_pubkey_to_exp1 = multi_pow_mod_p({G(), publicKey}, {*exp2, *exp1});
     }
 
     unique_ptr<Quadruple> Quadruple::clone()
@@ -213,32 +217,57 @@ namespace electionguard
             // If not we can get more elaborate with the populate_OK checking
             std::lock_guard<std::mutex> lock(queue_lock);
             if (getInstance().populate_OK) {
-                // generate two triples and a quadruple
+                // generate two triples and a quadruple, and every third iteration
+                // two extra triples, one for use with the contest constant chaum pedersen
+                // proof and one for hashed elgamal encryption.
                 //
-                // these constuctors will generate the precomputed values
-                unique_ptr<Triple> triple1 = make_unique<Triple>(elgamalPublicKey);
-                unique_ptr<Triple> triple2 = make_unique<Triple>(elgamalPublicKey);
-                unique_ptr<Quadruple> quad = make_unique<Quadruple>(elgamalPublicKey);
+                // This is very rudimentary. We can add a more complex algorithm in
+                // the future, that would look at the queues and increase production if one
+                // is getting lower than expected.
+                // We need less of the extra triples because this exponentiation is done only
+                // every contest encryption whereas the two triples and a quadruple is used
+                // every selection encryption. The generating two triples every third iteration
+                // is a guess on how many precomputes we will need.
+                bool withContestTriples = (iteration_count % 3) == 0;
+                size_t count = withContestTriples ? 5U : 3U;
+
+                // the public key powers are independent exponentiations
+                // so they are evaluated together, across vector lanes where supported
+                vector<unique_ptr<ElementModQ>> exps;
+                vector<reference_wrapper<const ElementModP>> bases;
+                vector<reference_wrapper<const ElementModQ>> exponents;
+                for (size_t i = 0; i < count; i++) {
+                    exps.push_back(rand_q());
+                    bases.push_back(elgamalPublicKey);
+                    exponents.push_back(*exps.back());
+                }
+                auto pubkeyPowers = pow_mod_p_batch(bases, exponents);
+
+                auto makeTriple = [&](size_t i) {
+                    auto g_to_exp = g_pow_p(*exps[i]);
+                    return make_unique<Triple>(move(exps[i]), move(g_to_exp),
+                                               move(pubkeyPowers[i]));
+                };
+
+                unique_ptr<Triple> triple1 = makeTriple(0);
+                unique_ptr<Triple> triple2 = makeTriple(1);
+
+                auto exp2 = rand_q();
+                auto g_to_exp1 = g_pow_p(*exps[2]);
+                auto g_to_exp2_mult_by_pubkey_to_exp1 =
+                  mul_mod_p(*g_pow_p(*exp2), *pubkeyPowers[2]);
+                unique_ptr<Quadruple> quad =
+                  make_unique<Quadruple>(move(exps[2]), move(exp2), move(g_to_exp1),
+                                         move(g_to_exp2_mult_by_pubkey_to_exp1));
 
                 unique_ptr<TwoTriplesAndAQuadruple> twoTriplesAndAQuadruple =
                   make_unique<TwoTriplesAndAQuadruple>(move(triple1), move(triple2), move(quad));
 
                 getInstance().twoTriplesAndAQuadruple_queue.push(move(twoTriplesAndAQuadruple));
 
-                // This is very rudimentary. We can add a more complex algorithm in
-                // the future, that would look at the queues and increase production if one
-                // is getting lower than expected.
-                // Every third iteration we generate two extra triples, one for use with
-                // the contest constant chaum pedersen proof and one for hashed elgamal encryption
-                // we need less of these because this exponentiation is done only every contest
-                // encryption whereas the two triples and a quadruple is used every selection
-                // encryption. The generating two triples every third iteration is a guess
-                // on how many precomputes we will need.
-                if ((iteration_count % 3) == 0) {
-                    unique_ptr<Triple> contest_triple1 = make_unique<Triple>(elgamalPublicKey);
-                    getInstance().triple_queue.push(move(contest_triple1));
-                    unique_ptr<Triple> contest_triple2 = make_unique<Triple>(elgamalPublicKey);
-                    getInstance().triple_queue.push(move(contest_triple2));
+                if (withContestTriples) {
+                    getInstance().triple_queue.push(makeTriple(3));
+                    getInstance().triple_queue.push(makeTriple(4));
                 }
                 iteration_count++;
             } else {
@@ -0,0 +1,281 @@
+#include "q_field.hpp"
+
+#include "facades/Hacl_Bignum256.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+using hacl::Bignum256;
+using hacl::CONTEXT_Q;
+using std::copy;
+
+namespace electionguard
+{
+#pragma region Limb Helpers
+
+#if defined(__SIZEOF_INT128__)
+    // the 128 bit integer is a compiler extension, so it is declared without a pedantic warning
+    __extension__ typedef unsigned __int128 uint128_t;
+#endif
+
+    /// <summary>
+    /// Add with carry, the carry in and out are 0 or 1
+    /// </summary>
+    static inline uint64_t addCarry(uint64_t a, uint64_t b, uint64_t carryIn, uint64_t &carryOut)
+    {
+        uint64_t sum = a + b;
+        uint64_t carry = sum < a ? 1 : 0;
+        uint64_t result = sum + carryIn;
+        carryOut = carry | (result < sum ? 1 : 0);
+        return result;
+    }
+
+    /// <summary>
+    /// Subtract with borrow, the borrow in and out are 0 or 1
+    /// </summary>
+    static inline uint64_t subBorrow(uint64_t a, uint64_t b, uint64_t borrowIn,
+                                     uint64_t &borrowOut)
+    {
+        uint64_t difference = a - b;
+        uint64_t borrow = a < b ? 1 : 0;
+        uint64_t result = difference - borrowIn;
+        borrowOut = borrow | (difference < borrowIn ? 1 : 0);
+        return result;
+    }
+
+    /// <summary>
+    /// a * b + c + d, writing the high limb in `hi`. Cannot overflow 128 bits.
+    /// </summary>
+    static inline uint64_t mulAdd(uint64_t a, uint64_t b, uint64_t c, uint64_t d, uint64_t &hi)
+    {
+#if defined(_MSC_VER) && defined(_M_X64)
+        uint64_t lo = _umul128(a, b, &hi);
+        uint64_t carry = 0;
+        lo = addCarry(lo, c, 0, carry);
+        hi += carry;
+        lo = addCarry(lo, d, 0, carry);
+        hi += carry;
+        return lo;
+#elif defined(__SIZEOF_INT128__)
+        uint128_t product = static_cast<uint128_t>(a) * b;
+        product += c;
+        product += d;
+        hi = static_cast<uint64_t>(product >> 64);
+        return static_cast<uint64_t>(product);
+#else
+        const uint64_t mask32 = 0xFFFFFFFFULL;
+        uint64_t aLo = a & mask32;
+        uint64_t aHi = a >> 32;
+        uint64_t bLo = b & mask32;
+        uint64_t bHi = b >> 32;
+
+        uint64_t loLo = aLo * bLo;
+        uint64_t hiLo = aHi * bLo;
+        uint64_t loHi = aLo * bHi;
+        uint64_t hiHi = aHi * bHi;
+
+        uint64_t middle = (loLo >> 32) + (hiLo & mask32) + loHi;
+        uint64_t lo = (middle << 32) | (loLo & mask32);
+        hi = hiHi + (hiLo >> 32) + (middle >> 32);
+
+        uint64_t carry = 0;
+        lo = addCarry(lo, c, 0, carry);
+        hi += carry;
+        lo = addCarry(lo, d, 0, carry);
+        hi += carry;
+        return lo;
+#endif
+    }
+
+    /// <summary>
+    /// All ones when `bit` is 1 and zero when it is 0
+    /// </summary>
+    static inline uint64_t maskOf(uint64_t bit) { return 0 - bit; }
+
+    /// <summary>
+    /// 1 when a &lt; b, compared without branching on the limbs
+    /// </summary>
+    static inline uint64_t lessThan(const uint64_t *a, const uint64_t *b)
+    {
+        uint64_t borrow = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            subBorrow(a[i], b[i], borrow, borrow);
+        }
+        return borrow;
+    }
+
+    /// <summary>
+    /// 1 when every limb is all ones, i.e. a == 2^256 - 1
+    /// </summary>
+    static inline uint64_t isMax(const uint64_t *a)
+    {
+        uint64_t all = a[0];
+        for (uint32_t i = 1; i < MAX_Q_LEN; i++) {
+            all &= a[i];
+        }
+        // all + 1 wraps to zero only when every bit is set
+        uint64_t carry = 0;
+        addCarry(all, 1, 0, carry);
+        return carry;
+    }
+
+    /// <summary>
+    /// a += (b &amp; mask) mod 2^256, returning the carry
+    /// </summary>
+    static inline uint64_t addMasked(uint64_t *a, const uint64_t *b, uint64_t mask)
+    {
+        uint64_t carry = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            a[i] = addCarry(a[i], b[i] & mask, carry, carry);
+        }
+        return carry;
+    }
+
+    /// <summary>
+    /// a -= (b &amp; mask) mod 2^256, returning the borrow
+    /// </summary>
+    static inline uint64_t subMasked(uint64_t *a, const uint64_t *b, uint64_t mask)
+    {
+        uint64_t borrow = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            a[i] = subBorrow(a[i], b[i] & mask, borrow, borrow);
+        }
+        return borrow;
+    }
+
+#pragma endregion
+
+#pragma region Reduction
+
+    void mod_q_reduce(const uint64_t *a, uint64_t *res)
+    {
+#ifdef USE_STANDARD_PRIMES
+        // a < 2^256 < 2q, so a single subtraction of q is enough.
+        // a >= q exactly when a + (2^256 - q) carries out of 256 bits
+        uint64_t shifted[MAX_Q_LEN];
+        copy(a, a + MAX_Q_LEN, shifted);
+        auto mask = maskOf(addMasked(shifted, Q_ARRAY_INVERSE_OFFSET, maskOf(1)));
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            res[i] = (shifted[i] & mask) | (a[i] & ~mask);
+        }
+#else
+        uint64_t wide[MAX_Q_LEN_DOUBLE] = {};
+        copy(a, a + MAX_Q_LEN, wide);
+        CONTEXT_Q().mod(static_cast<uint64_t *>(wide), res);
+#endif
+    }
+
+    void mod_q_reduce_wide(const uint64_t *wide, uint64_t *res)
+    {
+#ifdef USE_STANDARD_PRIMES
+        // wide = high * 2^256 + low, congruent to low + 189 * high
+        const uint64_t c = Q_ARRAY_INVERSE_OFFSET[0];
+        uint64_t folded[MAX_Q_LEN];
+        uint64_t top = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            folded[i] = mulAdd(c, wide[MAX_Q_LEN + i], wide[i], top, top);
+        }
+
+        // the overflow is at most 189, fold it once more
+        uint64_t carry = 0;
+        folded[0] = addCarry(folded[0], c * top, 0, carry);
+        for (uint32_t i = 1; i < MAX_Q_LEN; i++) {
+            folded[i] = addCarry(folded[i], 0, carry, carry);
+        }
+
+        // a final carry leaves a value below 2^16 behind, so folding it cannot carry again
+        uint64_t carryFold[MAX_Q_LEN] = {c};
+        addMasked(folded, carryFold, maskOf(carry));
+
+        mod_q_reduce(folded, res);
+#else
+        uint64_t copied[MAX_Q_LEN_DOUBLE];
+        copy(wide, wide + MAX_Q_LEN_DOUBLE, copied);
+        CONTEXT_Q().mod(static_cast<uint64_t *>(copied), res);
+#endif
+    }
+
+#pragma endregion
+
+#pragma region Arithmetic
+
+    void mod_q_add(const uint64_t *a, const uint64_t *b, uint64_t *res)
+    {
+        uint64_t sum[MAX_Q_LEN];
+        uint64_t carry = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            sum[i] = addCarry(a[i], b[i], carry, carry);
+        }
+
+        // when the sum reaches 2^256 - 1 it is offset by 2^256 - q, or by 2^256 - q + 1
+        // for each operand above q, wrapping around 2^256
+        auto overflow = carry | isMax(sum);
+        auto bigA = lessThan(Q_ARRAY_REVERSE, a);
+        auto bigB = lessThan(Q_ARRAY_REVERSE, b);
+        auto big = bigA | bigB;
+        addMasked(sum, Q_ARRAY_INVERSE_OFFSET, maskOf(overflow & bigA));
+        addMasked(sum, ONE_MOD_Q_ARRAY, maskOf(overflow & bigA));
+        addMasked(sum, Q_ARRAY_INVERSE_OFFSET, maskOf(overflow & bigB));
+        addMasked(sum, ONE_MOD_Q_ARRAY, maskOf(overflow & bigB));
+        addMasked(sum, Q_ARRAY_INVERSE_OFFSET, maskOf(overflow & (big ^ 1)));
+
+        mod_q_reduce(sum, res);
+    }
+
+    void mod_q_sub(const uint64_t *a, const uint64_t *b, uint64_t *res)
+    {
+        uint64_t difference[MAX_Q_LEN];
+        uint64_t borrow = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            difference[i] = subBorrow(a[i], b[i], borrow, borrow);
+        }
+
+        // a borrow is offset by 2^256 - q, or by 2^256 - q + 1
+        // when either operand is above q, wrapping around 2^256
+        auto big = lessThan(Q_ARRAY_REVERSE, a) | lessThan(Q_ARRAY_REVERSE, b);
+        subMasked(difference, Q_ARRAY_INVERSE_OFFSET, maskOf(borrow));
+        subMasked(difference, ONE_MOD_Q_ARRAY, maskOf(borrow & big));
+
+        mod_q_reduce(difference, res);
+    }
+
+    void mod_q_mul_add(const uint64_t *a, const uint64_t *b, const uint64_t *c, uint64_t *res)
+    {
+        uint64_t wide[MAX_Q_LEN_DOUBLE] = {};
+        Bignum256::mul(const_cast<uint64_t *>(b), const_cast<uint64_t *>(c),
+                       static_cast<uint64_t *>(wide));
+
+        // a + b * c <= 2^512 - 2^256, the sum fits in the wide buffer
+        uint64_t carry = 0;
+        for (uint32_t i = 0; i < MAX_Q_LEN; i++) {
+            wide[i] = addCarry(wide[i], a[i], carry, carry);
+        }
+        for (uint32_t i = MAX_Q_LEN; i < MAX_Q_LEN_DOUBLE; i++) {
+            wide[i] = addCarry(wide[i], 0, carry, carry);
+        }
+
+        mod_q_reduce_wide(static_cast<uint64_t *>(wide), res);
+    }
+
+    void mod_q_mul_sub(const uint64_t *a, const uint64_t *b, const uint64_t *c, uint64_t *res)
+    {
+        const uint64_t zero[MAX_Q_LEN] = {};
+        uint64_t product[MAX_Q_LEN];
+        mod_q_mul_add(static_cast<const uint64_t *>(zero), b, c,
+                      static_cast<uint64_t *>(product));
+
+        uint64_t reduced[MAX_Q_LEN];
+        mod_q_reduce(a, reduced);
+
+        // both are below q, so adding q back once on a borrow is enough
+        auto borrow = subMasked(reduced, product, maskOf(1));
+        addMasked(reduced, Q_ARRAY_REVERSE, maskOf(borrow));
+        copy(reduced, reduced + MAX_Q_LEN, res);
+    }
+
+#pragma endregion
+
+} // namespace electionguard
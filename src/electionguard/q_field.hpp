@@ -0,0 +1,62 @@
+#ifndef __ELECTIONGUARD_CPP_Q_FIELD_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_Q_FIELD_HPP_INCLUDED__
+
+#include <cstdint>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+
+namespace electionguard
+{
+    /// <summary>
+    /// Arithmetic on 256-bit limbs in the field of the small prime Q.
+    ///
+    /// The standard Q is the pseudo-mersenne prime 2^256 - 189, so 2^256 is congruent
+    /// to 189 and a wide value is reduced by folding its high half back into the low
+    /// half, followed by a single conditional subtraction, instead of a long division.
+    /// With the test primes the reductions fall back to the general hacl reduction.
+    ///
+    /// The kernels work on the stack, run the same sequence of operations
+    /// regardless of the operands and `res` may alias any operand.
+    /// </summary>
+
+    /// <summary>
+    /// Write `a mod q` in `res` for any 256-bit `a`
+    /// </summary>
+    EG_INTERNAL_API void mod_q_reduce(const uint64_t *a, uint64_t *res);
+
+    /// <summary>
+    /// Write `wide mod q` in `res` for any 512-bit `wide`, i.e. uint64_t[MAX_Q_LEN_DOUBLE]
+    /// </summary>
+    EG_INTERNAL_API void mod_q_reduce_wide(const uint64_t *wide, uint64_t *res);
+
+    /// <summary>
+    /// Write `(a + b) mod q` in `res`.
+    ///
+    /// Operands in the range (Q, 2^256) are offset the same way add_mod_q
+    /// has always offset them, so the results are unchanged for every input.
+    /// </summary>
+    EG_INTERNAL_API void mod_q_add(const uint64_t *a, const uint64_t *b, uint64_t *res);
+
+    /// <summary>
+    /// Write `(a - b) mod q` in `res`.
+    ///
+    /// Operands in the range (Q, 2^256) are offset the same way sub_mod_q
+    /// has always offset them, so the results are unchanged for every input.
+    /// </summary>
+    EG_INTERNAL_API void mod_q_sub(const uint64_t *a, const uint64_t *b, uint64_t *res);
+
+    /// <summary>
+    /// Write `(a + b * c) mod q` in `res`
+    /// </summary>
+    EG_INTERNAL_API void mod_q_mul_add(const uint64_t *a, const uint64_t *b, const uint64_t *c,
+                                       uint64_t *res);
+
+    /// <summary>
+    /// Write `(a - b * c) mod q` in `res`
+    /// </summary>
+    EG_INTERNAL_API void mod_q_mul_sub(const uint64_t *a, const uint64_t *b, const uint64_t *c,
+                                       uint64_t *res);
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_Q_FIELD_HPP_INCLUDED__ */
@@ -1,9 +1,9 @@
 #ifndef __ELECTIONGUARD_CPP_SERIALIZE_HPP_INCLUDED__
 #define __ELECTIONGUARD_CPP_SERIALIZE_HPP_INCLUDED__
 
-#include "../karamel/Hacl_HMAC_DRBG.h"
 #include "../karamel/Lib_RandomBuffer_System.h"
 #include "convert.hpp"
+#include "hmac_drbg.hpp"
 #include "log.hpp"
 
 #include <ctime>
@@ -31,7 +31,7 @@ namespace electionguard
     };
 
     /// <summary>
-    /// A convenience wrapper around the HACL* HMAC Deterministic Random Bit Generator
+    /// A convenience wrapper around the HMAC Deterministic Random Bit Generator
     /// that supports retrieving an arbitrary number of pseudo-random bytes as specified.
     ///
     /// This implementation currently does not support reseeding the same instantiation
@@ -56,47 +56,33 @@ namespace electionguard
             // Get some random bytes from the operating system
             auto entropy = getRandomBytes(static_cast<uint32_t>(size * 2));
 
-            // Allocate the DRBG
-            Hacl_HMAC_DRBG_state state = Hacl_HMAC_DRBG_create_in(hashAlgo);
-
             // Derive a nonce from the OS entropy pool
             auto nonce = getRandomBytes(size);
 
             // Derive a personalization string from the system clock
-            auto personalization = getTime();
+            auto time = getTime();
+            vector<uint8_t> personalization(time.begin(), time.end());
 
             // Instantiate the DRBG
-            Hacl_HMAC_DRBG_instantiate(hashAlgo, state, convert(entropy.size()), entropy.data(),
-                                       convert(nonce.size()), nonce.data(),
-                                       convert(personalization.size()),
-                                       reinterpret_cast<uint8_t *>(personalization.data()));
+            HmacDrbg drbg(entropy, nonce, personalization);
 
-            auto *array = new uint8_t[size];
+            vector<uint8_t> result(size);
             auto input = getRandomBytes(size);
 
             // Try to generate some random bits
-            if (Hacl_HMAC_DRBG_generate(hashAlgo, array, state, size, convert(input.size()),
-                                        input.data())) {
-                vector<uint8_t> result(array, array + size);
-                cleanup(state, entropy, nonce);
-                delete[] array;
-                return result;
-            } else {
-                cleanup(state, entropy, nonce);
-                delete[] array;
+            auto generated = drbg.generate(result.data(), result.size(), input);
+            cleanup(entropy, nonce);
+            if (!generated) {
                 throw bad_alloc();
             }
+            return result;
         }
 
       private:
-        static void cleanup(Hacl_HMAC_DRBG_state &state, vector<uint8_t> entropy,
-                            vector<uint8_t> nonce)
+        static void cleanup(vector<uint8_t> &entropy, vector<uint8_t> &nonce)
         {
             release(entropy);
             release(nonce);
-            free(state.k);
-            free(state.v);
-            free(state.reseed_counter);
         }
 
         /// <summary>
@@ -133,10 +119,6 @@ namespace electionguard
 #endif
             return stream.str();
         }
-
-        // statically pin the hashing algorithm to SHA256
-        static const Spec_Hash_Definitions_hash_alg hashAlgo =
-          static_cast<Spec_Hash_Definitions_hash_alg>(Spec_Hash_Definitions_SHA2_256);
     };
 } // namespace electionguard
 
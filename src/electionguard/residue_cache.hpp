@@ -0,0 +1,154 @@
+#ifndef __ELECTIONGUARD_CPP_RESIDUE_CACHE_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_RESIDUE_CACHE_HPP_INCLUDED__
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <electionguard/constants.h>
+#include <electionguard/export.h>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The default number of elements remembered by the ResidueCache. The cache is opt-in:
+    /// bulk verification mostly checks distinct values, which would only contend on the lock
+    /// </summary>
+    const size_t RESIDUE_CACHE_DEFAULT_CAPACITY = 0U;
+
+    /// <summary>
+    /// A bounded, process-wide record of the elements mod p that have been
+    /// proven to be valid residues, i.e. members of the order q subgroup.
+    ///
+    /// Once an element is validated, checking any other instance holding the same
+    /// value only costs a lookup instead of an exponentiation by q.
+    /// When the capacity is reached the oldest entries are evicted first.
+    /// The cache is disabled by a capacity of zero, the default, and then takes no lock.
+    /// </summary>
+    class EG_INTERNAL_API ResidueCache
+    {
+        typedef std::array<uint64_t, MAX_P_LEN> Element;
+
+      public:
+        ResidueCache(const ResidueCache &) = delete;
+        ResidueCache(ResidueCache &&) = delete;
+        ResidueCache &operator=(const ResidueCache &) = delete;
+        ResidueCache &operator=(ResidueCache &&) = delete;
+
+      private:
+        ResidueCache() {}
+        ~ResidueCache() {}
+
+      public:
+        static ResidueCache &getInstance()
+        {
+            static ResidueCache instance;
+            return instance;
+        }
+
+        /// <summary>
+        /// Check whether the element was previously recorded as a valid residue
+        /// </summary>
+        static bool contains(const uint64_t (&elem)[MAX_P_LEN], uint64_t digest)
+        {
+            auto &instance = getInstance();
+            if (instance.capacity.load(std::memory_order_relaxed) == 0) {
+                return false;
+            }
+            std::shared_lock<std::shared_mutex> lock(instance.cache_lock);
+            auto range = instance.entries.equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (std::equal(std::begin(elem), std::end(elem), it->second.begin())) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// <summary>
+        /// Record the element as a valid residue
+        /// </summary>
+        static void insert(const uint64_t (&elem)[MAX_P_LEN], uint64_t digest)
+        {
+            auto &instance = getInstance();
+            if (instance.capacity.load(std::memory_order_relaxed) == 0) {
+                return;
+            }
+            std::unique_lock<std::shared_mutex> lock(instance.cache_lock);
+            auto range = instance.entries.equal_range(digest);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (std::equal(std::begin(elem), std::end(elem), it->second.begin())) {
+                    return;
+                }
+            }
+
+            Element element;
+            std::copy(std::begin(elem), std::end(elem), element.begin());
+            auto inserted = instance.entries.emplace(digest, element);
+            instance.order.emplace_back(digest, &inserted->second);
+            instance.evict();
+        }
+
+        /// <summary>
+        /// Set the maximum number of elements to remember, evicting the oldest
+        /// entries if needed. A capacity of zero disables the cache.
+        /// </summary>
+        static void setCapacity(size_t capacity)
+        {
+            auto &instance = getInstance();
+            std::unique_lock<std::shared_mutex> lock(instance.cache_lock);
+            instance.capacity = capacity;
+            instance.evict();
+        }
+
+        static size_t getCapacity() { return getInstance().capacity.load(); }
+
+        static size_t size()
+        {
+            auto &instance = getInstance();
+            std::shared_lock<std::shared_mutex> lock(instance.cache_lock);
+            return instance.entries.size();
+        }
+
+        static void clear()
+        {
+            auto &instance = getInstance();
+            std::unique_lock<std::shared_mutex> lock(instance.cache_lock);
+            instance.order.clear();
+            instance.entries.clear();
+        }
+
+      private:
+        typedef std::unordered_multimap<uint64_t, Element> EntryMap;
+
+        std::shared_mutex cache_lock;
+        // written under the lock, read without it to skip a disabled cache
+        std::atomic<size_t> capacity{RESIDUE_CACHE_DEFAULT_CAPACITY};
+        EntryMap entries;
+        // insertion order, held by address since rehashing invalidates iterators
+        std::deque<std::pair<uint64_t, const Element *>> order;
+
+        void evict()
+        {
+            while (entries.size() > capacity && !order.empty()) {
+                auto [digest, oldest] = order.front();
+                auto range = entries.equal_range(digest);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (&it->second == oldest) {
+                        entries.erase(it);
+                        break;
+                    }
+                }
+                order.pop_front();
+            }
+        }
+    };
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_RESIDUE_CACHE_HPP_INCLUDED__ */
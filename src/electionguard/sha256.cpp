@@ -0,0 +1,239 @@
+#include "sha256.hpp"
+
+#include "../karamel/Lib_Memzero0.h"
+#include "../karamel/internal/Hacl_Hash.h"
+
+#include <atomic>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32)
+#define EG_SHA256_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+using std::atomic;
+using std::invalid_argument;
+
+namespace electionguard
+{
+    static atomic<Sha256Kernel> &activeKernel()
+    {
+        static atomic<Sha256Kernel> instance{detectSha256Kernel()};
+        return instance;
+    }
+
+    bool isSha256KernelSupported(Sha256Kernel kernel)
+    {
+        switch (kernel) {
+            case Sha256Kernel::portable:
+                return true;
+#ifdef EG_SHA256_X86_KERNELS
+            case Sha256Kernel::shani:
+                return __builtin_cpu_supports("sha") && __builtin_cpu_supports("sse4.1");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    Sha256Kernel detectSha256Kernel()
+    {
+        if (isSha256KernelSupported(Sha256Kernel::shani)) {
+            return Sha256Kernel::shani;
+        }
+        return Sha256Kernel::portable;
+    }
+
+    Sha256Kernel getSha256Kernel() { return activeKernel().load(std::memory_order_relaxed); }
+
+    void setSha256Kernel(Sha256Kernel kernel)
+    {
+        if (!isSha256KernelSupported(kernel)) {
+            throw invalid_argument("setSha256Kernel:: kernel is not supported on this processor");
+        }
+        activeKernel().store(kernel, std::memory_order_relaxed);
+    }
+
+#ifdef EG_SHA256_X86_KERNELS
+
+    /// <summary>
+    /// Compress the blocks with the SHA extensions.
+    ///
+    /// The instructions keep the state as the words ABEF and CDGH, and every
+    /// sha256rnds2 performs two rounds, so each group of four message words
+    /// takes two of them. The message schedule is kept in a ring of four groups.
+    /// </summary>
+    __attribute__((target("sha,sse4.1"))) static void
+    compressShaNi(uint32_t *state, const uint8_t *blocks, size_t count)
+    {
+        // reverse the bytes of every word, the message is big endian
+        const auto byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+        auto cdab = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(state)),
+                                      0xB1);
+        auto efgh = _mm_shuffle_epi32(
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(state + 4)), 0x1B);
+        auto abef = _mm_alignr_epi8(cdab, efgh, 8);
+        auto cdgh = _mm_blend_epi16(efgh, cdab, 0xF0);
+
+        for (size_t block = 0; block < count; block++) {
+            const auto *data = blocks + block * SHA256_BLOCK_SIZE;
+            auto abefSaved = abef;
+            auto cdghSaved = cdgh;
+
+            __m128i w[4];
+            for (uint32_t group = 0; group < 16; group++) {
+                if (group < 4) {
+                    w[group] = _mm_shuffle_epi8(
+                      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * group)),
+                      byteSwap);
+                } else {
+                    // w[t] = w[t-16] + sigma0(w[t-15]) + w[t-7] + sigma1(w[t-2])
+                    auto previous = w[(group + 3) & 3];
+                    auto sevenBack = _mm_alignr_epi8(previous, w[(group + 2) & 3], 4);
+                    auto partial = _mm_add_epi32(
+                      _mm_sha256msg1_epu32(w[group & 3], w[(group + 1) & 3]), sevenBack);
+                    w[group & 3] = _mm_sha256msg2_epu32(partial, previous);
+                }
+
+                auto constants =
+                  _mm_loadu_si128(reinterpret_cast<const __m128i *>(SHA256_K) + group);
+                auto message = _mm_add_epi32(w[group & 3], constants);
+                cdgh = _mm_sha256rnds2_epu32(cdgh, abef, message);
+                abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(message, 0x0E));
+            }
+
+            abef = _mm_add_epi32(abef, abefSaved);
+            cdgh = _mm_add_epi32(cdgh, cdghSaved);
+        }
+
+        auto feba = _mm_shuffle_epi32(abef, 0x1B);
+        auto dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+    }
+
+#endif
+
+    void sha256_compress(uint32_t *state, const uint8_t *blocks, size_t count)
+    {
+        if (count == 0) {
+            return;
+        }
+
+        switch (getSha256Kernel()) {
+#ifdef EG_SHA256_X86_KERNELS
+            case Sha256Kernel::shani:
+                compressShaNi(state, blocks, count);
+                return;
+#endif
+            default:
+                Hacl_Hash_SHA2_update_multi_256(state, const_cast<uint8_t *>(blocks),
+                                                static_cast<uint32_t>(count));
+                return;
+        }
+    }
+
+    void sha256_init(uint32_t *state) { Hacl_Hash_Core_SHA2_init_256(state); }
+
+    void sha256_update(uint32_t *state, uint8_t *buffer, uint64_t &totalLength,
+                       const uint8_t *data, size_t size)
+    {
+        if (size == 0) {
+            return;
+        }
+        auto pending = static_cast<size_t>(totalLength % SHA256_BLOCK_SIZE);
+        totalLength += size;
+
+        // complete the buffered block first
+        if (pending > 0) {
+            auto fill = SHA256_BLOCK_SIZE - pending;
+            if (size < fill) {
+                memcpy(buffer + pending, data, size);
+                return;
+            }
+            memcpy(buffer + pending, data, fill);
+            sha256_compress(state, buffer, 1);
+            data += fill;
+            size -= fill;
+        }
+
+        // compress the full blocks straight from the data and keep the rest
+        auto blocks = size / SHA256_BLOCK_SIZE;
+        sha256_compress(state, data, blocks);
+        memcpy(buffer, data + blocks * SHA256_BLOCK_SIZE, size % SHA256_BLOCK_SIZE);
+    }
+
+    size_t sha256_pad(const uint8_t *buffer, uint64_t totalLength, uint8_t *blocks)
+    {
+        auto pending = static_cast<size_t>(totalLength % SHA256_BLOCK_SIZE);
+        memset(blocks, 0, 2 * SHA256_BLOCK_SIZE);
+        memcpy(blocks, buffer, pending);
+        blocks[pending] = 0x80;
+
+        // the bit length of the message closes the last block
+        auto count = pending + 1 + sizeof(uint64_t) <= SHA256_BLOCK_SIZE ? 1U : 2U;
+        auto *end = blocks + count * SHA256_BLOCK_SIZE;
+        auto bitLength = totalLength * 8;
+        for (size_t i = 1; i <= sizeof(uint64_t); i++, bitLength >>= 8) {
+            *(end - i) = static_cast<uint8_t>(bitLength);
+        }
+        return count;
+    }
+
+    void sha256_digest(const uint32_t *state, uint8_t *digest)
+    {
+        for (size_t i = 0; i < SHA256_DIGEST_SIZE; i++) {
+            digest[i] = static_cast<uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+        }
+    }
+
+    void sha256_finish(const uint32_t *state, const uint8_t *buffer, uint64_t totalLength,
+                       uint8_t *digest)
+    {
+        uint32_t finalState[8];
+        memcpy(finalState, state, sizeof(finalState));
+        uint8_t blocks[2 * SHA256_BLOCK_SIZE];
+        auto count = sha256_pad(buffer, totalLength, blocks);
+        sha256_compress(finalState, blocks, count);
+        sha256_digest(finalState, digest);
+    }
+
+    void hmac_sha256(const uint8_t *key, size_t keySize, const uint8_t *data, size_t size,
+                     uint8_t *mac)
+    {
+        // keys longer than a block are replaced by their digest
+        uint8_t paddedKey[SHA256_BLOCK_SIZE] = {};
+        if (keySize > SHA256_BLOCK_SIZE) {
+            Sha256 keyHash;
+            keyHash.update(key, keySize);
+            keyHash.finish(paddedKey);
+        } else if (keySize > 0) {
+            memcpy(paddedKey, key, keySize);
+        }
+
+        uint8_t pad[SHA256_BLOCK_SIZE];
+        for (size_t i = 0; i < SHA256_BLOCK_SIZE; i++) {
+            pad[i] = paddedKey[i] ^ 0x36;
+        }
+        Sha256 inner;
+        inner.update(pad, SHA256_BLOCK_SIZE);
+        inner.update(data, size);
+        uint8_t innerDigest[SHA256_DIGEST_SIZE];
+        inner.finish(innerDigest);
+
+        for (size_t i = 0; i < SHA256_BLOCK_SIZE; i++) {
+            pad[i] = paddedKey[i] ^ 0x5c;
+        }
+        Sha256 outer;
+        outer.update(pad, SHA256_BLOCK_SIZE);
+        outer.update(innerDigest, SHA256_DIGEST_SIZE);
+        outer.finish(mac);
+
+        // the pads are derived from the key
+        Lib_Memzero0_memzero(paddedKey, sizeof(paddedKey));
+        Lib_Memzero0_memzero(pad, sizeof(pad));
+    }
+
+} // namespace electionguard
@@ -0,0 +1,124 @@
+#ifndef __ELECTIONGUARD_CPP_SHA256_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_SHA256_HPP_INCLUDED__
+
+#include <cstddef>
+#include <cstdint>
+#include <electionguard/export.h>
+
+namespace electionguard
+{
+    const size_t SHA256_BLOCK_SIZE = 64U;
+    const size_t SHA256_DIGEST_SIZE = 32U;
+
+    /// <summary>
+    /// The round constants of SHA-256
+    /// </summary>
+    const uint32_t SHA256_K[64] = {
+      0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4,
+      0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe,
+      0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f,
+      0x4a7484aa, 0x5cb0a9dc, 0x76f988da, 0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+      0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc,
+      0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+      0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070, 0x19a4c116,
+      0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+      0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7,
+      0xc67178f2};
+
+    /// <summary>
+    /// The implementations of the SHA-256 compression of a single message.
+    ///
+    /// `portable` is the hacl implementation, which is always available and
+    /// serves as the reference the other kernels are checked against.
+    /// `shani` uses the Intel SHA extensions (Goldmont, Ice Lake, Zen and later).
+    /// </summary>
+    enum class Sha256Kernel { portable = 0, shani = 1 };
+
+    /// <summary>
+    /// Check whether the kernel was compiled in and the processor supports it
+    /// </summary>
+    EG_INTERNAL_API bool isSha256KernelSupported(Sha256Kernel kernel);
+
+    /// <summary>
+    /// The fastest kernel supported by the processor, selected at startup
+    /// </summary>
+    EG_INTERNAL_API Sha256Kernel detectSha256Kernel();
+
+    /// <summary>
+    /// The kernel currently used by SHA-256
+    /// </summary>
+    EG_INTERNAL_API Sha256Kernel getSha256Kernel();
+
+    /// <summary>
+    /// Select the kernel used by SHA-256.
+    /// Throws invalid_argument if the kernel is not supported on this processor.
+    /// </summary>
+    EG_INTERNAL_API void setSha256Kernel(Sha256Kernel kernel);
+
+    /// <summary>
+    /// Compress `count` consecutive 64-byte blocks into the state with the selected kernel
+    /// </summary>
+    EG_INTERNAL_API void sha256_compress(uint32_t *state, const uint8_t *blocks, size_t count);
+
+    /// <summary>
+    /// Write the initial state of SHA-256
+    /// </summary>
+    EG_INTERNAL_API void sha256_init(uint32_t *state);
+
+    /// <summary>
+    /// Absorb the data into the state. The buffer holds the `totalLength % 64` bytes
+    /// that do not fill a block yet, full blocks are compressed as soon as they are complete.
+    /// </summary>
+    EG_INTERNAL_API void sha256_update(uint32_t *state, uint8_t *buffer, uint64_t &totalLength,
+                                       const uint8_t *data, size_t size);
+
+    /// <summary>
+    /// Pad the bytes left in the buffer into the final blocks of the message
+    /// and return how many were written, one or two.
+    /// `blocks` must have room for two blocks.
+    /// </summary>
+    EG_INTERNAL_API size_t sha256_pad(const uint8_t *buffer, uint64_t totalLength,
+                                      uint8_t *blocks);
+
+    /// <summary>
+    /// Write the big endian digest of a state that has compressed the final blocks
+    /// </summary>
+    EG_INTERNAL_API void sha256_digest(const uint32_t *state, uint8_t *digest);
+
+    /// <summary>
+    /// Write the digest of the message absorbed by `sha256_update`, leaving the state unchanged
+    /// </summary>
+    EG_INTERNAL_API void sha256_finish(const uint32_t *state, const uint8_t *buffer,
+                                       uint64_t totalLength, uint8_t *digest);
+
+    /// <summary>
+    /// A SHA-256 hash of a message written in parts, with the selected kernel
+    /// </summary>
+    class EG_INTERNAL_API Sha256
+    {
+      public:
+        Sha256() { sha256_init(state); }
+
+        void update(const uint8_t *data, size_t size)
+        {
+            sha256_update(state, buffer, totalLength, data, size);
+        }
+
+        void finish(uint8_t *digest) const { sha256_finish(state, buffer, totalLength, digest); }
+
+      private:
+        uint32_t state[8];
+        uint8_t buffer[SHA256_BLOCK_SIZE] = {};
+        uint64_t totalLength = 0;
+    };
+
+    /// <summary>
+    /// Write HMAC-SHA256 of the data under the key in `mac`, 32 bytes, with the selected kernel.
+    /// `mac` may alias the key or the data.
+    /// </summary>
+    EG_INTERNAL_API void hmac_sha256(const uint8_t *key, size_t keySize, const uint8_t *data,
+                                     size_t size, uint8_t *mac);
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_SHA256_HPP_INCLUDED__ */
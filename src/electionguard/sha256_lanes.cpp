@@ -0,0 +1,313 @@
+#include "sha256_lanes.hpp"
+
+#include "sha256.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(_WIN32)
+#define EG_SHA256_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+using std::atomic;
+using std::invalid_argument;
+using std::min;
+
+namespace electionguard
+{
+    static atomic<Sha256LaneKernel> &activeKernel()
+    {
+        static atomic<Sha256LaneKernel> instance{detectSha256LaneKernel()};
+        return instance;
+    }
+
+    bool isSha256LaneKernelSupported(Sha256LaneKernel kernel)
+    {
+        switch (kernel) {
+            case Sha256LaneKernel::portable:
+                return true;
+#ifdef EG_SHA256_X86_KERNELS
+            case Sha256LaneKernel::avx2:
+                return __builtin_cpu_supports("avx2");
+            case Sha256LaneKernel::avx512:
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    Sha256LaneKernel detectSha256LaneKernel()
+    {
+        if (isSha256LaneKernelSupported(Sha256LaneKernel::avx512)) {
+            return Sha256LaneKernel::avx512;
+        }
+        if (isSha256LaneKernelSupported(Sha256LaneKernel::avx2)) {
+            return Sha256LaneKernel::avx2;
+        }
+        return Sha256LaneKernel::portable;
+    }
+
+    Sha256LaneKernel getSha256LaneKernel()
+    {
+        return activeKernel().load(std::memory_order_relaxed);
+    }
+
+    void setSha256LaneKernel(Sha256LaneKernel kernel)
+    {
+        if (!isSha256LaneKernelSupported(kernel)) {
+            throw invalid_argument("setSha256LaneKernel:: kernel is not supported on this processor");
+        }
+        activeKernel().store(kernel, std::memory_order_relaxed);
+    }
+
+    static void compressPortable(uint32_t count, uint32_t *const *states,
+                                 const uint8_t *const *blocks)
+    {
+        for (uint32_t i = 0; i < count; i++) {
+            sha256_compress(states[i], blocks[i], 1);
+        }
+    }
+
+#ifdef EG_SHA256_X86_KERNELS
+
+    static uint32_t loadBigEndian(const uint8_t *bytes)
+    {
+        return (static_cast<uint32_t>(bytes[0]) << 24) | (static_cast<uint32_t>(bytes[1]) << 16) |
+               (static_cast<uint32_t>(bytes[2]) << 8) | static_cast<uint32_t>(bytes[3]);
+    }
+
+    /// <summary>
+    /// The message words and the state of every lane, transposed so that
+    /// entry i of a row belongs to lane i
+    /// </summary>
+    template <uint32_t Lanes> struct LaneWords {
+        alignas(64) uint32_t message[16][Lanes];
+        alignas(64) uint32_t state[8][Lanes];
+
+        LaneWords(uint32_t *const *states, const uint8_t *const *blocks)
+        {
+            for (uint32_t lane = 0; lane < Lanes; lane++) {
+                for (uint32_t t = 0; t < 16; t++) {
+                    message[t][lane] = loadBigEndian(blocks[lane] + 4 * t);
+                }
+                for (uint32_t j = 0; j < 8; j++) {
+                    state[j][lane] = states[lane][j];
+                }
+            }
+        }
+
+        void store(uint32_t *const *states) const
+        {
+            for (uint32_t lane = 0; lane < Lanes; lane++) {
+                for (uint32_t j = 0; j < 8; j++) {
+                    states[lane][j] = state[j][lane];
+                }
+            }
+        }
+    };
+
+#pragma region avx2
+
+    __attribute__((target("avx2"))) static inline __m256i rotr256(__m256i x, int n)
+    {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    __attribute__((target("avx2"))) static inline __m256i xor256(__m256i a, __m256i b, __m256i c)
+    {
+        return _mm256_xor_si256(_mm256_xor_si256(a, b), c);
+    }
+
+    /// <summary>
+    /// Compress one block into each of 8 states, one per 32-bit lane
+    /// </summary>
+    __attribute__((target("avx2"))) static void compressAvx2(uint32_t *const *states,
+                                                             const uint8_t *const *blocks)
+    {
+        LaneWords<8> words(states, blocks);
+
+        __m256i w[16];
+        for (uint32_t t = 0; t < 16; t++) {
+            w[t] = _mm256_load_si256(reinterpret_cast<const __m256i *>(words.message[t]));
+        }
+        __m256i s[8];
+        for (uint32_t j = 0; j < 8; j++) {
+            s[j] = _mm256_load_si256(reinterpret_cast<const __m256i *>(words.state[j]));
+        }
+
+        auto a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        for (uint32_t t = 0; t < 64; t++) {
+            // the message schedule is kept in a ring of the last 16 words
+            if (t >= 16) {
+                auto w2 = w[(t - 2) & 15];
+                auto w15 = w[(t - 15) & 15];
+                auto sigma0 =
+                  xor256(rotr256(w15, 7), rotr256(w15, 18), _mm256_srli_epi32(w15, 3));
+                auto sigma1 =
+                  xor256(rotr256(w2, 17), rotr256(w2, 19), _mm256_srli_epi32(w2, 10));
+                w[t & 15] = _mm256_add_epi32(_mm256_add_epi32(w[t & 15], sigma0),
+                                             _mm256_add_epi32(w[(t - 7) & 15], sigma1));
+            }
+
+            auto bigSigma1 = xor256(rotr256(e, 6), rotr256(e, 11), rotr256(e, 25));
+            auto ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            auto t1 = _mm256_add_epi32(_mm256_add_epi32(h, bigSigma1),
+                                       _mm256_add_epi32(ch, w[t & 15]));
+            t1 = _mm256_add_epi32(t1, _mm256_set1_epi32(static_cast<int>(SHA256_K[t])));
+            auto bigSigma0 = xor256(rotr256(a, 2), rotr256(a, 13), rotr256(a, 22));
+            auto maj = _mm256_or_si256(_mm256_and_si256(a, b),
+                                       _mm256_and_si256(c, _mm256_or_si256(a, b)));
+            auto t2 = _mm256_add_epi32(bigSigma0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm256_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm256_add_epi32(t1, t2);
+        }
+
+        __m256i result[8] = {a, b, c, d, e, f, g, h};
+        for (uint32_t j = 0; j < 8; j++) {
+            _mm256_store_si256(reinterpret_cast<__m256i *>(words.state[j]),
+                               _mm256_add_epi32(s[j], result[j]));
+        }
+        words.store(states);
+    }
+
+#pragma endregion
+
+#pragma region avx512
+
+    /// <summary>
+    /// Compress one block into each of 16 states, one per 32-bit lane.
+    /// The rotations are single instructions and the boolean functions are ternary logic.
+    /// </summary>
+    __attribute__((target("avx512f"))) static void compressAvx512(uint32_t *const *states,
+                                                                  const uint8_t *const *blocks)
+    {
+        LaneWords<16> words(states, blocks);
+
+        __m512i w[16];
+        for (uint32_t t = 0; t < 16; t++) {
+            w[t] = _mm512_load_si512(words.message[t]);
+        }
+        __m512i s[8];
+        for (uint32_t j = 0; j < 8; j++) {
+            s[j] = _mm512_load_si512(words.state[j]);
+        }
+
+        // the truth tables of a ^ b ^ c, (a & b) ^ (~a & c) and the majority of a, b and c
+        const int XOR3 = 0x96;
+        const int CHOOSE = 0xCA;
+        const int MAJORITY = 0xE8;
+        // the zero masked rotations and shifts take every lane, the unmasked forms pass an
+        // undefined source to the masked builtins, which GCC reports as uninitialized
+        const __mmask16 ALL = 0xFFFF;
+
+        auto a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+        for (uint32_t t = 0; t < 64; t++) {
+            if (t >= 16) {
+                auto w2 = w[(t - 2) & 15];
+                auto w15 = w[(t - 15) & 15];
+                auto sigma0 = _mm512_ternarylogic_epi32(_mm512_maskz_ror_epi32(ALL, w15, 7),
+                                                        _mm512_maskz_ror_epi32(ALL, w15, 18),
+                                                        _mm512_maskz_srli_epi32(ALL, w15, 3), XOR3);
+                auto sigma1 = _mm512_ternarylogic_epi32(_mm512_maskz_ror_epi32(ALL, w2, 17),
+                                                        _mm512_maskz_ror_epi32(ALL, w2, 19),
+                                                        _mm512_maskz_srli_epi32(ALL, w2, 10), XOR3);
+                w[t & 15] = _mm512_add_epi32(_mm512_add_epi32(w[t & 15], sigma0),
+                                             _mm512_add_epi32(w[(t - 7) & 15], sigma1));
+            }
+
+            auto bigSigma1 = _mm512_ternarylogic_epi32(_mm512_maskz_ror_epi32(ALL, e, 6),
+                                                       _mm512_maskz_ror_epi32(ALL, e, 11),
+                                                       _mm512_maskz_ror_epi32(ALL, e, 25), XOR3);
+            auto ch = _mm512_ternarylogic_epi32(e, f, g, CHOOSE);
+            auto t1 = _mm512_add_epi32(_mm512_add_epi32(h, bigSigma1),
+                                       _mm512_add_epi32(ch, w[t & 15]));
+            t1 = _mm512_add_epi32(t1, _mm512_set1_epi32(static_cast<int>(SHA256_K[t])));
+            auto bigSigma0 = _mm512_ternarylogic_epi32(_mm512_maskz_ror_epi32(ALL, a, 2),
+                                                       _mm512_maskz_ror_epi32(ALL, a, 13),
+                                                       _mm512_maskz_ror_epi32(ALL, a, 22), XOR3);
+            auto maj = _mm512_ternarylogic_epi32(a, b, c, MAJORITY);
+            auto t2 = _mm512_add_epi32(bigSigma0, maj);
+
+            h = g;
+            g = f;
+            f = e;
+            e = _mm512_add_epi32(d, t1);
+            d = c;
+            c = b;
+            b = a;
+            a = _mm512_add_epi32(t1, t2);
+        }
+
+        __m512i result[8] = {a, b, c, d, e, f, g, h};
+        for (uint32_t j = 0; j < 8; j++) {
+            _mm512_store_si512(words.state[j], _mm512_add_epi32(s[j], result[j]));
+        }
+        words.store(states);
+    }
+
+#pragma endregion
+
+    /// <summary>
+    /// Compress the messages in groups of `Lanes` with the kernel,
+    /// filling the unused lanes of the last group with a scratch state
+    /// </summary>
+    template <uint32_t Lanes>
+    static void compressGroups(uint32_t count, uint32_t *const *states,
+                               const uint8_t *const *blocks,
+                               void (*kernel)(uint32_t *const *, const uint8_t *const *))
+    {
+        uint32_t scratch[8] = {};
+        for (uint32_t first = 0; first < count; first += Lanes) {
+            auto used = min(Lanes, count - first);
+            if (used == Lanes) {
+                kernel(states + first, blocks + first);
+                continue;
+            }
+
+            uint32_t *groupStates[Lanes];
+            const uint8_t *groupBlocks[Lanes];
+            for (uint32_t lane = 0; lane < Lanes; lane++) {
+                groupStates[lane] = lane < used ? states[first + lane] : scratch;
+                groupBlocks[lane] = lane < used ? blocks[first + lane] : blocks[first];
+            }
+            kernel(groupStates, groupBlocks);
+        }
+    }
+
+#endif
+
+    void sha256_compress_lanes(uint32_t count, uint32_t *const *states,
+                               const uint8_t *const *blocks)
+    {
+        // a single message does not fill any lanes
+        if (count < 2) {
+            compressPortable(count, states, blocks);
+            return;
+        }
+
+        switch (getSha256LaneKernel()) {
+#ifdef EG_SHA256_X86_KERNELS
+            case Sha256LaneKernel::avx2:
+                compressGroups<8>(count, states, blocks, compressAvx2);
+                return;
+            case Sha256LaneKernel::avx512:
+                compressGroups<16>(count, states, blocks, compressAvx512);
+                return;
+#endif
+            default:
+                compressPortable(count, states, blocks);
+                return;
+        }
+    }
+
+} // namespace electionguard
@@ -0,0 +1,52 @@
+#ifndef __ELECTIONGUARD_CPP_SHA256_LANES_HPP_INCLUDED__
+#define __ELECTIONGUARD_CPP_SHA256_LANES_HPP_INCLUDED__
+
+#include <cstdint>
+#include <electionguard/export.h>
+
+namespace electionguard
+{
+    /// <summary>
+    /// The implementations of the SHA-256 compression of independent messages.
+    ///
+    /// `portable` compresses one message after the other with the selected `Sha256Kernel`,
+    /// it is always available and serves as the reference the other kernels are checked against.
+    /// `avx2` compresses 8 messages at once, one per 32-bit lane of an AVX2 register.
+    /// `avx512` compresses 16 messages at once, one per 32-bit lane of an AVX-512 register.
+    /// </summary>
+    enum class Sha256LaneKernel { portable = 0, avx2 = 1, avx512 = 2 };
+
+    /// <summary>
+    /// Check whether the kernel was compiled in and the processor supports it
+    /// </summary>
+    EG_INTERNAL_API bool isSha256LaneKernelSupported(Sha256LaneKernel kernel);
+
+    /// <summary>
+    /// The widest kernel supported by the processor, selected at startup
+    /// </summary>
+    EG_INTERNAL_API Sha256LaneKernel detectSha256LaneKernel();
+
+    /// <summary>
+    /// The kernel currently used to compress independent messages
+    /// </summary>
+    EG_INTERNAL_API Sha256LaneKernel getSha256LaneKernel();
+
+    /// <summary>
+    /// Select the kernel used to compress independent messages.
+    /// Throws invalid_argument if the kernel is not supported on this processor.
+    /// </summary>
+    EG_INTERNAL_API void setSha256LaneKernel(Sha256LaneKernel kernel);
+
+    /// <summary>
+    /// Compress the 64-byte block `blocks[i]` into the state `states[i]`,
+    /// eight words, for `count` independent messages with the selected kernel.
+    ///
+    /// The messages are compressed in groups as wide as the kernel, the lanes of
+    /// the last group that are not needed compress a scratch state.
+    /// </summary>
+    EG_INTERNAL_API void sha256_compress_lanes(uint32_t count, uint32_t *const *states,
+                                               const uint8_t *const *blocks);
+
+} // namespace electionguard
+
+#endif /* __ELECTIONGUARD_CPP_SHA256_LANES_HPP_INCLUDED__ */
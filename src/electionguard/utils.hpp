@@ -2,6 +2,8 @@
 #define __ELECTIONGUARD_CPP_UTILS_HPP_INCLUDED__
 
 #include <chrono>
+#include <cstdint>
+#include <electionguard/constants.h>
 #include <electionguard/export.h>
 #include <exception>
 #include <map>
@@ -25,6 +27,25 @@ namespace electionguard
 
     inline bool isPowerOfTwo(uint64_t x) { return x && !(x & (x - 1)); }
 
+    /// <summary>
+    /// Compute a non-cryptographic 64 bit digest of the limbs of an element mod p.
+    ///
+    /// The digest is only suitable to index elements and to detect that an element changed,
+    /// lookups keyed by it must compare the full value. A digest of zero is never produced
+    /// so that zero can be used to signal the absence of a digest.
+    /// </summary>
+    inline uint64_t limbDigest(const uint64_t (&elem)[MAX_P_LEN])
+    {
+        const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+        const uint64_t shift = 32U;
+        uint64_t digest = 0;
+        for (auto limb : elem) {
+            digest = (digest ^ limb) * multiplier;
+            digest ^= digest >> shift;
+        }
+        return digest == 0 ? 1 : digest;
+    }
+
     template <typename K, typename V>
     K findByValue(const map<K, const V> &collection, const V &value)
     {
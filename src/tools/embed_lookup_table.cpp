@@ -0,0 +1,108 @@
+/// <summary>
+/// Generates the lookup table of the generator G as a C++ translation unit
+/// defining `electionguard::embedded_g_table`, so that the table is linked into
+/// the read-only data of the library instead of being generated at runtime.
+///
+/// The values are laid out like a LookupTableType: row i holds G^(j * 2^(i * k))
+/// for every slice j of k = LUT_WINDOW_SIZE bits, in montgomery form.
+///
+/// usage: embed_lookup_table <output.cpp>
+/// </summary>
+
+#include "../karamel/Hacl_GenericField64.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <electionguard/constants.h>
+#include <vector>
+
+using std::begin;
+using std::copy;
+using std::end;
+using std::vector;
+
+namespace
+{
+    const uint64_t VALUES_PER_LINE = 4;
+
+    uint64_t *entry(vector<uint64_t> &table, uint64_t row, uint64_t column)
+    {
+        return table.data() + (row * LUT_ORDER_BITS + column) * MAX_P_LEN;
+    }
+
+    vector<uint64_t> generateTable()
+    {
+        uint64_t modulus[MAX_P_LEN];
+        uint64_t base[MAX_P_LEN];
+        copy(begin(P_ARRAY_REVERSE), end(P_ARRAY_REVERSE), modulus);
+        copy(begin(G_ARRAY_REVERSE), end(G_ARRAY_REVERSE), base);
+
+        auto *context = Hacl_GenericField64_field_init(MAX_P_LEN, modulus);
+        vector<uint64_t> table(LUT_TABLE_LENGTH * LUT_ORDER_BITS * MAX_P_LEN, 0);
+
+        uint64_t rowBase[MAX_P_LEN];
+        Hacl_GenericField64_to_field(context, base, rowBase);
+        for (uint64_t i = 0; i < LUT_TABLE_LENGTH; i++) {
+            // the slice zero is never looked up and stays zero
+            copy(begin(rowBase), end(rowBase), entry(table, i, 1));
+            for (uint64_t j = 2; j < LUT_ORDER_BITS; j++) {
+                Hacl_GenericField64_mul(context, entry(table, i, j - 1), rowBase,
+                                        entry(table, i, j));
+            }
+
+            // the base of the next row is the base of this row raised to LUT_ORDER_BITS
+            for (uint64_t bits = 1; bits < LUT_ORDER_BITS; bits <<= 1) {
+                Hacl_GenericField64_sqr(context, rowBase, rowBase);
+            }
+        }
+
+        Hacl_GenericField64_field_free(context);
+        return table;
+    }
+
+    bool writeSource(const char *path, const vector<uint64_t> &table)
+    {
+        auto *file = fopen(path, "w");
+        if (file == nullptr) {
+            return false;
+        }
+
+        fprintf(file, "// Generated by embed_lookup_table, do not edit.\n\n");
+        fprintf(file, "#include \"embedded_table.hpp\"\n\n");
+        fprintf(file, "namespace electionguard\n{\n");
+        fprintf(file, "    static_assert(LUT_WINDOW_SIZE == %lluU, \"the table was generated for "
+                      "another window size\");\n\n",
+                static_cast<unsigned long long>(LUT_WINDOW_SIZE));
+        fprintf(file, "    alignas(64) static const uint64_t G_TABLE[EMBEDDED_TABLE_LIMBS] = {\n");
+        for (size_t i = 0; i < table.size(); i++) {
+            if (i % VALUES_PER_LINE == 0) {
+                fprintf(file, "      ");
+            }
+            fprintf(file, " 0x%016llXULL,", static_cast<unsigned long long>(table[i]));
+            if (i % VALUES_PER_LINE == VALUES_PER_LINE - 1) {
+                fprintf(file, "\n");
+            }
+        }
+        fprintf(file, "    };\n\n");
+        fprintf(file, "    const uint64_t *embedded_g_table() { return G_TABLE; }\n\n");
+        fprintf(file, "} // namespace electionguard\n");
+
+        auto failed = ferror(file) != 0;
+        return fclose(file) == 0 && !failed;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc != 2) {
+        fprintf(stderr, "usage: embed_lookup_table <output.cpp>\n");
+        return 1;
+    }
+
+    if (!writeSource(argv[1], generateTable())) {
+        fprintf(stderr, "embed_lookup_table: could not write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
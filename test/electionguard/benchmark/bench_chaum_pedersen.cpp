@@ -91,6 +91,23 @@ BENCHMARK_DEFINE_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersen)(benchmar
 BENCHMARK_REGISTER_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersen)
   ->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersenBatch)
+(benchmark::State &state)
+{
+    vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                reference_wrapper<const DisjunctiveChaumPedersenProof>>>
+      items(static_cast<size_t>(state.range(0)), {*message, *disjunctive});
+    for (auto _ : state) {
+        auto failed =
+          DisjunctiveChaumPedersenProof::verifyBatch(items, *keypair->getPublicKey(), ONE_MOD_Q());
+    }
+}
+
+BENCHMARK_REGISTER_F(ChaumPedersenFixture, CheckDisjunctiveChaumPedersenBatch)
+  ->Arg(16)
+  ->Arg(64)
+  ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_DEFINE_F(ChaumPedersenFixture, CloneDisjunctiveChaumPedersen)(benchmark::State &state)
 {
     while (state.KeepRunning()) {
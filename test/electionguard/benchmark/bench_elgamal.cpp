@@ -70,3 +70,61 @@ BENCHMARK_DEFINE_F(ElgamalEncryptFixture, ElGamalDecrypt_fixed_base)(benchmark::
 
 BENCHMARK_REGISTER_F(ElgamalEncryptFixture, ElGamalDecrypt_fixed_base)
   ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ElgamalEncryptFixture, ElGamalDecryptEach)(benchmark::State &state)
+{
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), *fixed_base_keypair->getPublicKey()));
+    }
+
+    for (auto _ : state) {
+        for (auto &ciphertext : ciphertexts) {
+            ciphertext->decrypt(*secret);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ElgamalEncryptFixture, ElGamalDecryptEach)
+  ->Arg(100)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ElgamalEncryptFixture, ElGamalDecryptBatch)(benchmark::State &state)
+{
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> refs;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), *fixed_base_keypair->getPublicKey()));
+        refs.push_back(*ciphertexts.back());
+    }
+
+    for (auto _ : state) {
+        ElGamalCiphertext::decryptBatch(refs, *secret);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ElgamalEncryptFixture, ElGamalDecryptBatch)
+  ->Arg(100)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(ElgamalEncryptFixture, ElGamalAdd)(benchmark::State &state)
+{
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<ElGamalCiphertext>> refs;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        ciphertexts.push_back(elgamalEncrypt(1UL, *rand_q(), *keypair->getPublicKey()));
+        refs.push_back(ref(*ciphertexts.back()));
+    }
+
+    for (auto _ : state) {
+        elgamalAdd(refs);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(ElgamalEncryptFixture, ElGamalAdd)
+  ->Arg(10)
+  ->Arg(1000)
+  ->Unit(benchmark::kMillisecond);
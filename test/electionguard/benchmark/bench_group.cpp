@@ -2,6 +2,7 @@
 #include "../../../src/electionguard/facades/Hacl_Bignum256.hpp"
 #include "../../../src/electionguard/facades/Hacl_Bignum4096.hpp"
 #include "../../../src/electionguard/log.hpp"
+#include "../../../src/electionguard/montgomery_kernels.hpp"
 #include "../../../src/electionguard/utils.hpp"
 #include "../utils/byte_logger.hpp"
 #include "../utils/constants.hpp"
@@ -150,6 +151,58 @@ BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_with_q)(benchmark::State &stat
 
 BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_with_q)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_policy)(benchmark::State &state)
+{
+    auto policy = static_cast<ExponentiationPolicy>(state.range(0));
+    auto rand_p1 = rand_p();
+    auto rand_q1 = rand_q();
+
+    // keep the base from being promoted to a lookup table
+    set_lookup_table_cache_policy(0, LUT_CACHE_BYTE_BUDGET);
+    for (auto _ : state) {
+        auto exp = pow_mod_p(*rand_p1, *rand_q1, policy);
+    }
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_policy)
+  ->ArgName("policy")
+  ->DenseRange(0, 1)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, isValidResidue_cache)(benchmark::State &state)
+{
+    // every check is of a new instance, so only the residue cache can skip the
+    // exponentiation. the values are either distinct, as in bulk verification,
+    // or drawn from a few values that are checked repeatedly
+    auto capacity = static_cast<uint64_t>(state.range(0));
+    auto repeated = state.range(1) != 0;
+    vector<unique_ptr<ElementModP>> values;
+    for (int i = 0; i < 16; i++) {
+        values.push_back(g_pow_p(*rand_q()));
+    }
+    auto distinct = g_pow_p(*rand_q());
+
+    set_residue_cache_capacity(capacity);
+    size_t i = 0;
+    for (auto _ : state) {
+        if (!repeated) {
+            distinct = mul_mod_p(*distinct, G());
+        }
+        ElementModP element(repeated ? values[i++ % values.size()]->cref() : distinct->cref(),
+                            true);
+        benchmark::DoNotOptimize(element.isValidResidue());
+    }
+    set_residue_cache_capacity(0);
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, isValidResidue_cache)
+  ->ArgNames({"capacity", "repeated"})
+  ->ArgsProduct({{0, 1024}, {0, 1}})
+  ->Threads(1)
+  ->Threads(4)
+  ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_fixed_base)(benchmark::State &state)
 {
     auto rand_p1 = rand_p();
@@ -174,6 +227,65 @@ BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_with_p)(benchmark::State &stat
 
 BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_with_p)->Unit(benchmark::kMillisecond);
 
+BENCHMARK_DEFINE_F(GroupElementFixture, pow_mod_p_batch)(benchmark::State &state)
+{
+    // lanes when the processor supports them, one at a time otherwise
+    auto kernel = static_cast<MontgomeryKernel>(state.range(0));
+    if (!isMontgomeryKernelSupported(kernel)) {
+        state.SkipWithError("kernel is not supported on this processor");
+        return;
+    }
+
+    vector<unique_ptr<ElementModP>> ownedBases;
+    vector<unique_ptr<ElementModQ>> ownedExponents;
+    vector<reference_wrapper<const ElementModP>> bases;
+    vector<reference_wrapper<const ElementModQ>> exponents;
+    for (uint32_t i = 0; i < MONTGOMERY_LANES; i++) {
+        ownedBases.push_back(g_pow_p(*rand_q()));
+        ownedExponents.push_back(rand_q());
+        bases.push_back(*ownedBases.back());
+        exponents.push_back(*ownedExponents.back());
+    }
+
+    // keep the bases from being promoted to lookup tables
+    set_lookup_table_cache_policy(0, LUT_CACHE_BYTE_BUDGET);
+    auto previous = getMontgomeryKernel();
+    setMontgomeryKernel(kernel);
+    for (auto _ : state) {
+        auto results = pow_mod_p_batch(bases, exponents);
+    }
+    setMontgomeryKernel(previous);
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+    state.SetItemsProcessed(state.iterations() * MONTGOMERY_LANES);
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, pow_mod_p_batch)
+  ->ArgName("kernel")
+  ->DenseRange(0, 2)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, mul_of_two_pow_mod_p)(benchmark::State &state)
+{
+    auto rand_p1 = rand_p();
+    auto rand_p2 = rand_p();
+    for (auto _ : state) {
+        auto exp = mul_mod_p(*pow_mod_p(*rand_p1, *a), *pow_mod_p(*rand_p2, *b));
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, mul_of_two_pow_mod_p)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(GroupElementFixture, multi_pow_mod_p_two_bases)(benchmark::State &state)
+{
+    auto rand_p1 = rand_p();
+    auto rand_p2 = rand_p();
+    for (auto _ : state) {
+        auto exp = multi_pow_mod_p({*rand_p1, *rand_p2}, {*a, *b});
+    }
+}
+
+BENCHMARK_REGISTER_F(GroupElementFixture, multi_pow_mod_p_two_bases)->Unit(benchmark::kMillisecond);
+
 #endif
 
 BENCHMARK_DEFINE_F(GroupElementFixture, g_pow_p_with_q)(benchmark::State &state)
@@ -1,4 +1,5 @@
 #include "../../../src/electionguard/facades/Hacl_Bignum4096.hpp"
+#include "../../../src/electionguard/montgomery_kernels.hpp"
 #include "../utils/constants.hpp"
 
 #include <benchmark/benchmark.h>
@@ -126,3 +127,28 @@ BENCHMARK_DEFINE_F(HaclBignum4096Fixture, pow_mod_p_const_time_mont)(benchmark::
 
 BENCHMARK_REGISTER_F(HaclBignum4096Fixture, pow_mod_p_const_time_mont)
   ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HaclBignum4096Fixture, montgomery_mul)(benchmark::State &state)
+{
+    auto kernel = static_cast<MontgomeryKernel>(state.range(0));
+    if (!isMontgomeryKernelSupported(kernel)) {
+        state.SkipWithError("kernel is not supported on this processor");
+        return;
+    }
+
+    auto a = g_pow_p(*rand_q());
+    auto b = g_pow_p(*rand_q());
+    uint64_t result[MAX_P_LEN] = {};
+    auto previous = getMontgomeryKernel();
+    setMontgomeryKernel(kernel);
+    for (auto _ : state) {
+        CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(a->get(), b->get(),
+                                                         static_cast<uint64_t *>(result));
+    }
+    setMontgomeryKernel(previous);
+}
+
+BENCHMARK_REGISTER_F(HaclBignum4096Fixture, montgomery_mul)
+  ->ArgName("kernel")
+  ->DenseRange(0, 2)
+  ->Unit(benchmark::kMicrosecond);
@@ -1,3 +1,4 @@
+#include "../../../src/electionguard/hash_stream.hpp"
 #include "../utils/constants.hpp"
 
 #include <benchmark/benchmark.h>
@@ -96,3 +97,45 @@ BENCHMARK_DEFINE_F(HashFixture, two_uints)(benchmark::State &state)
 }
 
 BENCHMARK_REGISTER_F(HashFixture, two_uints)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HashFixture, two_uints_variadic)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        auto result = hash_elems(*p1, *p2);
+    }
+}
+
+BENCHMARK_REGISTER_F(HashFixture, two_uints_variadic)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HashFixture, a_nonce)(benchmark::State &state)
+{
+    const auto &seed = TWO_MOD_Q();
+    uint64_t item = 0;
+    for (auto _ : state) {
+        auto result = hash_elems({&const_cast<ElementModQ &>(seed), item++});
+    }
+}
+
+BENCHMARK_REGISTER_F(HashFixture, a_nonce)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HashFixture, a_nonce_variadic)(benchmark::State &state)
+{
+    const auto &seed = TWO_MOD_Q();
+    uint64_t item = 0;
+    for (auto _ : state) {
+        auto result = hash_elems(seed, item++);
+    }
+}
+
+BENCHMARK_REGISTER_F(HashFixture, a_nonce_variadic)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(HashFixture, a_nonce_prefix)(benchmark::State &state)
+{
+    HashPrefix prefix({cref(TWO_MOD_Q())});
+    uint64_t item = 0;
+    for (auto _ : state) {
+        auto result = hash_elems(prefix, item++);
+    }
+}
+
+BENCHMARK_REGISTER_F(HashFixture, a_nonce_prefix)->Unit(benchmark::kMillisecond);
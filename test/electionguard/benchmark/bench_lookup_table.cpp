@@ -0,0 +1,109 @@
+#include "../../../src/electionguard/lookup_table.hpp"
+
+#include <benchmark/benchmark.h>
+#include <electionguard/constants.h>
+#include <electionguard/group.hpp>
+
+using namespace electionguard;
+using namespace std;
+
+class LookupTableFixture : public benchmark::Fixture
+{
+  public:
+    void SetUp(const ::benchmark::State &state)
+    {
+        base = g_pow_p(*rand_q());
+        exponent = rand_q();
+    }
+
+    void TearDown(const ::benchmark::State &state) {}
+
+    unique_ptr<ElementModP> base;
+    unique_ptr<ElementModQ> exponent;
+};
+
+BENCHMARK_DEFINE_F(LookupTableFixture, GenerateTable)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        auto table = makeLookupTable(state.range(0), base->get(), false);
+        benchmark::DoNotOptimize(table);
+        state.counters["bytes"] = static_cast<double>(table->byteSize());
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, GenerateTable)
+  ->ArgName("window")
+  ->DenseRange(4, 12, 2)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LookupTableFixture, GenerateTableParallel)(benchmark::State &state)
+{
+    for (auto _ : state) {
+        auto table = makeLookupTable(state.range(0), base->get(), true);
+        benchmark::DoNotOptimize(table);
+        state.counters["bytes"] = static_cast<double>(table->byteSize());
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, GenerateTableParallel)
+  ->ArgName("window")
+  ->DenseRange(4, 12, 2)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+BENCHMARK_DEFINE_F(LookupTableFixture, pow_mod_p)(benchmark::State &state)
+{
+    auto table = makeLookupTable(state.range(0), base->get(), true);
+    state.counters["bytes"] = static_cast<double>(table->byteSize());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(table->pow_mod_p(exponent->ref()));
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, pow_mod_p)
+  ->ArgName("window")
+  ->DenseRange(4, 12, 2)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LookupTableFixture, constant_time_pow_mod_p)(benchmark::State &state)
+{
+    auto table = makeLookupTable(state.range(0), base->get(), true);
+    uint64_t result[MAX_P_LEN] = {};
+    for (auto _ : state) {
+        table->constant_time_pow_mod_p(exponent->ref(), result);
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, constant_time_pow_mod_p)
+  ->ArgName("window")
+  ->DenseRange(4, 12, 2)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LookupTableFixture, pow_mod_p_two_bases)(benchmark::State &state)
+{
+    auto first = makeLookupTable(LUT_WINDOW_SIZE, base->get(), true);
+    auto second = makeLookupTable(LUT_WINDOW_SIZE, G().get(), true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(first->pow_mod_p(exponent->ref()));
+        benchmark::DoNotOptimize(second->pow_mod_p(exponent->ref()));
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, pow_mod_p_two_bases)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(LookupTableFixture, pow_mod_p_shared_exponent_interleaved)
+(benchmark::State &state)
+{
+    auto policy = static_cast<ExponentiationPolicy>(state.range(0));
+    auto tables = makeInterleavedLookupTables(LUT_WINDOW_SIZE, {base->get(), G().get()}, true);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+          FixedBaseTable::pow_mod_p_shared_exponent(tables, exponent->ref(), policy));
+    }
+}
+
+BENCHMARK_REGISTER_F(LookupTableFixture, pow_mod_p_shared_exponent_interleaved)
+  ->ArgName("policy")
+  ->DenseRange(0, 1)
+  ->Unit(benchmark::kMillisecond);
@@ -40,3 +40,14 @@ BENCHMARK_DEFINE_F(NonceFixture, next)(benchmark::State &state)
 }
 
 BENCHMARK_REGISTER_F(NonceFixture, next)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(NonceFixture, get_range)(benchmark::State &state)
+{
+    auto count = static_cast<uint64_t>(state.range(0));
+    for (auto _ : state) {
+        auto p = nonces->get(0UL, count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(NonceFixture, get_range)->Arg(16)->Arg(256)->Unit(benchmark::kMicrosecond);
@@ -4,8 +4,11 @@
 #include <electionguard/chaum_pedersen.hpp>
 #include <electionguard/elgamal.hpp>
 #include <electionguard/group.hpp>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <thread>
 
 using namespace electionguard;
 using namespace std;
@@ -94,6 +97,126 @@ TEST_CASE("Disjunctive CP Proof simple valid inputs generate valid proofs")
           true);
 }
 
+TEST_CASE("Disjunctive CP Proof verifyBatch accepts a batch of valid proofs")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    const auto &k = *keypair->getPublicKey();
+    vector<unique_ptr<ElGamalCiphertext>> messages;
+    vector<unique_ptr<DisjunctiveChaumPedersenProof>> proofs;
+    vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                reference_wrapper<const DisjunctiveChaumPedersenProof>>>
+      items;
+    for (uint64_t i = 0; i < 6; i++) {
+        auto nonce = rand_q();
+        messages.push_back(elgamalEncrypt(i % 2, *nonce, k));
+        proofs.push_back(
+          DisjunctiveChaumPedersenProof::make(*messages.back(), *nonce, k, ONE_MOD_Q(), i % 2));
+        items.emplace_back(*messages.back(), *proofs.back());
+    }
+
+    // Act
+    auto failed = DisjunctiveChaumPedersenProof::verifyBatch(items, k, ONE_MOD_Q());
+
+    // Assert
+    CHECK(failed.empty());
+    CHECK(DisjunctiveChaumPedersenProof::verifyBatch({}, k, ONE_MOD_Q()).empty());
+}
+
+TEST_CASE("Disjunctive CP Proof verifyBatch reports the invalid proofs")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q(), false);
+    const auto &k = *keypair->getPublicKey();
+    vector<unique_ptr<ElGamalCiphertext>> messages;
+    vector<unique_ptr<DisjunctiveChaumPedersenProof>> proofs;
+    vector<pair<reference_wrapper<const ElGamalCiphertext>,
+                reference_wrapper<const DisjunctiveChaumPedersenProof>>>
+      items;
+    for (uint64_t i = 0; i < 7; i++) {
+        auto nonce = rand_q();
+        messages.push_back(elgamalEncrypt(1UL, *nonce, k));
+        // an encryption of one proven as zero has a consistent challenge
+        // but does not satisfy the verification equations
+        proofs.push_back(i == 2 || i == 5 ? DisjunctiveChaumPedersenProofHarness::make_zero(
+                                              *messages.back(), *nonce, k, ONE_MOD_Q())
+                                          : DisjunctiveChaumPedersenProofHarness::make_one(
+                                              *messages.back(), *nonce, k, ONE_MOD_Q()));
+        items.emplace_back(*messages.back(), *proofs.back());
+    }
+
+    // a proof paired with the wrong ciphertext fails the challenge check
+    auto nonce = rand_q();
+    auto other = elgamalEncrypt(0UL, *nonce, k);
+    items.emplace_back(*other, *proofs.front());
+
+    // Act
+    auto failed = DisjunctiveChaumPedersenProof::verifyBatch(items, k, ONE_MOD_Q());
+
+    // Assert
+    CHECK(failed == vector<size_t>{2, 5, 7});
+    for (size_t i = 0; i < items.size(); i++) {
+        auto expected = find(failed.begin(), failed.end(), i) == failed.end();
+        CHECK(const_cast<DisjunctiveChaumPedersenProof &>(items[i].second.get())
+                .isValid(items[i].first.get(), k, ONE_MOD_Q()) == expected);
+    }
+}
+
+TEST_CASE("Secret nonce paths never use variable time exponentiation")
+{
+    // Arrange
+    auto secret = rand_q();
+    auto keypair = ElGamalKeyPair::fromSecret(*secret, false);
+    const auto &publicKey = *keypair->getPublicKey();
+    auto nonce = rand_q();
+    auto seed = rand_q();
+
+    // promote the public key to a lookup table so that the secret paths
+    // meet both the fixed base table of G and a promoted table
+    set_lookup_table_cache_policy(1, LUT_CACHE_BYTE_BUDGET);
+    auto tables = get_lookup_table_cache_statistics().tables;
+    pow_mod_p(publicKey, *seed, ExponentiationPolicy::variableTime);
+    for (int i = 0; i < 10000 && get_lookup_table_cache_statistics().tables == tables; i++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    auto before = get_exponentiation_statistics();
+
+    // Act
+    auto message = elgamalEncrypt(1UL, *nonce, publicKey);
+    auto decrypted = message->decrypt(*secret);
+    auto disjunctive = DisjunctiveChaumPedersenProofHarness::make_one(*message, *nonce, publicKey,
+                                                                      ONE_MOD_Q(), *seed);
+    auto constant = ConstantChaumPedersenProof::make(*message, *nonce, publicKey, *seed,
+                                                     ONE_MOD_Q(), 1UL);
+    auto secretPaths = get_exponentiation_statistics();
+
+    set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+    auto masked = elgamalEncrypt(1UL, *nonce, publicKey);
+    set_constant_time_implementation(ConstantTimeImplementation::verified);
+    auto maskedPaths = get_exponentiation_statistics();
+
+    auto validDisjunctive = disjunctive->isValid(*message, publicKey, ONE_MOD_Q());
+    auto validConstant = constant->isValid(*message, publicKey, ONE_MOD_Q());
+    auto publicPaths = get_exponentiation_statistics();
+
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+
+    // Assert
+    CHECK(decrypted == 1UL);
+    CHECK(secretPaths.variableTime == before.variableTime);
+    CHECK(secretPaths.constantTime > before.constantTime);
+    CHECK(secretPaths.lookupTable == before.lookupTable);
+    CHECK(secretPaths.maskedLookupTable == before.maskedLookupTable);
+    CHECK(*masked == *message);
+    CHECK(maskedPaths.variableTime == secretPaths.variableTime);
+    CHECK(maskedPaths.lookupTable == secretPaths.lookupTable);
+    CHECK(maskedPaths.maskedLookupTable > secretPaths.maskedLookupTable);
+    CHECK(validDisjunctive);
+    CHECK(validConstant);
+    CHECK(publicPaths.variableTime > maskedPaths.variableTime);
+    CHECK(publicPaths.lookupTable > maskedPaths.lookupTable);
+}
+
 TEST_CASE("Constant CP Proof encryption of zero")
 {
     const auto &nonce = ONE_MOD_Q();
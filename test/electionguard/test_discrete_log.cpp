@@ -0,0 +1,202 @@
+#include "../../src/electionguard/discrete_log.hpp"
+#include "../../src/electionguard/sha256.hpp"
+#include "utils/constants.hpp"
+
+#include <doctest/doctest.h>
+#include <electionguard/constants.h>
+#include <electionguard/elgamal.hpp>
+#include <electionguard/group.hpp>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace electionguard;
+using namespace std;
+
+TEST_CASE("discrete_log finds exponents in the table and beyond it")
+{
+    // Arrange
+    set_discrete_log_policy(1000000, DLOG_TABLE_BYTE_BUDGET);
+    vector<uint64_t> exponents = {0, 1, 2, 999, 1000, 1001, 123456, 999999, 1000000};
+
+    for (auto exponent : exponents) {
+        auto element = g_pow_p(*ElementModQ::fromUint64(exponent));
+
+        // Act
+        auto actual = discrete_log(*element);
+
+        // Assert
+        CHECK(actual == exponent);
+    }
+
+    // beyond the largest exponent of the policy
+    CHECK(discrete_log(*g_pow_p(*ElementModQ::fromUint64(1000001))) == MAX_UINT64);
+    set_discrete_log_policy(DLOG_MAX_EXPONENT, DLOG_TABLE_BYTE_BUDGET);
+}
+
+TEST_CASE("discrete_log within a small byte budget takes more giant steps")
+{
+    // Arrange
+    auto budget = DiscreteLogTable::byteSize(DiscreteLogTable::slotCount(64));
+    set_discrete_log_policy(100000, budget);
+    auto element = g_pow_p(*ElementModQ::fromUint64(76543));
+
+    // Act
+    auto actual = discrete_log(*element);
+
+    // Assert
+    CHECK(actual == 76543);
+    CHECK_THROWS(set_discrete_log_policy(100000, 0));
+    set_discrete_log_policy(DLOG_MAX_EXPONENT, DLOG_TABLE_BYTE_BUDGET);
+}
+
+TEST_CASE("Concurrent discrete_log searches share a single table")
+{
+    // Arrange
+    set_discrete_log_policy(100000, DLOG_TABLE_BYTE_BUDGET);
+    const uint64_t threadCount = 4;
+    vector<unique_ptr<ElementModP>> elements;
+    for (uint64_t i = 0; i < threadCount; i++) {
+        elements.push_back(g_pow_p(*ElementModQ::fromUint64(i * 20000 + 7)));
+    }
+    vector<uint64_t> results(threadCount);
+
+    // Act
+    vector<thread> threads;
+    for (uint64_t i = 0; i < threadCount; i++) {
+        threads.emplace_back(
+          [&elements, &results, i]() { results[i] = discrete_log(*elements[i]); });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    // Assert
+    for (uint64_t i = 0; i < threadCount; i++) {
+        CHECK(results[i] == i * 20000 + 7);
+    }
+    set_discrete_log_policy(DLOG_MAX_EXPONENT, DLOG_TABLE_BYTE_BUDGET);
+}
+
+TEST_CASE("A saved discrete log table is loaded without generating it")
+{
+    // Arrange
+    auto path = (filesystem::temp_directory_path() / "eg_test_discrete_log.bin").string();
+    DiscreteLogTable(1000).save(path);
+    set_discrete_log_policy(500000, DLOG_TABLE_BYTE_BUDGET);
+
+    // Act
+    auto table = DiscreteLogTable::load(path);
+    load_discrete_log_table(path);
+    auto actual = discrete_log(*g_pow_p(*ElementModQ::fromUint64(432109)));
+
+    // Assert
+    CHECK(table->bound() == 1000);
+    CHECK(actual == 432109);
+
+    filesystem::remove(path);
+    set_discrete_log_policy(DLOG_MAX_EXPONENT, DLOG_TABLE_BYTE_BUDGET);
+}
+
+TEST_CASE("A truncated discrete log table file is rejected")
+{
+    // Arrange
+    auto path = (filesystem::temp_directory_path() / "eg_test_discrete_log_short.bin").string();
+    DiscreteLogTable(1000).save(path);
+    filesystem::resize_file(path, filesystem::file_size(path) - 4);
+
+    // Act & Assert
+    CHECK_THROWS(load_discrete_log_table(path));
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("An altered discrete log table is rejected and colliding powers are all probed")
+{
+    // Arrange
+    auto path =
+      (filesystem::temp_directory_path() / "eg_test_discrete_log_collision.bin").string();
+    const uint64_t bound = 1000;
+    DiscreteLogTable(bound).save(path);
+    auto slotCount = DiscreteLogTable::slotCount(bound);
+    vector<char> bytes(filesystem::file_size(path));
+    ifstream(path, ios::binary).read(bytes.data(), static_cast<streamsize>(bytes.size()));
+    auto *keys = reinterpret_cast<uint64_t *>(bytes.data() + DLOG_FILE_HEADER_SIZE);
+    auto *exponents = reinterpret_cast<uint32_t *>(keys + slotCount);
+
+    // move g^7 to the end of its run of slots and put a power with the same low limb
+    // but the wrong exponent where g^7 was, so that it is found first
+    uint64_t slot = 0;
+    while (exponents[slot] != 7 + 1) {
+        slot++;
+    }
+    auto empty = slot;
+    while (exponents[empty] != 0) {
+        empty = (empty + 1) & (slotCount - 1);
+    }
+    keys[empty] = keys[slot];
+    exponents[empty] = 7 + 1;
+    exponents[slot] = 500 + 1;
+    auto write = [&path, &bytes]() {
+        ofstream(path, ios::binary | ios::trunc)
+          .write(bytes.data(), static_cast<streamsize>(bytes.size()));
+    };
+    write();
+    set_discrete_log_policy(500000, DLOG_TABLE_BYTE_BUDGET);
+
+    // the altered values no longer match the body digest
+    CHECK_THROWS(DiscreteLogTable::load(path));
+    CHECK_THROWS(load_discrete_log_table(path));
+
+    // a table whose digest covers the colliding powers stands for a genuine collision
+    Sha256 body;
+    body.update(reinterpret_cast<const uint8_t *>(keys), slotCount * sizeof(uint64_t));
+    body.update(reinterpret_cast<const uint8_t *>(exponents), slotCount * sizeof(uint32_t));
+    body.finish(reinterpret_cast<DiscreteLogFileHeader *>(bytes.data())->bodyDigest);
+    write();
+
+    // Act
+    auto table = DiscreteLogTable::load(path);
+    auto collision = keys[slot];
+    auto firstSlot = table->firstSlot(collision);
+    auto first = table->find(collision, firstSlot);
+    auto second = table->find(collision, firstSlot);
+    load_discrete_log_table(path);
+    auto actual = discrete_log(*g_pow_p(*ElementModQ::fromUint64(7)));
+    auto beyond = discrete_log(*g_pow_p(*ElementModQ::fromUint64(3 * bound + 7)));
+
+    // Assert
+    CHECK(first == 500);
+    CHECK(second == 7);
+    CHECK(actual == 7);
+    CHECK(beyond == 3 * bound + 7);
+
+    filesystem::remove(path);
+    set_discrete_log_policy(DLOG_MAX_EXPONENT, DLOG_TABLE_BYTE_BUDGET);
+}
+
+TEST_CASE("ElGamal decryption finds plaintexts other than 0 and 1")
+{
+    // Arrange
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto publicKey = g_pow_p(*secret);
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> refs;
+    for (uint64_t message : {0UL, 1UL, 2UL, 250000UL}) {
+        ciphertexts.push_back(elgamalEncrypt(0UL, *rand_q(), *publicKey));
+        // elgamalEncrypt only encodes 0 and 1, so raise the data by g^message directly
+        auto data = mul_mod_p(*ciphertexts.back()->getData(),
+                              *g_pow_p(*ElementModQ::fromUint64(message)));
+        ciphertexts.back() = ElGamalCiphertext::make(*ciphertexts.back()->getPad(), *data);
+        refs.push_back(*ciphertexts.back());
+    }
+
+    // Act
+    auto batch = ElGamalCiphertext::decryptBatch(refs, *secret);
+
+    // Assert
+    CHECK(ciphertexts[2]->decrypt(*secret) == 2);
+    CHECK(ciphertexts[3]->decrypt(*secret) == 250000);
+    CHECK(batch == vector<uint64_t>({0, 1, 2, 250000}));
+}
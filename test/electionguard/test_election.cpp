@@ -2,10 +2,14 @@
 #include "generators/election.hpp"
 #include "generators/manifest.hpp"
 
+#include <chrono>
 #include <doctest/doctest.h>
 #include <electionguard/election.hpp>
 #include <electionguard/elgamal.hpp>
+#include <electionguard/encrypt.hpp>
 #include <electionguard/manifest.hpp>
+#include <filesystem>
+#include <thread>
 #include <unordered_map>
 
 using namespace electionguard;
@@ -34,6 +38,64 @@ TEST_CASE("Can serialize CiphertextElectionContext")
     CHECK(fromBson->getManifestHash()->toHex() == context->getManifestHash()->toHex());
 }
 
+TEST_CASE("A deserialized CiphertextElectionContext attaches the lookup table of its key")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q());
+    auto otherKeypair = ElGamalKeyPair::fromSecret(*rand_q());
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+    auto otherContext =
+      ElectionGenerator::getFakeContext(*internal, *otherKeypair->getPublicKey());
+    auto path = (filesystem::temp_directory_path() / "eg_test_context_table.bin").string();
+    context->saveLookupTable(path);
+    auto nonce = rand_q();
+
+    // Act
+    auto fromJson = CiphertextElectionContext::fromJson(context->toJson(), path);
+    auto fromBson = CiphertextElectionContext::fromBson(context->toBson(), path);
+    const auto *publicKey = fromJson->getElGamalPublicKey();
+    auto actual = pow_mod_p(*publicKey, *nonce);
+
+    // Assert
+    CHECK(publicKey->isFixedBase());
+    CHECK(fromBson->getElGamalPublicKey()->isFixedBase());
+    CHECK(*actual == *pow_mod_p(ElementModP(publicKey->ref(), true), *nonce,
+                                ExponentiationPolicy::variableTime));
+    CHECK_THROWS(CiphertextElectionContext::fromJson(otherContext->toJson(), path));
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("The lookup table of the key of a context is generated by its first encryption")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(*rand_q());
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto device = make_unique<EncryptionDevice>(12345UL, 23456UL, 34567UL, "Location");
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    auto context = ElectionGenerator::getFakeContext(*internal, *keypair->getPublicKey());
+    auto fromJson = CiphertextElectionContext::fromJson(context->toJson());
+    auto fromBson = CiphertextElectionContext::fromBson(context->toBson());
+
+    // a table generated in the background would be published within this time
+    for (int i = 0; i < 500 && get_lookup_table_cache_statistics().tables == before.tables; i++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    auto constructed = get_lookup_table_cache_statistics();
+    auto mediator = make_unique<EncryptionMediator>(*internal, *context, *device);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(context->getElGamalPublicKey()->isFixedBase());
+    CHECK(constructed.tables == before.tables);
+    CHECK(after.tables == before.tables + 1);
+}
+
 TEST_CASE("Assign ExtraData to CiphertextElectionContext")
 {
     // Arrange
@@ -165,6 +165,67 @@ TEST_CASE("elgamalEncrypt encrypt 1 decrypts with secret")
     CHECK(1UL == decrypted);
 }
 
+TEST_CASE("elgamalEncryptBatch matches elgamalEncrypt and decrypts with secret")
+{
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    // a plain public key rather than a fixed base, so the batch runs across lanes
+    auto publicKey = g_pow_p(*secret);
+
+    vector<uint64_t> messages;
+    vector<unique_ptr<ElementModQ>> ownedNonces;
+    vector<reference_wrapper<const ElementModQ>> nonces;
+    for (uint64_t i = 0; i < 11; i++) {
+        messages.push_back(i % 2);
+        ownedNonces.push_back(rand_q());
+        nonces.push_back(*ownedNonces.back());
+    }
+
+    auto ciphertexts = elgamalEncryptBatch(messages, nonces, *publicKey);
+
+    CHECK(ciphertexts.size() == messages.size());
+    for (size_t i = 0; i < messages.size(); i++) {
+        auto expected = elgamalEncrypt(messages[i], nonces[i].get(), *publicKey);
+        CHECK((*ciphertexts[i]->getPad() == *expected->getPad()));
+        CHECK((*ciphertexts[i]->getData() == *expected->getData()));
+        CHECK(ciphertexts[i]->decrypt(*secret) == messages[i]);
+    }
+}
+
+TEST_CASE("elgamalEncryptBatch rejects zero nonces and mismatched sizes")
+{
+    auto publicKey = g_pow_p(*ElementModQ::fromHex(a_fixed_secret));
+    auto nonce = rand_q();
+
+    CHECK_THROWS(elgamalEncryptBatch({0UL, 1UL}, {*nonce}, *publicKey));
+    CHECK_THROWS(elgamalEncryptBatch({0UL, 1UL}, {*nonce, ZERO_MOD_Q()}, *publicKey));
+}
+
+TEST_CASE("decryptBatch matches decrypt for every ciphertext")
+{
+    auto secret = ElementModQ::fromHex(a_fixed_secret);
+    auto publicKey = g_pow_p(*secret);
+
+    vector<unique_ptr<ElGamalCiphertext>> ciphertexts;
+    vector<reference_wrapper<const ElGamalCiphertext>> refs;
+    for (uint64_t i = 0; i < 19; i++) {
+        ciphertexts.push_back(elgamalEncrypt(i % 2, *rand_q(), *publicKey));
+    }
+    // a ciphertext of a message other than 0 or 1 is not found
+    ciphertexts.push_back(ElGamalCiphertext::make(*g_pow_p(*rand_q()), *g_pow_p(*rand_q())));
+    for (const auto &ciphertext : ciphertexts) {
+        refs.push_back(*ciphertext);
+    }
+
+    auto plaintexts = ElGamalCiphertext::decryptBatch(refs, *secret);
+
+    CHECK(plaintexts.size() == ciphertexts.size());
+    for (size_t i = 0; i < ciphertexts.size(); i++) {
+        CHECK(plaintexts[i] == ciphertexts[i]->decrypt(*secret));
+    }
+    CHECK(plaintexts.back() == MAX_UINT64);
+    CHECK(ElGamalCiphertext::decryptBatch({}, *secret).empty());
+}
+
 TEST_CASE("HashedElGamalCiphertext encrypt and decrypt data")
 {
     uint64_t qwords_to_use[4] = {0x0102030405060708, 0x090a0b0c0d0e0f10, 0x1112131415161718,
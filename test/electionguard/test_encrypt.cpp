@@ -1,4 +1,5 @@
 #include "../../src/electionguard/log.hpp"
+#include "../../src/electionguard/nonces.hpp"
 #include "generators/ballot.hpp"
 #include "generators/election.hpp"
 #include "generators/manifest.hpp"
@@ -9,6 +10,7 @@
 #include <electionguard/election.hpp>
 #include <electionguard/encrypt.hpp>
 #include <electionguard/manifest.hpp>
+#include <electionguard/precompute_buffers.hpp>
 
 using namespace electionguard;
 using namespace electionguard::tools::generators;
@@ -1398,3 +1400,38 @@ TEST_CASE("Verify placeholder flag")
     CHECK(ciphertext->getContests().front().get().getSelections().back().get().getIsPlaceholder() ==
           true);
 }
+
+TEST_CASE("Encrypt contest derives the nonce of every selection from the contest nonce")
+{
+    // Arrange
+    auto keypair = ElGamalKeyPair::fromSecret(TWO_MOD_Q(), false);
+    auto manifest = ManifestGenerator::getJeffersonCountyManifest_Minimal();
+    auto internal = make_unique<InternalManifest>(*manifest);
+    auto ballot = BallotGenerator::getFakeBallot(*internal, 0UL);
+    const auto &contest = ballot->getContests().front().get();
+    auto contestDescriptions = internal->getContests();
+    const auto &description =
+      find_if(contestDescriptions.begin(), contestDescriptions.end(),
+              [&contest](const ContestDescriptionWithPlaceholders &item) {
+                  return item.getObjectId() == contest.getObjectId();
+              })
+        ->get();
+    auto nonceSeed = ElementModQ::fromHex(a_fixed_nonce);
+    PrecomputeBufferContext::empty_queues();
+
+    // Act
+    auto encrypted = encryptContest(contest, *internal, description, *keypair->getPublicKey(),
+                                    ONE_MOD_Q(), *nonceSeed, false);
+
+    // Assert
+    auto descriptions = description.getSelections();
+    auto placeholders = description.getPlaceholders();
+    descriptions.insert(descriptions.end(), placeholders.begin(), placeholders.end());
+    auto selections = encrypted->getSelections();
+    REQUIRE(selections.size() == descriptions.size());
+    for (size_t i = 0; i < selections.size(); i++) {
+        Nonces nonces(*descriptions[i].get().crypto_hash(), encrypted->getNonce());
+        auto expected = nonces.get(descriptions[i].get().getSequenceOrder());
+        CHECK(selections[i].get().getNonce()->toHex() == expected->toHex());
+    }
+}
@@ -1,17 +1,27 @@
 #include "../../src/electionguard/convert.hpp"
 #include "../../src/electionguard/facades/Hacl_Bignum256.hpp"
+#include "../../src/electionguard/facades/Hacl_Bignum4096.hpp"
 #include "../../src/electionguard/log.hpp"
+#include "../../src/electionguard/lookup_table.hpp"
+#include "../../src/electionguard/mont_element.hpp"
+#include "../../src/electionguard/montgomery_kernels.hpp"
+#include "../../src/electionguard/q_field.hpp"
+#include "../../src/electionguard/residue_cache.hpp"
 #include "../../src/electionguard/utils.hpp"
 #include "utils/byte_logger.hpp"
 #include "utils/constants.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <doctest/doctest.h>
 #include <electionguard/constants.h>
 #include <electionguard/group.hpp>
 #include <exception>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <random>
 #include <string>
 
 using namespace electionguard;
@@ -405,6 +415,77 @@ TEST_CASE("negate_mod_q for MAX Q is 0")
     CHECK((*result == *zero));
 }
 
+TEST_CASE("a_minus_bc_mod_q for 7 - (2 x 3) % Q = 1 and 1 - (2 x 3) % Q = Q - 5")
+{
+    // Arrange
+    auto one = ElementModQ::fromUint64(1);
+    auto two = ElementModQ::fromUint64(2);
+    auto three = ElementModQ::fromUint64(3);
+    auto five = ElementModQ::fromUint64(5);
+    auto seven = ElementModQ::fromUint64(7);
+
+    // Act
+    auto result = a_minus_bc_mod_q(*seven, *two, *three);
+    auto wrapped = a_minus_bc_mod_q(*one, *two, *three);
+
+    // Assert
+    CHECK((*result == *one));
+    CHECK((*wrapped == *sub_from_q(*five)));
+}
+
+TEST_CASE("q field kernels match the general reduction for random operands")
+{
+    for (int i = 0; i < 64; i++) {
+        auto a = rand_q();
+        auto b = rand_q();
+        auto c = rand_q();
+
+        // (a + b) mod q
+        uint64_t sum[MAX_Q_LEN_DOUBLE] = {};
+        sum[MAX_Q_LEN] = Bignum256::add(a->get(), b->get(), sum);
+        uint64_t expectedSum[MAX_Q_LEN] = {};
+        CONTEXT_Q().mod(sum, expectedSum);
+        CHECK((*add_mod_q(*a, *b) == ElementModQ(expectedSum, true)));
+
+        // (a - b) mod q, as (a + (q - b)) mod q
+        uint64_t negated[MAX_Q_LEN] = {};
+        Bignum256::sub(const_cast<uint64_t *>(Q().get()), b->get(), negated);
+        uint64_t difference[MAX_Q_LEN_DOUBLE] = {};
+        difference[MAX_Q_LEN] = Bignum256::add(a->get(), negated, difference);
+        uint64_t expectedDifference[MAX_Q_LEN] = {};
+        CONTEXT_Q().mod(difference, expectedDifference);
+        CHECK((*sub_mod_q(*a, *b) == ElementModQ(expectedDifference, true)));
+
+        // (a + b * c) mod q
+        uint64_t product[MAX_Q_LEN_DOUBLE] = {};
+        Bignum256::mul(b->get(), c->get(), product);
+        uint64_t expectedProduct[MAX_Q_LEN] = {};
+        CONTEXT_Q().mod(product, expectedProduct);
+        CHECK((*a_plus_bc_mod_q(ZERO_MOD_Q(), *b, *c) == ElementModQ(expectedProduct, true)));
+        auto expectedMulAdd = add_mod_q(*a, ElementModQ(expectedProduct, true));
+        CHECK((*a_plus_bc_mod_q(*a, *b, *c) == *expectedMulAdd));
+
+        // (a - b * c) + b * c == a
+        auto mulSub = a_minus_bc_mod_q(*a, *b, *c);
+        CHECK((*a_plus_bc_mod_q(*mulSub, *b, *c) == *a));
+    }
+}
+
+TEST_CASE("mod_q_reduce_wide reduces the largest wide value")
+{
+    uint64_t wide[MAX_Q_LEN_DOUBLE] = {};
+    fill(begin(wide), end(wide), 0xFFFFFFFFFFFFFFFF);
+    uint64_t copied[MAX_Q_LEN_DOUBLE] = {};
+    copy(begin(wide), end(wide), begin(copied));
+
+    uint64_t expected[MAX_Q_LEN] = {};
+    CONTEXT_Q().mod(copied, expected);
+    uint64_t actual[MAX_Q_LEN] = {};
+    mod_q_reduce_wide(wide, actual);
+
+    CHECK(equal(begin(actual), end(actual), begin(expected)));
+}
+
 #pragma endregion
 
 #pragma region add_mod_p
@@ -528,6 +609,75 @@ TEST_CASE("mul_mod_p 3 * 3 should equal 9")
     CHECK(p->toHex() == "09");
 }
 
+TEST_CASE("mul_mod_p into an output that aliases an input matches the allocating overload")
+{
+    // Arrange
+    auto a = g_pow_p(*rand_q());
+    auto b = g_pow_p(*rand_q());
+    auto expected = mul_mod_p(*a, *b);
+    ElementModP product(*a);
+
+    // Act
+    mul_mod_p(product, *b, product);
+
+    // Assert
+    CHECK(product == *expected);
+    CHECK(product.isFixedBase() == false);
+}
+
+TEST_CASE("mul_mod_p of a list matches multiplying the elements one at a time")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> elements;
+    for (auto i = 0; i < 7; i++) {
+        elements.push_back(g_pow_p(*rand_q()));
+    }
+    auto expected = ElementModP::fromUint64(1UL);
+    vector<ElementModPOrQ> elems;
+    for (const auto &element : elements) {
+        expected = mul_mod_p(*expected, *element);
+        elems.push_back(element.get());
+    }
+
+    // Act
+    auto product = mul_mod_p(elems);
+    auto empty = mul_mod_p(vector<ElementModPOrQ>{});
+
+    // Assert
+    CHECK(*product == *expected);
+    CHECK(*empty == ONE_MOD_P());
+}
+
+TEST_CASE("MontElementModP chains mixing montgomery and standard form operands match mul_mod_p")
+{
+    // Arrange
+    auto a = g_pow_p(*rand_q());
+    auto b = g_pow_p(*rand_q());
+    auto c = g_pow_p(*rand_q());
+    auto ab = mul_mod_p(*a, *b);
+    auto abc = mul_mod_p(*ab, *c);
+    auto abcSquared = mul_mod_p(*abc, *abc);
+
+    // Act
+    MontElementModP converted(*a);
+    converted.mul(MontElementModP(*b)).mul(MontElementModP(*c));
+
+    MontElementModP standard;
+    standard.mul(*a).mul(*b).mul(*c);
+
+    MontElementModP mixed(*a);
+    MontElementModP partial;
+    partial.mul(*b);
+    mixed.mul(partial).mul(*c).sqr();
+
+    // Assert
+    CHECK(*MontElementModP().toElementModP() == ONE_MOD_P());
+    CHECK(*MontElementModP(*a).toElementModP() == *a);
+    CHECK(*converted.toElementModP() == *abc);
+    CHECK(*standard.toElementModP() == *abc);
+    CHECK(*mixed.toElementModP() == *abcSquared);
+}
+
 #ifdef USE_STANDARD_PRIMES
 
 TEST_CASE("mul_mod_p for max uint64 * max uint64 should equal hex value "
@@ -567,6 +717,206 @@ TEST_CASE("pow_mod_p 2 ^ 3 = 8 and 3 ^ 2 = 9")
     CHECK((*result9 == *nine));
 }
 
+TEST_CASE("pow_mod_p constant and variable time policies match hacl")
+{
+    // Arrange
+    vector<unique_ptr<ElementModQ>> exponents;
+    exponents.push_back(ElementModQ::fromUint64(1UL));
+    exponents.push_back(ElementModQ::fromUint64(31UL));
+    exponents.push_back(ElementModQ::fromUint64(0x10000UL));
+    exponents.push_back(sub_mod_q(Q(), ONE_MOD_Q()));
+    for (auto i = 0; i < 4; i++) {
+        exponents.push_back(rand_q());
+    }
+
+    for (const auto &exponent : exponents) {
+        auto base = rand_p();
+        uint64_t expected[MAX_P_LEN] = {};
+        CONTEXT_P().modExpQ(base->get(), exponent->get(), expected);
+
+        // Act
+        auto constantTime = pow_mod_p(*base, *exponent, ExponentiationPolicy::constantTime);
+        auto variableTime = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+        set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+        auto maskedWindow = pow_mod_p(*base, *exponent, ExponentiationPolicy::constantTime);
+        set_constant_time_implementation(ConstantTimeImplementation::verified);
+
+        // Assert
+        CHECK((*constantTime == ElementModP(expected, true)));
+        CHECK((*variableTime == ElementModP(expected, true)));
+        CHECK((*maskedWindow == ElementModP(expected, true)));
+    }
+}
+
+TEST_CASE("pow_mod_p with a full width exponent matches for both policies")
+{
+    // Arrange
+    auto base = rand_p();
+    auto exponent = rand_p();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExp(base->get(), MAX_P_SIZE * 8U, exponent->get(), expected);
+
+    // Act
+    auto constantTime = pow_mod_p(*base, *exponent, ExponentiationPolicy::constantTime);
+    auto variableTime = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+    auto maskedWindow = pow_mod_p(*base, *exponent, ExponentiationPolicy::constantTime);
+    set_constant_time_implementation(ConstantTimeImplementation::verified);
+
+    // Assert
+    CHECK((*constantTime == ElementModP(expected, true)));
+    CHECK((*variableTime == ElementModP(expected, true)));
+    CHECK((*maskedWindow == ElementModP(expected, true)));
+}
+
+/// <summary>
+/// Welch's t statistic between the timings of an exponentiation with a fixed exponent and
+/// with random exponents, measured in random order as dudect does. The slowest tenth of the
+/// measurements is cropped so that interruptions of the process do not dominate. A leak of
+/// the exponent through the timing shows as a large statistic.
+/// </summary>
+static double exponentTimingStatistic(const ElementModP &base, ExponentiationPolicy policy,
+                                      size_t measurements)
+{
+    auto fixed = ElementModQ::fromUint64(1UL);
+    vector<unique_ptr<ElementModQ>> exponents;
+    vector<bool> classes;
+    mt19937 generator(measurements);
+    for (size_t i = 0; i < measurements; i++) {
+        classes.push_back((generator() & 1U) == 1U);
+        exponents.push_back(classes.back() ? rand_q() : make_unique<ElementModQ>(*fixed));
+    }
+
+    ElementModP power;
+    vector<double> timings;
+    for (size_t i = 0; i < measurements; i++) {
+        auto start = chrono::steady_clock::now();
+        pow_mod_p(base, *exponents[i], power, policy);
+        timings.push_back(chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+
+    auto sorted = timings;
+    sort(sorted.begin(), sorted.end());
+    auto cutoff = sorted[sorted.size() * 9 / 10];
+    double count[2] = {}, mean[2] = {}, squares[2] = {};
+    for (size_t i = 0; i < measurements; i++) {
+        if (timings[i] > cutoff) {
+            continue;
+        }
+        auto c = classes[i] ? 1 : 0;
+        count[c] += 1;
+        auto delta = timings[i] - mean[c];
+        mean[c] += delta / count[c];
+        squares[c] += delta * (timings[i] - mean[c]);
+    }
+    auto variance = squares[0] / (count[0] - 1) / count[0] + squares[1] / (count[1] - 1) / count[1];
+    return fabs(mean[0] - mean[1]) / sqrt(variance);
+}
+
+TEST_CASE("The masked window exponentiations do not leak the exponent through their timing")
+{
+    // Arrange
+    // dudect considers a statistic above ten a definite leak
+    const double threshold = 10.0;
+    auto base = rand_p();
+    set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+
+    // Act
+    auto window = exponentTimingStatistic(*base, ExponentiationPolicy::constantTime, 1000);
+    auto table = exponentTimingStatistic(G(), ExponentiationPolicy::constantTime, 1000);
+    auto sliding = exponentTimingStatistic(*base, ExponentiationPolicy::variableTime, 200);
+    set_constant_time_implementation(ConstantTimeImplementation::verified);
+
+    // Assert
+    CHECK(window < threshold);
+    CHECK(table < threshold);
+    // the sliding window skips the zero bits of the fixed exponent
+    CHECK(sliding > threshold);
+}
+
+TEST_CASE("pow_mod_p_batch matches pow_mod_p for variable and fixed bases")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> ownedBases;
+    vector<unique_ptr<ElementModQ>> ownedExponents;
+    for (auto i = 0; i < 11; i++) {
+        ownedBases.push_back(g_pow_p(*rand_q()));
+        ownedExponents.push_back(rand_q());
+    }
+    ownedBases.push_back(ElementModP::fromUint64(1UL));
+    ownedExponents.push_back(rand_q());
+    ownedBases.push_back(g_pow_p(*rand_q()));
+    ownedExponents.push_back(make_unique<ElementModQ>(ZERO_MOD_Q()));
+    ownedBases.push_back(g_pow_p(*rand_q()));
+    ownedExponents.push_back(sub_mod_q(ZERO_MOD_Q(), ONE_MOD_Q()));
+
+    vector<reference_wrapper<const ElementModP>> bases;
+    vector<reference_wrapper<const ElementModQ>> exponents;
+    for (size_t i = 0; i < ownedBases.size(); i++) {
+        bases.push_back(*ownedBases[i]);
+        exponents.push_back(*ownedExponents[i]);
+    }
+    bases.push_back(G());
+    exponents.push_back(*ownedExponents[0]);
+
+    // Act
+    auto verified = pow_mod_p_batch(bases, exponents);
+
+    set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+    auto results = pow_mod_p_batch(bases, exponents);
+
+    auto previous = getMontgomeryKernel();
+    setMontgomeryKernel(MontgomeryKernel::portable);
+    auto fallbackResults = pow_mod_p_batch(bases, exponents);
+    setMontgomeryKernel(previous);
+    set_constant_time_implementation(ConstantTimeImplementation::verified);
+
+    // Assert
+    REQUIRE(verified.size() == bases.size());
+    REQUIRE(results.size() == bases.size());
+    REQUIRE(fallbackResults.size() == bases.size());
+    for (size_t i = 0; i < bases.size(); i++) {
+        auto expected = pow_mod_p(bases[i].get(), exponents[i].get());
+        CHECK(*verified[i] == *expected);
+        CHECK(*results[i] == *expected);
+        CHECK(*fallbackResults[i] == *expected);
+    }
+}
+
+TEST_CASE("inv_mod_p_batch inverts every element")
+{
+    // Arrange
+    vector<unique_ptr<ElementModP>> ownedElements;
+    for (auto i = 0; i < 9; i++) {
+        ownedElements.push_back(g_pow_p(*rand_q()));
+    }
+    ownedElements.push_back(ElementModP::fromUint64(1UL));
+    ownedElements.push_back(ElementModP::fromUint64(2UL));
+
+    vector<reference_wrapper<const ElementModP>> elements;
+    for (const auto &element : ownedElements) {
+        elements.push_back(*element);
+    }
+
+    // Act
+    auto inverses = inv_mod_p_batch(elements);
+    auto single = inv_mod_p_batch({elements[0]});
+
+    // Assert
+    REQUIRE(inverses.size() == elements.size());
+    for (size_t i = 0; i < elements.size(); i++) {
+        CHECK(*mul_mod_p(elements[i].get(), *inverses[i]) == ONE_MOD_P());
+    }
+    CHECK(*single[0] == *inverses[0]);
+    CHECK(inv_mod_p_batch({}).empty());
+    CHECK_THROWS(inv_mod_p_batch({elements[0], ZERO_MOD_P()}));
+}
+
+TEST_CASE("pow_mod_p_batch with mismatched sizes throws")
+{
+    CHECK_THROWS(pow_mod_p_batch({G()}, {}));
+}
+
 #pragma endregion
 
 #pragma region g_pow_p
@@ -607,6 +957,279 @@ TEST_CASE("Test g_pow_p with random")
 
 #pragma endregion
 
+#pragma region multi_pow_mod_p
+
+TEST_CASE("multi_pow_mod_p of two bases matches the product of pow_mod_p")
+{
+    // Arrange
+    auto base1 = g_pow_p(*rand_q());
+    auto base2 = g_pow_p(*rand_q());
+    auto exp1 = rand_q();
+    auto exp2 = rand_q();
+
+    // Act
+    auto expected = mul_mod_p(*pow_mod_p(*base1, *exp1), *pow_mod_p(*base2, *exp2));
+    auto actual = multi_pow_mod_p({*base1, *base2}, {*exp1, *exp2});
+
+    // Assert
+    CHECK((*expected == *actual));
+}
+
+TEST_CASE("multi_pow_mod_p with a fixed base matches g^a * K^b")
+{
+    // Arrange
+    auto k = g_pow_p(*rand_q());
+    auto a = rand_q();
+    auto b = rand_q();
+
+    // Act
+    auto expected = mul_mod_p(*g_pow_p(*a), *pow_mod_p(*k, *b));
+    auto actual = multi_pow_mod_p({G(), *k}, {*a, *b});
+
+    // Assert
+    CHECK((*expected == *actual));
+}
+
+TEST_CASE("multi_pow_mod_p with zero exponents and no bases returns one")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exp = rand_q();
+
+    // Act
+    auto zeros = multi_pow_mod_p({*base, G()}, {ZERO_MOD_Q(), ZERO_MOD_Q()});
+    auto partial = multi_pow_mod_p({*base, G()}, {*exp, ZERO_MOD_Q()});
+    auto empty = multi_pow_mod_p({}, {});
+
+    // Assert
+    CHECK((*zeros == ONE_MOD_P()));
+    CHECK((*partial == *pow_mod_p(*base, *exp)));
+    CHECK((*empty == ONE_MOD_P()));
+}
+
+TEST_CASE("multi_pow_mod_p with mismatched sizes throws")
+{
+    auto base = g_pow_p(*rand_q());
+    CHECK_THROWS_WITH(multi_pow_mod_p({*base, G()}, {ONE_MOD_Q()}),
+                      "multi_pow_mod_p:: bases and exponents must be the same size");
+}
+
+TEST_CASE("multi_pow_mod_p of many bases matches the product of pow_mod_p")
+{
+    // Arrange
+    const size_t count = 130;
+    vector<unique_ptr<ElementModP>> bases;
+    vector<unique_ptr<ElementModQ>> exponents;
+    vector<reference_wrapper<const ElementModP>> baseRefs;
+    vector<reference_wrapper<const ElementModQ>> exponentRefs;
+    auto expected = ElementModP::fromUint64(1UL);
+    for (size_t i = 0; i < count; i++) {
+        bases.push_back(g_pow_p(*rand_q()));
+        exponents.push_back(rand_q());
+        baseRefs.push_back(*bases.back());
+        exponentRefs.push_back(*exponents.back());
+        expected = mul_mod_p(*expected, *pow_mod_p(*bases.back(), *exponents.back()));
+    }
+
+    // Act
+    auto actual = multi_pow_mod_p(baseRefs, exponentRefs);
+
+    // Assert
+    CHECK((*expected == *actual));
+}
+
+#pragma endregion
+
+#pragma region lookup table files
+
+TEST_CASE("A saved lookup table loads from its file and matches modExp")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto path = (filesystem::temp_directory_path() / "eg_test_lookup_table.bin").string();
+    LookupTableType(base->get()).save(path, base->ref());
+
+    // Act
+    auto table = LookupTableType::load(path, base->ref());
+    auto actual = table->pow_mod_p(exponent->ref());
+
+    load_lookup_table(*base, path);
+    auto viaContext = pow_mod_p(*base, *exponent);
+
+    // Assert
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    CHECK(equal(begin(expected), end(expected), actual.begin()));
+    CHECK(base->isFixedBase());
+    CHECK(equal(begin(expected), end(expected), viaContext->get()));
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("A lookup table file is rejected for a different base")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto other = g_pow_p(*rand_q());
+    auto path = (filesystem::temp_directory_path() / "eg_test_lookup_table_other.bin").string();
+    LookupTableType(base->get()).save(path, base->ref());
+
+    // Act & Assert
+    CHECK_THROWS_WITH(LookupTableType::load(path, other->ref()),
+                      ("LookupTable:: " + path +
+                       " does not match the base or the group parameters")
+                        .c_str());
+    CHECK_THROWS(load_lookup_table(*other, path));
+    CHECK(other->isFixedBase() == false);
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("A lookup table file with altered values is rejected")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto path = (filesystem::temp_directory_path() / "eg_test_lookup_table_altered.bin").string();
+    LookupTableType(base->get()).save(path, base->ref());
+
+    // flip a bit of a value deep in the table, far from the first entry
+    {
+        fstream file(path, ios::binary | ios::in | ios::out);
+        auto offset = static_cast<streamoff>(LUT_FILE_HEADER_SIZE + LookupTableType::sizeInBytes() -
+                                             MAX_P_SIZE / 2);
+        file.seekg(offset);
+        char byte = 0;
+        file.read(&byte, 1);
+        byte ^= 0x10;
+        file.seekp(offset);
+        file.write(&byte, 1);
+    }
+
+    // Act & Assert
+    CHECK_THROWS_WITH(LookupTableType::load(path, base->ref()),
+                      ("LookupTable:: " + path + " contains unexpected values").c_str());
+
+    filesystem::remove(path);
+}
+
+TEST_CASE("A lookup table file is loaded with the window size it was saved with")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    auto path = (filesystem::temp_directory_path() / "eg_test_lookup_table_window.bin").string();
+    LookupTable6(base->get()).save(path, base->ref());
+
+    // Act
+    auto table = loadLookupTable(path, base->ref());
+    auto actual = table->pow_mod_p(exponent->ref());
+
+    // Assert
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    CHECK(table->windowSize() == 6);
+    CHECK(equal(begin(expected), end(expected), actual.begin()));
+    CHECK_THROWS(LookupTableType::load(path, base->ref()));
+
+    filesystem::remove(path);
+}
+
+#pragma endregion
+
+#pragma region isValidResidue
+
+TEST_CASE("isValidResidue remembers a validated element until it changes")
+{
+    // Arrange
+    auto element = g_pow_p(*rand_q());
+    auto sizeBefore = ResidueCache::size();
+
+    // Act
+    auto first = element->isValidResidue();
+    auto second = element->isValidResidue();
+    auto cloned = element->clone();
+    auto copied = ElementModP(element->ref(), true);
+
+    // Assert
+    CHECK(first == true);
+    CHECK(second == true);
+    CHECK(cloned->isValidResidue() == true);
+    CHECK(copied.isValidResidue() == true);
+    CHECK(ResidueCache::size() >= min(sizeBefore + 1, ResidueCache::getCapacity()));
+
+    // P - 1 is not a member of the subgroup since (P - 1)^Q = -1
+    copy(begin(P().ref()), end(P().ref()), element->get());
+    element->get()[0] -= 1;
+    CHECK(element->isValidResidue() == false);
+    CHECK(element->isValidResidue() == false);
+
+    // assignments and in-place arithmetic drop the proof of the previous value
+    auto minusOne = ElementModP(element->ref(), true);
+    CHECK(copied.isValidResidue() == true);
+    copied = minusOne;
+    CHECK(copied.isValidResidue() == false);
+    CHECK(cloned->isValidResidue() == true);
+    mul_mod_p(minusOne, ONE_MOD_P(), *cloned);
+    CHECK(cloned->isValidResidue() == false);
+}
+
+TEST_CASE("isValidResidue keeps the proof of an element that is only read")
+{
+    // Arrange
+    auto capacity = ResidueCache::getCapacity();
+    ResidueCache::setCapacity(0);
+    auto element = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    CHECK(element->isValidResidue() == true);
+
+    // Act
+    auto power = pow_mod_p(*element, *exponent);
+    auto product = mul_mod_p(*element, *power);
+    auto combined = multi_pow_mod_p({*element, G()}, {*exponent, *exponent});
+    auto before = get_exponentiation_statistics();
+    auto valid = element->isValidResidue();
+    auto after = get_exponentiation_statistics();
+
+    // Assert
+    CHECK(valid == true);
+    CHECK(after.variableTime == before.variableTime);
+    CHECK(after.constantTime == before.constantTime);
+
+    ResidueCache::setCapacity(capacity);
+}
+
+TEST_CASE("ResidueCache evicts the oldest elements beyond its capacity")
+{
+    // Arrange
+    auto capacity = ResidueCache::getCapacity();
+    ResidueCache::clear();
+    ResidueCache::setCapacity(2);
+    auto first = g_pow_p(*rand_q());
+    auto second = g_pow_p(*rand_q());
+    auto third = g_pow_p(*rand_q());
+
+    // Act
+    ResidueCache::insert(first->ref(), limbDigest(first->ref()));
+    ResidueCache::insert(second->ref(), limbDigest(second->ref()));
+    ResidueCache::insert(second->ref(), limbDigest(second->ref()));
+    ResidueCache::insert(third->ref(), limbDigest(third->ref()));
+
+    // Assert
+    CHECK(ResidueCache::size() == 2);
+    CHECK(ResidueCache::contains(first->ref(), limbDigest(first->ref())) == false);
+    CHECK(ResidueCache::contains(second->ref(), limbDigest(second->ref())) == true);
+    CHECK(ResidueCache::contains(third->ref(), limbDigest(third->ref())) == true);
+
+    ResidueCache::setCapacity(0);
+    CHECK(ResidueCache::size() == 0);
+    CHECK(ResidueCache::contains(third->ref(), limbDigest(third->ref())) == false);
+
+    ResidueCache::setCapacity(capacity);
+}
+
+#pragma endregion
+
 #pragma region Q Misc
 
 TEST_CASE("Max of Q + 1 throws")
@@ -656,6 +1279,70 @@ TEST_CASE("Test Q is converted correctly")
 
 #pragma endregion
 
+#pragma region element values
+
+TEST_CASE("Elements hold their limbs inline aligned to a cache line")
+{
+    // Arrange
+    ElementModP p;
+    ElementModQ q;
+    auto heap = rand_q();
+
+    // Assert
+    CHECK(alignof(ElementModPValue) == 64);
+    CHECK(alignof(ElementModQValue) == 64);
+    CHECK(reinterpret_cast<uintptr_t>(p.get()) % 64 == 0);
+    CHECK(reinterpret_cast<uintptr_t>(q.get()) % 64 == 0);
+    CHECK(reinterpret_cast<uintptr_t>(heap->get()) % 64 == 0);
+    CHECK(reinterpret_cast<uintptr_t>(p.get()) >= reinterpret_cast<uintptr_t>(&p));
+    CHECK(reinterpret_cast<uintptr_t>(p.get()) < reinterpret_cast<uintptr_t>(&p) + sizeof(p));
+    CHECK(p == const_cast<ElementModP &>(ZERO_MOD_P()));
+    CHECK(q == const_cast<ElementModQ &>(ZERO_MOD_Q()));
+}
+
+TEST_CASE("Element values are zeroized")
+{
+    // Arrange
+    auto random = rand_q();
+    ElementModQValue value(random->ref());
+
+    // Act
+    value.zeroize();
+
+    // Assert
+    CHECK(value == ElementModQValue());
+}
+
+TEST_CASE("Q arithmetic into outputs that alias the inputs matches the allocating overloads")
+{
+    // Arrange
+    auto a = rand_q();
+    auto b = rand_q();
+    auto c = rand_q();
+    ElementModQ sum(*a);
+    ElementModQ difference(*a);
+    ElementModQ combined(*c);
+    ElementModQ negated(*a);
+    ElementModP power(G());
+
+    // Act
+    add_mod_q(sum, *b, sum);
+    sub_mod_q(difference, *b, difference);
+    a_plus_bc_mod_q(*a, *b, combined, combined);
+    sub_from_q(negated, negated);
+    pow_mod_p(power, *a, power);
+
+    // Assert
+    CHECK(sum == *add_mod_q(*a, *b));
+    CHECK(difference == *sub_mod_q(*a, *b));
+    CHECK(combined == *a_plus_bc_mod_q(*a, *b, *c));
+    CHECK(negated == *sub_from_q(*a));
+    CHECK(power == *g_pow_p(*a));
+    CHECK(power.isFixedBase() == false);
+}
+
+#pragma endregion
+
 #pragma region P Misc
 
 TEST_CASE("Test P is converted correctly")
@@ -1,11 +1,20 @@
 #include "../../src/electionguard/facades/Hacl_Bignum256.hpp"
 #include "../../src/electionguard/facades/Hacl_Bignum4096.hpp"
+#include "../../src/electionguard/hmac_drbg.hpp"
 #include "../../src/electionguard/log.hpp"
+#include "../../src/electionguard/montgomery_kernels.hpp"
+#include "../../src/electionguard/sha256.hpp"
+#include "../../src/karamel/Hacl_HMAC_DRBG.h"
+#include "../../src/karamel/internal/Hacl_HMAC.h"
+#include "../../src/karamel/internal/Hacl_Hash.h"
 #include "utils/constants.hpp"
 
+#include <algorithm>
 #include <doctest/doctest.h>
 #include <electionguard/constants.h>
+#include <electionguard/group.hpp>
 #include <electionguard/hash.hpp>
+#include <vector>
 
 using namespace electionguard;
 using namespace hacl;
@@ -214,6 +223,25 @@ TEST_CASE("Hacl_Bignum4096_mod_exp Test mod exp for BigNum 4096 valid preconditi
     CHECK((*result == *expected));
 }
 
+TEST_CASE("Bignum4096 modExpQ with a 256-bit exponent matches modExp with a 4096-bit exponent")
+{
+    // Arrange
+    auto exponent = rand_q();
+    uint64_t widened[MAX_P_LEN] = {};
+    copy(exponent->get(), exponent->get() + MAX_Q_LEN, widened);
+
+    uint64_t expected[MAX_P_LEN] = {};
+    uint64_t result[MAX_P_LEN] = {};
+
+    // Act
+    CONTEXT_P().modExp(const_cast<uint64_t *>(G_ARRAY_REVERSE), MAX_P_LEN * 64U, widened,
+                       expected);
+    CONTEXT_P().modExpQ(const_cast<uint64_t *>(G_ARRAY_REVERSE), exponent->get(), result);
+
+    // Assert
+    CHECK(equal(begin(result), end(result), begin(expected)));
+}
+
 TEST_CASE("Hacl_Bignum256_mod_exp Test mod exp for BigNum 256 invalid preconditions fails")
 {
     uint64_t mod_valid[MAX_Q_LEN] = {0x05};
@@ -261,6 +289,219 @@ TEST_CASE("Hacl_Bignum256_mod_exp Test mod exp for BigNum 256 valid precondition
 
 #pragma endregion
 
+#pragma region montgomery kernels
+
+TEST_CASE("The detected montgomery kernel is supported and the portable kernel always is")
+{
+    CHECK(isMontgomeryKernelSupported(MontgomeryKernel::portable));
+    CHECK(isMontgomeryKernelSupported(detectMontgomeryKernel()));
+    CHECK(isMontgomeryKernelSupported(getMontgomeryKernel()));
+}
+
+TEST_CASE("Montgomery kernels match hacl for random and edge case operands")
+{
+    // Arrange
+    vector<vector<uint64_t>> operands;
+    uint64_t zero[MAX_P_LEN] = {};
+    uint64_t one[MAX_P_LEN] = {1};
+    uint64_t oneM[MAX_P_LEN] = {};
+    CONTEXT_P().montgomery_one(oneM);
+    uint64_t pMinusOne[MAX_P_LEN] = {};
+    copy(P().get(), P().get() + MAX_P_LEN, pMinusOne);
+    pMinusOne[0] -= 1;
+    for (auto *operand : {zero, one, oneM, pMinusOne}) {
+        operands.emplace_back(operand, operand + MAX_P_LEN);
+    }
+    for (auto i = 0; i < 8; i++) {
+        auto element = g_pow_p(*rand_q());
+        operands.emplace_back(element->get(), element->get() + MAX_P_LEN);
+    }
+
+    auto previous = getMontgomeryKernel();
+    for (auto kernel : {MontgomeryKernel::adx, MontgomeryKernel::ifma}) {
+        if (!isMontgomeryKernelSupported(kernel)) {
+            continue;
+        }
+
+        for (auto &a : operands) {
+            for (auto &b : operands) {
+                uint64_t expected[MAX_P_LEN] = {};
+                uint64_t expectedSquare[MAX_P_LEN] = {};
+                uint64_t result[MAX_P_LEN] = {};
+                uint64_t square[MAX_P_LEN] = {};
+
+                // Act
+                setMontgomeryKernel(MontgomeryKernel::portable);
+                CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(a.data(), b.data(), expected);
+                CONTEXT_P().montgomery_mod_sqr_stay_in_mont_form(a.data(), expectedSquare);
+                setMontgomeryKernel(kernel);
+                CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(a.data(), b.data(), result);
+                CONTEXT_P().montgomery_mod_sqr_stay_in_mont_form(a.data(), square);
+
+                // Assert
+                CHECK(equal(begin(result), end(result), begin(expected)));
+                CHECK(equal(begin(square), end(square), begin(expectedSquare)));
+            }
+        }
+    }
+    setMontgomeryKernel(previous);
+}
+
+TEST_CASE("Montgomery kernels accept an output that aliases an operand")
+{
+    // Arrange
+    auto a = g_pow_p(*rand_q());
+    auto b = g_pow_p(*rand_q());
+
+    auto previous = getMontgomeryKernel();
+    setMontgomeryKernel(MontgomeryKernel::portable);
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(a->get(), b->get(), expected);
+
+    for (auto kernel : {MontgomeryKernel::adx, MontgomeryKernel::ifma}) {
+        if (!isMontgomeryKernelSupported(kernel)) {
+            continue;
+        }
+        uint64_t result[MAX_P_LEN] = {};
+        copy(a->get(), a->get() + MAX_P_LEN, result);
+
+        // Act
+        setMontgomeryKernel(kernel);
+        CONTEXT_P().montgomery_mod_mul_stay_in_mont_form(result, b->get(), result);
+
+        // Assert
+        CHECK(equal(begin(result), end(result), begin(expected)));
+    }
+    setMontgomeryKernel(previous);
+}
+
+#pragma endregion
+
+#pragma region sha256 kernels
+
+/// <summary>
+/// a message whose bytes differ from each other, so misplaced bytes change the digest
+/// </summary>
+static vector<uint8_t> patternBytes(size_t size, uint8_t seed)
+{
+    vector<uint8_t> bytes(size);
+    for (size_t i = 0; i < size; i++) {
+        bytes[i] = static_cast<uint8_t>(i * 31 + seed);
+    }
+    return bytes;
+}
+
+TEST_CASE("The detected sha256 kernel is supported and the portable kernel always is")
+{
+    CHECK(isSha256KernelSupported(Sha256Kernel::portable));
+    CHECK(isSha256KernelSupported(detectSha256Kernel()));
+    CHECK(isSha256KernelSupported(getSha256Kernel()));
+}
+
+TEST_CASE("Sha256 kernels match hacl for messages of every length written in parts")
+{
+    auto previous = getSha256Kernel();
+    for (auto kernel : {Sha256Kernel::portable, Sha256Kernel::shani}) {
+        if (!isSha256KernelSupported(kernel)) {
+            continue;
+        }
+        setSha256Kernel(kernel);
+
+        for (size_t size = 0; size < 300; size++) {
+            // Arrange
+            auto message = patternBytes(size, static_cast<uint8_t>(size));
+            uint8_t expected[SHA256_DIGEST_SIZE] = {};
+            Hacl_Hash_SHA2_hash_256(message.data(), static_cast<uint32_t>(size), expected);
+
+            // Act
+            Sha256 whole;
+            whole.update(message.data(), size);
+            uint8_t actual[SHA256_DIGEST_SIZE] = {};
+            whole.finish(actual);
+
+            Sha256 parts;
+            auto split = size / 3;
+            parts.update(message.data(), split);
+            parts.update(message.data() + split, size - split);
+            uint8_t partsActual[SHA256_DIGEST_SIZE] = {};
+            parts.finish(partsActual);
+
+            // Assert
+            CHECK(equal(begin(actual), end(actual), begin(expected)));
+            CHECK(equal(begin(partsActual), end(partsActual), begin(expected)));
+        }
+    }
+    setSha256Kernel(previous);
+}
+
+TEST_CASE("hmac_sha256 matches hacl for short, block sized and long keys")
+{
+    auto previous = getSha256Kernel();
+    for (auto kernel : {Sha256Kernel::portable, Sha256Kernel::shani}) {
+        if (!isSha256KernelSupported(kernel)) {
+            continue;
+        }
+        setSha256Kernel(kernel);
+
+        for (size_t keySize : {1UL, 32UL, 64UL, 65UL, 200UL}) {
+            // Arrange
+            auto key = patternBytes(keySize, 7);
+            auto data = patternBytes(keySize * 3 + 5, 11);
+            uint8_t expected[SHA256_DIGEST_SIZE] = {};
+            Hacl_HMAC_compute_sha2_256(expected, key.data(), static_cast<uint32_t>(key.size()),
+                                       data.data(), static_cast<uint32_t>(data.size()));
+
+            // Act
+            uint8_t actual[SHA256_DIGEST_SIZE] = {};
+            hmac_sha256(key.data(), key.size(), data.data(), data.size(), actual);
+
+            // Assert
+            CHECK(equal(begin(actual), end(actual), begin(expected)));
+        }
+    }
+    setSha256Kernel(previous);
+}
+
+TEST_CASE("HmacDrbg generates the same bytes as the hacl HMAC_DRBG")
+{
+    // Arrange
+    auto alg = static_cast<Spec_Hash_Definitions_hash_alg>(Spec_Hash_Definitions_SHA2_256);
+    auto entropy = patternBytes(64, 1);
+    auto nonce = patternBytes(32, 2);
+    auto personalization = patternBytes(20, 3);
+    auto state = Hacl_HMAC_DRBG_create_in(alg);
+    Hacl_HMAC_DRBG_instantiate(alg, state, static_cast<uint32_t>(entropy.size()), entropy.data(),
+                               static_cast<uint32_t>(nonce.size()), nonce.data(),
+                               static_cast<uint32_t>(personalization.size()),
+                               personalization.data());
+    HmacDrbg drbg(entropy, nonce, personalization);
+
+    // consecutive requests of different sizes, with and without additional input
+    for (size_t size : {1UL, 32UL, 33UL, 100UL}) {
+        for (auto additionalInput : {vector<uint8_t>(), patternBytes(size, 4)}) {
+            vector<uint8_t> expected(size);
+            vector<uint8_t> actual(size);
+
+            // Act
+            auto expectedGenerated = Hacl_HMAC_DRBG_generate(
+              alg, expected.data(), state, static_cast<uint32_t>(size),
+              static_cast<uint32_t>(additionalInput.size()), additionalInput.data());
+            auto generated = drbg.generate(actual.data(), size, additionalInput);
+
+            // Assert
+            CHECK(expectedGenerated);
+            CHECK(generated);
+            CHECK(actual == expected);
+        }
+    }
+
+    free(state.k);
+    free(state.v);
+    free(state.reseed_counter);
+}
+
+#pragma endregion
+
 #pragma region Loads and Stores
 
 TEST_CASE("Hacl_Bignum4096_new_bn_from_bytes_be Test BigNum 4096 from and to bytes")
@@ -1,7 +1,10 @@
+#include "../../src/electionguard/hash_stream.hpp"
 #include "../../src/electionguard/log.hpp"
+#include "../../src/electionguard/sha256_lanes.hpp"
 
 #include <doctest/doctest.h>
 #include <electionguard/hash.hpp>
+#include <electionguard/manifest.hpp>
 #include <iomanip>
 #include <iostream>
 #include <sstream>
@@ -114,3 +117,137 @@ TEST_CASE("Same Hash Value from nested-list and result of hashed list by hashing
     // but different addresses
     CHECK(&nestedHash != &nonNestedHash2);
 }
+
+TEST_CASE("hash_elems produces the golden digests of every element type")
+{
+    // Arrange
+    auto &p = const_cast<ElementModP &>(P());
+    auto &q = const_cast<ElementModQ &>(Q());
+    auto &g = const_cast<ElementModP &>(G());
+    auto smallP = ElementModP::fromUint64(0xABCDEF);
+    auto smallQ = ElementModQ::fromUint64(0x12345);
+    auto zeroQ = ElementModQ::fromUint64(0);
+    SelectionDescription description("selection-1", "candidate-1", 1UL);
+    CryptoHashable &selection = description;
+
+    // Act & Assert
+    // the digests are part of published election records, so they must never change
+    CHECK(hash_elems(nullptr)->toHex() ==
+          "4B9729549DA6FBF91219C4D2D4878F0D9F443F92D013C6C768F96BA81C7CCAEE");
+    CHECK(hash_elems(vector<CryptoHashableType>{})->toHex() ==
+          "4B9729549DA6FBF91219C4D2D4878F0D9F443F92D013C6C768F96BA81C7CCAEE");
+    CHECK(hash_elems({0UL, 1UL, 0xFFFFFFFFFFFFFFFFUL})->toHex() ==
+          "2E08AC5B32DF9FF0F4D417E7E921694FBBD61A35B328FC3591FE630D82A6FC39");
+    CHECK(hash_elems({string(""), string("electionguard"), string("|")})->toHex() ==
+          "BB668D9D64200A6020E0DC519BE4B51F3562E0BE0EBDECFC36AE985A4C6DD8B3");
+    CHECK(hash_elems({&p, &q, &g})->toHex() ==
+          "5780E207B935277A680BE4E347C06D8FDB10A491BA2BA68E6031B38745EF33C2");
+    CHECK(hash_elems({smallP.get(), smallQ.get(), zeroQ.get()})->toHex() ==
+          "FBF62E429A23268A4CB94BEE383ABEBEC58A32FF379150D54454C3F12BEE8C4F");
+    CHECK(hash_elems({ref(g), ref(q), cref(*smallP), cref(*zeroQ)})->toHex() ==
+          "80F8361FB9ECFAFDB684B8EBA5994580115788C4D52B7BCF3C59117F388853EE");
+    CHECK(hash_elems({&selection, ref(selection), cref(selection)})->toHex() ==
+          "979D9CD1DCD2E7705B4F08ACFEAF89AF47760083D7AD2D4D2073E9A6C906326E");
+    CHECK(hash_elems({vector<uint64_t>{}, vector<uint64_t>{1UL, 2UL, 3UL}})->toHex() ==
+          "58F1A18D58686A05EF69A93991C940F312D7EE6CF4AC15970378553D60DD4BBC");
+    CHECK(hash_elems({vector<string>{"a", ""},
+                      vector<ElementModQ *>{smallQ.get(), zeroQ.get()}})
+            ->toHex() ==
+          "828DB118358211DAF3E32DAFE3CC613B73EAADC4A439874579E30B12F4B9DEBE");
+    CHECK(hash_elems(vector<reference_wrapper<const ElementModP>>{cref(g), cref(*smallP)})
+            ->toHex() ==
+          "E3CA01945029D744AEF70610A305859E80D7F254A1BC385683515A109E9316B8");
+    CHECK(hash_elems({vector<reference_wrapper<CryptoHashable>>{ref(selection)},
+                      vector<ElementModP *>{}})
+            ->toHex() ==
+          "36CFB4F6C9835045E7A8164DEC6F0E77E4A23B0D51504CB7C0FE3572DDB8E8A4");
+    CHECK(hash_elems({vector<uint8_t>{}, vector<uint8_t>{0x00, 0x0a, 0xff}})->toHex() ==
+          "014CB3BE9C36D948C6903FA72E258120AA2CB47A2E0D9C3CF43BD77EDD20D289");
+}
+
+TEST_CASE("Variadic hash_elems matches the hash of the same elements in a list")
+{
+    // Arrange
+    const auto &q = Q();
+    const auto &g = G();
+    auto smallP = ElementModP::fromUint64(0xABCDEF);
+    auto zeroQ = ElementModQ::fromUint64(0);
+    SelectionDescription description("selection-1", "candidate-1", 1UL);
+    const CryptoHashable &selection = description;
+    string objectId = "contest-1";
+    vector<uint64_t> numbers = {1UL, 2UL, 3UL};
+    vector<uint8_t> bytes = {0x00, 0x0a, 0xff};
+
+    // Act & Assert
+    CHECK(hash_elems()->toHex() == hash_elems(vector<CryptoHashableType>{})->toHex());
+    CHECK(hash_elems(q, g, *smallP, *zeroQ)->toHex() ==
+          hash_elems({cref(q), cref(g), smallP.get(), zeroQ.get()})->toHex());
+    CHECK(hash_elems(objectId, "", 0UL, 42UL, nullptr)->toHex() ==
+          hash_elems({objectId, string(""), 0UL, 42UL, nullptr})->toHex());
+    CHECK(hash_elems(selection, numbers, bytes, vector<string>{})->toHex() ==
+          hash_elems({cref(selection), numbers, bytes, vector<string>{}})->toHex());
+    CHECK(hash_elems(smallP.get(), vector<ElementModQ *>{zeroQ.get()})->toHex() ==
+          hash_elems({smallP.get(), vector<ElementModQ *>{zeroQ.get()}})->toHex());
+}
+
+TEST_CASE("HashPrefix continues the hash of its prefix")
+{
+    // Arrange
+    auto seed = ElementModQ::fromHex(
+      "3CB2A1AE2B7AE8B2E6AB5A4D0F0E8D5C31AE08BEDC3A7DB95FCEC6A5E3B1F9D1");
+    string header = "contest-1";
+    HashPrefix prefix({seed.get(), header});
+
+    // Act & Assert
+    for (uint64_t item = 0; item < 100; item++) {
+        CHECK(hash_elems(prefix, item)->toHex() == hash_elems(*seed, header, item)->toHex());
+        CHECK(prefix.hash({item})->toHex() == hash_elems(*seed, header, item)->toHex());
+    }
+    CHECK(hash_elems(prefix, 7UL, "selection-1")->toHex() ==
+          hash_elems({seed.get(), header, 7UL, string("selection-1")})->toHex());
+    CHECK(prefix.hash({7UL, string("selection-1")})->toHex() ==
+          hash_elems({seed.get(), header, 7UL, string("selection-1")})->toHex());
+
+    auto stream = prefix.begin();
+    stream.append(G());
+    CHECK(stream.finish()->toHex() == hash_elems(*seed, header, G())->toHex());
+}
+
+TEST_CASE("hash_elems_batch matches hash_elems with every lane kernel")
+{
+    // Arrange
+    // strings of every length around the block boundaries pad into one or two final blocks
+    vector<vector<CryptoHashableType>> inputs;
+    for (size_t length = 0; length < 140; length++) {
+        inputs.push_back({string(length, 'a'), length});
+    }
+    inputs.push_back({});
+    inputs.push_back({nullptr});
+    inputs.push_back({cref(G()), cref(TWO_MOD_Q())});
+    vector<string> expected;
+    for (const auto &input : inputs) {
+        expected.push_back(hash_elems(input)->toHex());
+    }
+
+    auto previous = getSha256LaneKernel();
+    for (auto kernel :
+         {Sha256LaneKernel::portable, Sha256LaneKernel::avx2, Sha256LaneKernel::avx512}) {
+        if (!isSha256LaneKernelSupported(kernel)) {
+            continue;
+        }
+        setSha256LaneKernel(kernel);
+
+        // Act
+        auto actual = hash_elems_batch(inputs);
+        auto single = hash_elems_batch({inputs[5]});
+
+        // Assert
+        REQUIRE(actual.size() == inputs.size());
+        for (size_t i = 0; i < inputs.size(); i++) {
+            CHECK(actual[i]->toHex() == expected[i]);
+        }
+        CHECK(single[0]->toHex() == expected[5]);
+        CHECK(hash_elems_batch({}).empty());
+    }
+    setSha256LaneKernel(previous);
+}
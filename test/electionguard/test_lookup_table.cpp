@@ -0,0 +1,455 @@
+#include "../../src/electionguard/facades/Hacl_Bignum4096.hpp"
+#include "../../src/electionguard/lookup_table.hpp"
+#include "../../src/electionguard/mapped_file.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <doctest/doctest.h>
+#include <electionguard/constants.h>
+#include <electionguard/group.hpp>
+#include <future>
+#include <thread>
+#include <vector>
+
+using namespace electionguard;
+using namespace hacl;
+using namespace std;
+
+TEST_CASE("A base is promoted to a lookup table after crossing the threshold")
+{
+    // Arrange
+    set_lookup_table_cache_policy(3, LUT_CACHE_BYTE_BUDGET);
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    auto first = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto second = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto promoted = get_lookup_table_cache_statistics();
+    auto third = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+
+    // the table is generated on the Scheduler
+    for (int i = 0; i < 10000 && get_lookup_table_cache_statistics().tables == before.tables;
+         i++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    auto fourth = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(promoted.promotions == before.promotions);
+    CHECK(after.promotions == before.promotions + 1);
+    CHECK(after.misses == before.misses + 3);
+    CHECK(after.hits == before.hits + 1);
+    CHECK(after.tables == before.tables + 1);
+    for (const auto &result : {first.get(), second.get(), third.get(), fourth.get()}) {
+        CHECK(equal(begin(expected), end(expected), result->get()));
+    }
+    CHECK(base->isFixedBase() == false);
+
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+}
+
+TEST_CASE("The least recently used lookup table is evicted beyond the byte budget")
+{
+    // Arrange
+    set_lookup_table_cache_policy(0, 2 * LookupTableType::sizeInBytes());
+    auto first = g_pow_p(*rand_q());
+    auto second = g_pow_p(*rand_q());
+    auto third = g_pow_p(*rand_q());
+    first->setIsFixedBase(true);
+    second->setIsFixedBase(true);
+    third->setIsFixedBase(true);
+    auto exponent = rand_q();
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    pow_mod_p(*first, *exponent, ExponentiationPolicy::variableTime);
+    pow_mod_p(*second, *exponent, ExponentiationPolicy::variableTime);
+    pow_mod_p(*first, *exponent, ExponentiationPolicy::variableTime);
+    pow_mod_p(*third, *exponent, ExponentiationPolicy::variableTime);
+    auto afterThird = get_lookup_table_cache_statistics();
+    auto result = pow_mod_p(*second, *exponent, ExponentiationPolicy::variableTime);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(afterThird.tables == 2);
+    CHECK(afterThird.bytes == 2 * LookupTableType::sizeInBytes());
+    CHECK(afterThird.evictions >= before.evictions + 1);
+    CHECK(afterThird.hits == before.hits + 1);
+
+    // the second base was the least recently used so it is rebuilt
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(second->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    CHECK(after.misses == afterThird.misses + 1);
+    CHECK(equal(begin(expected), end(expected), result->get()));
+
+    set_lookup_table_cache_policy(0, 0);
+    CHECK(get_lookup_table_cache_statistics().tables <= 1);
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+}
+
+TEST_CASE("Evicted lookup tables are released by the threads that used them")
+{
+    // Arrange
+    auto tableBytes = LookupTableType::sizeInBytes();
+    set_lookup_table_cache_policy(0, 0);
+    set_lookup_table_cache_policy(0, 3 * tableBytes);
+    vector<unique_ptr<ElementModP>> bases;
+    for (int i = 0; i < 3; i++) {
+        bases.push_back(g_pow_p(*rand_q()));
+        bases.back()->setIsFixedBase(true);
+    }
+    auto exponent = rand_q();
+    auto useAll = [&]() {
+        for (const auto &base : bases) {
+            pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+        }
+    };
+
+    // threads that used every table and then wait, and tasks of the Scheduler
+    const int threadCount = 3;
+    atomic<int> stage{0};
+    atomic<int> ready{0};
+    vector<thread> threads;
+    for (int i = 0; i < threadCount; i++) {
+        threads.emplace_back([&]() {
+            useAll();
+            ready++;
+            while (stage.load() < 1) {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+            pow_mod_p(*bases[0], *exponent, ExponentiationPolicy::variableTime);
+            ready++;
+            while (stage.load() < 2) {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        });
+    }
+    vector<future<void>> tasks;
+    for (int i = 0; i < threadCount; i++) {
+        tasks.push_back(Scheduler::submit(useAll));
+    }
+    for (auto &task : tasks) {
+        task.get();
+    }
+    while (ready.load() < threadCount) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    useAll();
+
+    // Act
+    set_lookup_table_cache_policy(0, tableBytes);
+    auto evicted = get_lookup_table_cache_statistics();
+    stage = 1;
+    while (ready.load() < 2 * threadCount) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    pow_mod_p(*bases[0], *exponent, ExponentiationPolicy::variableTime);
+
+    // the workers of the Scheduler release the tables once they are idle
+    for (int i = 0;
+         i < 10000 && get_lookup_table_cache_statistics().residentBytes > tableBytes; i++) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    auto after = get_lookup_table_cache_statistics();
+    stage = 2;
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    CHECK(evicted.bytes <= tableBytes);
+    CHECK(evicted.residentBytes >= 3 * tableBytes);
+    CHECK(after.bytes <= tableBytes);
+    CHECK(after.residentBytes <= tableBytes);
+
+    set_lookup_table_cache_policy(LUT_PROMOTION_THRESHOLD, LUT_CACHE_BYTE_BUDGET);
+}
+
+TEST_CASE("Concurrent first uses of a fixed base share a single table")
+{
+    // Arrange
+    const size_t threadCount = 4;
+    auto base = g_pow_p(*rand_q());
+    base->setIsFixedBase(true);
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    vector<unique_ptr<ElementModP>> results(threadCount);
+    vector<thread> threads;
+    for (size_t i = 0; i < threadCount; i++) {
+        threads.emplace_back([&, i]() {
+            results[i] = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(after.tables == before.tables + 1);
+    CHECK(after.hits + after.misses == before.hits + before.misses + threadCount);
+    for (const auto &result : results) {
+        CHECK(equal(begin(expected), end(expected), result->get()));
+    }
+}
+
+TEST_CASE("A table published by another thread is found by a thread that used other tables")
+{
+    // Arrange
+    auto first = g_pow_p(*rand_q());
+    auto second = g_pow_p(*rand_q());
+    first->setIsFixedBase(true);
+    second->setIsFixedBase(true);
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(second->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    pow_mod_p(*first, *exponent, ExponentiationPolicy::variableTime);
+
+    // Act
+    thread([&]() { pow_mod_p(*second, *exponent, ExponentiationPolicy::variableTime); }).join();
+    auto before = get_lookup_table_cache_statistics();
+    auto result = pow_mod_p(*second, *exponent, ExponentiationPolicy::variableTime);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(after.hits == before.hits + 1);
+    CHECK(after.misses == before.misses);
+    CHECK(equal(begin(expected), end(expected), result->get()));
+}
+
+TEST_CASE("A lookup table generated in parallel matches the serial table")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    LookupTableType serial(base->get());
+    LookupTableType parallel(base->get(), true);
+
+    vector<unique_ptr<ElementModQ>> exponents;
+    exponents.push_back(rand_q());
+    exponents.push_back(rand_q());
+    exponents.push_back(sub_from_q(ONE_MOD_Q()));
+
+    for (const auto &exponent : exponents) {
+        uint64_t expected[MAX_P_LEN] = {};
+        CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+
+        // Act
+        auto fromSerial = serial.pow_mod_p(exponent->ref());
+        auto fromParallel = parallel.pow_mod_p(exponent->ref());
+
+        // Assert
+        CHECK(equal(begin(expected), end(expected), fromSerial.begin()));
+        CHECK(fromParallel == fromSerial);
+    }
+}
+
+TEST_CASE("A prepared lookup table is available before the first exponentiation")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    auto prepared = prepare_lookup_table(*base);
+    prepared.get();
+    auto afterPrepare = get_lookup_table_cache_statistics();
+    auto result = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(base->isFixedBase() == true);
+    CHECK(afterPrepare.tables == before.tables + 1);
+    CHECK(after.hits == afterPrepare.hits + 1);
+    CHECK(after.misses == afterPrepare.misses);
+    CHECK(equal(begin(expected), end(expected), result->get()));
+}
+
+TEST_CASE("Lookup tables of every window size match modular exponentiation")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    vector<unique_ptr<ElementModQ>> exponents;
+    exponents.push_back(rand_q());
+    exponents.push_back(sub_from_q(ONE_MOD_Q()));
+    exponents.push_back(ZERO_MOD_Q().clone());
+
+    for (uint64_t windowSize : {4, 6, 8, 10, 12}) {
+        // Act
+        auto table = makeLookupTable(windowSize, base->get());
+
+        // Assert
+        CHECK(table->windowSize() == windowSize);
+        for (const auto &exponent : exponents) {
+            uint64_t expected[MAX_P_LEN] = {};
+            CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+            auto result = table->pow_mod_p(exponent->ref());
+            CHECK(equal(begin(expected), end(expected), result.begin()));
+        }
+    }
+    CHECK_THROWS(makeLookupTable(7, base->get()));
+}
+
+TEST_CASE("Selecting a window size replaces the lookup table of a base")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    base->setIsFixedBase(true);
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto withDefault = get_lookup_table_cache_statistics();
+    set_lookup_table_window_size(*base, 4);
+    auto afterSelect = get_lookup_table_cache_statistics();
+    auto result = pow_mod_p(*base, *exponent, ExponentiationPolicy::variableTime);
+    auto after = get_lookup_table_cache_statistics();
+
+    // Assert
+    CHECK(withDefault.bytes == before.bytes + LookupTableType::sizeInBytes());
+    CHECK(afterSelect.tables == before.tables);
+    CHECK(after.tables == before.tables + 1);
+    CHECK(after.bytes == before.bytes + LookupTable4::sizeInBytes());
+    CHECK(equal(begin(expected), end(expected), result->get()));
+    CHECK_THROWS(set_lookup_table_window_size(*base, 7));
+}
+
+TEST_CASE("Lookup table memory is zero filled and aligned to huge pages")
+{
+    for (auto hugePages : {LookupTableHugePages::none, LookupTableHugePages::transparent,
+                           LookupTableHugePages::reserved}) {
+        // Act
+        MappedMemory memory(LookupTableType::sizeInBytes() + 1, hugePages);
+
+        // Assert
+        CHECK(memory.size() >= LookupTableType::sizeInBytes() + 1);
+        CHECK(memory.data()[0] == 0);
+        CHECK(memory.data()[memory.size() - 1] == 0);
+        if (hugePages != LookupTableHugePages::none) {
+            CHECK(reinterpret_cast<uintptr_t>(memory.data()) % HUGE_PAGE_SIZE == 0);
+        }
+    }
+}
+
+TEST_CASE("Interleaved lookup tables share an exponent across bases")
+{
+    // Arrange
+    auto first = g_pow_p(*rand_q());
+    auto second = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    uint64_t expectedFirst[MAX_P_LEN] = {};
+    uint64_t expectedSecond[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(first->get(), exponent->get(), static_cast<uint64_t *>(expectedFirst));
+    CONTEXT_P().modExpQ(second->get(), exponent->get(), static_cast<uint64_t *>(expectedSecond));
+    auto before = get_lookup_table_cache_statistics();
+
+    // Act
+    interleave_lookup_tables({*first, *second});
+    auto afterInterleave = get_lookup_table_cache_statistics();
+    set_constant_time_implementation(ConstantTimeImplementation::maskedWindow);
+    auto shared = pow_mod_p_shared_exponent({*first, *second}, *exponent);
+    auto single = pow_mod_p(*second, *exponent);
+    set_constant_time_implementation(ConstantTimeImplementation::verified);
+    auto after = get_lookup_table_cache_statistics();
+    auto sharedPublic = pow_mod_p_shared_exponent({*first, *second}, *exponent,
+                                                  ExponentiationPolicy::variableTime);
+
+    // Assert
+    CHECK(first->isFixedBase() == true);
+    CHECK(second->isFixedBase() == true);
+    CHECK(afterInterleave.tables == before.tables + 2);
+    CHECK(after.misses == afterInterleave.misses);
+    CHECK(equal(begin(expectedFirst), end(expectedFirst), shared[0]->get()));
+    CHECK(equal(begin(expectedSecond), end(expectedSecond), shared[1]->get()));
+    CHECK(equal(begin(expectedSecond), end(expectedSecond), single->get()));
+    CHECK(equal(begin(expectedFirst), end(expectedFirst), sharedPublic[0]->get()));
+    CHECK(equal(begin(expectedSecond), end(expectedSecond), sharedPublic[1]->get()));
+}
+
+TEST_CASE("A lookup table read under masks matches the direct reads for every window size")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    // zero slices select one instead of being skipped
+    exponent->get()[1] = 0;
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+
+    for (uint64_t windowSize : {4, 6, 8}) {
+        // Act
+        auto table = makeLookupTable(windowSize, base->get(), true);
+        uint64_t masked[MAX_P_LEN] = {};
+        uint64_t direct[MAX_P_LEN] = {};
+        table->constant_time_pow_mod_p(exponent->ref(), masked);
+        table->pow_mod_p(exponent->ref(), direct, ExponentiationPolicy::variableTime);
+
+        // Assert
+        CHECK(equal(begin(expected), end(expected), begin(masked)));
+        CHECK(equal(begin(expected), end(expected), begin(direct)));
+    }
+}
+
+TEST_CASE("Bases without lookup tables share an exponent by separate exponentiations")
+{
+    // Arrange
+    auto base = g_pow_p(*rand_q());
+    auto exponent = rand_q();
+    uint64_t expected[MAX_P_LEN] = {};
+    CONTEXT_P().modExpQ(base->get(), exponent->get(), static_cast<uint64_t *>(expected));
+
+    // Act
+    auto results = pow_mod_p_shared_exponent({G(), *base}, *exponent);
+
+    // Assert
+    CHECK(results.size() == 2);
+    CHECK(*results[0] == *g_pow_p(*exponent));
+    CHECK(equal(begin(expected), end(expected), results[1]->get()));
+    CHECK(base->isFixedBase() == false);
+}
+
+TEST_CASE("The embedded lookup table of G matches the generated table")
+{
+    const auto *embedded = embedded_g_table();
+    if (embedded == nullptr) {
+        MESSAGE("the library is built without the embedded lookup table");
+        return;
+    }
+
+    // Arrange
+    uint64_t base[MAX_P_LEN] = {};
+    copy(begin(G_ARRAY_REVERSE), end(G_ARRAY_REVERSE), base);
+    LookupTableType generated(static_cast<uint64_t *>(base), true);
+
+    // Act
+    auto linked = LookupTableType::view(embedded, base);
+
+    // Assert
+    bool matches = true;
+    for (uint64_t row = 0; row < linked->rowCount() && matches; row++) {
+        for (uint64_t slice = 1; slice < LUT_ORDER_BITS && matches; slice++) {
+            uint64_t exponent[MAX_Q_LEN] = {};
+            auto bit = row * LUT_WINDOW_SIZE;
+            exponent[bit / 64] = slice << (bit % 64);
+            matches = equal(linked->sliceEntry(exponent, row),
+                            linked->sliceEntry(exponent, row) + MAX_P_LEN,
+                            generated.sliceEntry(exponent, row));
+        }
+    }
+    CHECK(matches);
+    CHECK_THROWS(LookupTableType::view(embedded, ONE_MOD_P().ref()));
+}